@@ -7,69 +7,45 @@
 
    Efraim Manurung, 26th January 2024
    Version 1.1 : Added different task for turning ON and OFF LED
+
+   Efraim Manurung, 17th October 2026
+   Version 1.2 : Task stacks and control blocks are declared at compile time when
+                 built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.3 : Both blink rates are software-timer patterns (lib/LedPattern) instead of
+                 two tasks with 1024 byte stacks each. Like before, both drive the same LED.
 */
 
 
 #include <Arduino.h>
 // #include <FreeRTOSConfig.h>
 
-// Use only core 1 for demo purposes
-#if CONFIG_FREERTOS_UNICORE
-static const BaseType_t app_cpu = 0;
-#else
-static const BaseType_t app_cpu = 1;
-#endif
+// Blink patterns run by FreeRTOS software timers, no task (and stack) per LED
+#include <LedPattern.h>
 
 // Pins
 static const int led_pin = LED_BUILTIN;
 
-// Our task: blink an LED
-void toggleLED(void *parameter) {
-  while(1) {
-    digitalWrite(led_pin, HIGH);
-    vTaskDelay(500 / portTICK_PERIOD_MS);
-    digitalWrite(led_pin, LOW);
-    vTaskDelay(500 / portTICK_PERIOD_MS);
-  }
-}
-
-// Second task: also blink an LED but with different delay
-void toggleLED1(void *parameter) {
-  while(1) {
-    digitalWrite(led_pin, HIGH);
-    vTaskDelay(350 / portTICK_PERIOD_MS);
-    digitalWrite(led_pin, LOW);
-    vTaskDelay(350 / portTICK_PERIOD_MS);
-  }
-}
+// Blink patterns (a software timer each, static in USE_STATIC_ALLOCATION builds)
+static LedPattern toggle_led;
+static LedPattern toggle_led1;
 
 void setup() {
 
   // Configure pin
   pinMode(led_pin, OUTPUT);
 
-  // Task to run forever
-  xTaskCreatePinnedToCore( // Use xTaskCreate() in vanilla FreeRTOS
-      toggleLED,           // Function to be called
-      "Toggle LED",        // Name of task
-      1024,                // Stack size (bytes in ESP32, words in FreeRTOS)
-      NULL,                // Parameter to pass to function
-      1,                   // Task priority (0 to configMAX_PRIORITIES - 1)
-      NULL,                // Task handle
-      app_cpu);            // Run on one core for demo purposes (ESP32 only)
-  
+  // Blink an LED: 500 ms on, 500 ms off, forever
+  toggle_led.begin(led_pin,  // Pin to drive
+                   500,      // On time (ms)
+                   500);     // Off time (ms)
+
   // If this was vanilla FreeRTOS, you'd want to call vTaskStartScheduler() in
-  // main after setting up your tasks.
+  // main after setting up your timers. The callbacks run in the timer service task.
 
-  // For the second task
-  xTaskCreatePinnedToCore(
-      toggleLED1,
-      "Toggle LED1",
-      1024,
-      NULL,
-      1,
-      NULL,
-      app_cpu);
+  // Also blink the LED but with different delay
+  toggle_led1.begin(led_pin, 350, 350);
 }
 
 void loop() {
@@ -0,0 +1,164 @@
+/*
+    Introduction to RTOS Part 10 - Deadlock and Starvation by Shawn Hymel
+    URL: https://www.youtube.com/watch?v=hRsWi4HIENc&list=PLEBQazB0HUyQ4hAPU1cJED6t3DU0h34bz&index=10
+
+    Efraim Manurung, 17th October 2026
+    Version 1.0
+
+    Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-10-deadlock-and-starvation/872c6a057901432e84594d79fcb2cc5d
+
+    The deadlock demo with priority-ceiling mutexes (lib/CeilingMutex). The tasks still
+    take the mutexes in opposite order, but both mutexes have ceiling 2 (Task A's
+    priority). Once Task B holds mutex 2, Task A may not take mutex 1 until Task B has
+    given mutex 2 back, so they never each hold the one the other needs. Every 10 rounds
+    the longest wait of each mutex is printed.
+
+    host-tools/tasksets/10-deadlock-locks.csv is the same pair of tasks for the host-side
+    simulator (host-tools/src/lock-sim.cpp).
+*/
+
+#include<Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <CeilingMutex.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+    static const BaseType_t app_cpu = 0;
+#else
+    static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const UBaseType_t task_a_priority = 2;
+static const UBaseType_t task_b_priority = 1;
+static const int report_rounds = 10;       // Task B rounds between statistics
+
+// Globals (ceiling: the highest priority of the tasks that take them)
+static CeilingMutex mutex_1;
+static CeilingMutex mutex_2;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> task_a;
+static TaskStorage<1024> task_b;
+
+//*****************************************************************************
+// Tasks
+
+// Task A (high priority)
+void doTaskA(void *parameters) {
+
+    // Loop forever
+    while(1) {
+
+        // Take mutex 1 (introduce wait to force deadlock)
+        mutex_1.take(portMAX_DELAY);
+        Serial.println("Task A took mutex 1");
+        vTaskDelay(msToTicksCeil(1));
+
+        // Take mutex 2
+        mutex_2.take(portMAX_DELAY);
+        Serial.println("Task A took mutex 2");
+
+        // Critical section protected by 2 mutexes
+        Serial.println("Task A doing some work");
+        vTaskDelay(msToTicksCeil(500));
+
+        // Give back mutexes
+        mutex_2.give();
+        mutex_1.give();
+
+        // Wait to let the other task execute
+        Serial.println("Task A going to sleep");
+        vTaskDelay(msToTicksCeil(50));
+    }
+}
+
+// Longest wait and number of waits of a mutex
+static void printStats(const char *name, CeilingMutex &mutex) {
+    CeilingMutexStats stats;
+
+    mutex.getStats(&stats);
+    Serial.print(name);
+    Serial.print(": ceiling ");
+    Serial.print(stats.ceiling);
+    Serial.print(" | takes ");
+    Serial.print(stats.takes);
+    Serial.print(" | waits ");
+    Serial.print(stats.ceiling_waits);
+    Serial.print(" | max wait (us) ");
+    Serial.println(stats.max_wait_us);
+}
+
+// Task B (low priority)
+void doTaskB(void *parameters) {
+    int rounds = 0;
+
+    // Loop forever
+    while(1) {
+
+        // Take mutex 2 (introduce wait to force deadlock)
+        mutex_2.take(portMAX_DELAY);
+        Serial.println("Task B took mutex 2");
+        vTaskDelay(msToTicksCeil(1));
+
+        // Take mutex 1
+        mutex_1.take(portMAX_DELAY);
+        Serial.println("Task B took mutex 1");
+
+        // Critical section protected by 2 mutexes
+        Serial.println("Task B doing some work");
+        vTaskDelay(msToTicksCeil(500));
+
+        // Give back mutexes
+        mutex_1.give();
+        mutex_2.give();
+
+        // Wait to let the other task execute
+        Serial.println("Task B going to sleep");
+        vTaskDelay(msToTicksCeil(50));
+
+        // Both tasks keep going, show how long they waited for each other
+        rounds++;
+        if (rounds % report_rounds == 0) {
+            printStats("Mutex 1", mutex_1);
+            printStats("Mutex 2", mutex_2);
+        }
+    }
+}
+
+void setup() {
+
+    // Configure Serial
+    Serial.begin(115200);
+
+    // Wait a moment to start (so we don't miss Serial output)
+    vTaskDelay(msToTicksCeil(1000));
+    Serial.println();
+    Serial.println("---FreeRTOS Priority Ceiling Demo---");
+
+    // Create mutexes before starting tasks
+    mutex_1.begin(task_a_priority);
+    mutex_2.begin(task_a_priority);
+
+    // Start task A (high priority)
+    task_a.createPinnedToCore(doTaskA,
+                              "Task A",
+                              NULL,
+                              task_a_priority,
+                              app_cpu);
+    
+    // Start Task B (low priority)
+    task_b.createPinnedToCore(doTaskB,
+                              "Task B",
+                              NULL,
+                              task_b_priority,
+                              app_cpu);
+
+    // Delete "setup and loop" task
+    vTaskDelete(NULL);
+}
+
+void loop() {
+    // Execution should never get here
+}
\ No newline at end of file
@@ -4,6 +4,25 @@
 
     Efraim Manurung, 12th August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : Delays are converted to ticks rounding up (lib/PreciseDelay), so the
+                  1 ms wait that makes the deadlock likely is never truncated to 0 ticks
+
+    Efraim Manurung, 17th October 2026
+    Version 1.3 : Mutexes are taken through lib/DeadlockDetector. Built with LOCKDEP=1
+                  (the -lockdep env) lib/Lockdep learns that mutex 1 comes before mutex 2
+                  and reports the first take in the opposite order, so breaking the
+                  hierarchy shows up right away instead of as a rare hang.
+
+    Efraim Manurung, 17th October 2026
+    Version 1.4 : The hierarchy is in the types (lib/RankedMutex): mutex 1 has rank 1,
+                  mutex 2 rank 2, and taking them in the other order is a build error.
+                  They are held by scoped guards and given back in reverse order.
     
     Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-10-deadlock-and-starvation/872c6a057901432e84594d79fcb2cc5d
 
@@ -13,6 +32,9 @@
 */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <RankedMutex.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -21,9 +43,13 @@
     static const BaseType_t app_cpu = 1;
 #endif
 
-// Globals
-static SemaphoreHandle_t mutex_1;
-static SemaphoreHandle_t mutex_2;
+// Globals (rank = place in the hierarchy, static in USE_STATIC_ALLOCATION builds)
+static RankedMutex<1> mutex_1;
+static RankedMutex<2> mutex_2;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> task_a;
+static TaskStorage<1024> task_b;
 
 //*****************************************************************************
 // Tasks
@@ -33,27 +59,26 @@ void doTaskA(void *parameters) {
 
     // Loop forever
     while(1) {
+        {
+            // Take mutex 1 (introduce wait to force deadlock)
+            LockGuard<1> guard_1(NO_LOCKS, mutex_1);
+            Serial.println("Task A took mutex 1");
+            vTaskDelay(msToTicksCeil(1));
 
-        // Take mutex 1 (introduce wait to force deadlock)
-        xSemaphoreTake(mutex_1, portMAX_DELAY);
-        Serial.println("Task A took mutex 1");
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-
-        // Take mutex 2
-        xSemaphoreTake(mutex_2, portMAX_DELAY);
-        Serial.println("Task A took mutex 2");
+            // Take mutex 2, only possible after mutex 1
+            LockGuard<2> guard_2(guard_1, mutex_2);
+            Serial.println("Task A took mutex 2");
 
-        // Critical section protected by 2 mutexes
-        Serial.println("Task A doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
+            // Critical section protected by 2 mutexes
+            Serial.println("Task A doing some work");
+            vTaskDelay(msToTicksCeil(500));
 
-        // Give back mutexes
-        xSemaphoreGive(mutex_2);
-        xSemaphoreGive(mutex_1);
+            // Give back mutexes (mutex 2, then mutex 1) at the end of the scope
+        }
 
         // Wait to let the other task execute
         Serial.println("Task A going to sleep");
-        vTaskDelay(50 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(50));
     }
 }
 
@@ -62,27 +87,26 @@ void doTaskB(void *parameters) {
 
     // Loop forever
     while(1) {
+        {
+            // Take mutex 1 (introduce wait to force deadlock)
+            LockGuard<1> guard_1(NO_LOCKS, mutex_1);
+            Serial.println("Task B took mutex 1");
+            vTaskDelay(msToTicksCeil(1));
 
-        // Take mutex 2 (introduce wait to force deadlock)
-        xSemaphoreTake(mutex_1, portMAX_DELAY);
-        Serial.println("Task B took mutex 1");
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-
-        // Take mutex 1
-        xSemaphoreTake(mutex_2, portMAX_DELAY);
-        Serial.println("Task B took mutex 2");
+            // Take mutex 2, only possible after mutex 1
+            LockGuard<2> guard_2(guard_1, mutex_2);
+            Serial.println("Task B took mutex 2");
 
-        // Critical section protected by 2 mutexes
-        Serial.println("Task B doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
+            // Critical section protected by 2 mutexes
+            Serial.println("Task B doing some work");
+            vTaskDelay(msToTicksCeil(500));
 
-        // Give back mutexes
-        xSemaphoreGive(mutex_2);
-        xSemaphoreGive(mutex_1);
+            // Give back mutexes (mutex 2, then mutex 1) at the end of the scope
+        }
 
         // Wait to let the other task execute
         Serial.println("Task B going to sleep");
-        vTaskDelay(50 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(50));
     }
 }
 
@@ -92,31 +116,27 @@ void setup() {
     Serial.begin(115200);
 
     // Wait a moment to start (so we don't miss Serial output)
-    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    vTaskDelay(msToTicksCeil(1000));
     Serial.println();
     Serial.println("---FreeRTOS Deadlock Demo Hierarchy---");
 
     // Create mutexes before starting tasks
-    mutex_1 = xSemaphoreCreateMutex();
-    mutex_2 = xSemaphoreCreateMutex();
+    mutex_1.begin("mutex 1");
+    mutex_2.begin("mutex 2");
 
     // Start task A (high priority)
-    xTaskCreatePinnedToCore(doTaskA,
-                            "Task A",
-                            1024,
-                            NULL,
-                            2,
-                            NULL,
-                            app_cpu);
+    task_a.createPinnedToCore(doTaskA,
+                              "Task A",
+                              NULL,
+                              2,
+                              app_cpu);
     
     // Start Task B (low priority)
-    xTaskCreatePinnedToCore(doTaskB,
-                            "Task B",
-                            1024,
-                            NULL,
-                            1,
-                            NULL,
-                            app_cpu);
+    task_b.createPinnedToCore(doTaskB,
+                              "Task B",
+                              NULL,
+                              1,
+                              app_cpu);
 
     // Delete "setup and loop" task
     vTaskDelete(NULL);
@@ -4,14 +4,36 @@
 
     Efraim Manurung, 12th August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : Delays are converted to ticks rounding up (lib/PreciseDelay), so the
+                  1 ms wait that makes the deadlock likely is never truncated to 0 ticks
+
+    Efraim Manurung, 17th October 2026
+    Version 1.3 : Both mutexes are taken with takeAll() (lib/MultiLock), all or nothing
+                  with a random back-off. A task that times out no longer gives back
+                  mutexes it never took, no task waits while holding a mutex, and the two
+                  tasks can't keep retrying in lockstep. Every 10 rounds a task prints
+                  how contended its takes were.
+
+    Efraim Manurung, 17th October 2026
+    Version 1.4 : Task stacks raised to 3 KB for the printf() in takeAllPrintStats()
     
     Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-10-deadlock-and-starvation/872c6a057901432e84594d79fcb2cc5d
 
     Demonstrate why kernel object timeouts are important to alleviate
-    deadlock. Note that this still can cause "livelock".
+    deadlock. Timeouts alone can still cause "livelock", the random back-off of
+    takeAll() is what keeps the tasks from retrying in lockstep.
 */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <MultiLock.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -21,12 +43,26 @@
 #endif
 
 // Settings
-TickType_t mutex_timeout = 1000 / portTICK_PERIOD_MS;
+TickType_t mutex_timeout = msToTicksCeil(1000);
+static const uint32_t stats_rounds = 10;        // Print the contention stats this often
 
 // Globals
 static SemaphoreHandle_t mutex_1;
 static SemaphoreHandle_t mutex_2;
 
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds), room for
+// the printf() in takeAllPrintStats()
+static TaskStorage<3072> task_a;
+static TaskStorage<3072> task_b;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static MutexStorage mutex_1_storage;
+static MutexStorage mutex_2_storage;
+
+// Contention of each task's takes
+static TakeAllStats stats_a;
+static TakeAllStats stats_b;
+
 //*****************************************************************************
 // Tasks
 
@@ -36,36 +72,30 @@ void doTaskA(void *parameters) {
   // Loop forever
   while (1) {
 
-    // Take mutex 1
-    if (xSemaphoreTake(mutex_1, mutex_timeout) == pdTRUE) {
+    // Take both mutexes or neither (the order they are listed in doesn't matter)
+    if (takeAll({mutex_1, mutex_2}, mutex_timeout, &stats_a)) {
 
-      // Say we took mutex 1 and wait (to force deadlock)
-      Serial.println("Task A took mutex 1");
-      vTaskDelay(1 / portTICK_PERIOD_MS);
-  
-      // Take mutex 2
-      if (xSemaphoreTake(mutex_2, mutex_timeout) == pdTRUE) {
+      // Say we took both
+      Serial.println("Task A took mutex 1 and 2");
 
-        // Say we took mutex 2
-        Serial.println("Task A took mutex 2");
-  
-        // Critical section protected by 2 mutexes
-        Serial.println("Task A doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
-      } else {
-        Serial.println("Task A timed out waiting for mutex 2");
-      }
+      // Critical section protected by 2 mutexes
+      Serial.println("Task A doing some work");
+      vTaskDelay(msToTicksCeil(500));
+
+      // Give back mutexes
+      giveAll({mutex_1, mutex_2});
     } else {
-      Serial.println("Task A timed out waiting for mutex 1");
+      Serial.println("Task A timed out waiting for mutex 1 and 2");
     }
 
-    // Give back mutexes
-    xSemaphoreGive(mutex_2);
-    xSemaphoreGive(mutex_1);
+    if (stats_a.calls % stats_rounds == 0) {
+      Serial.print("Task A takes: ");
+      takeAllPrintStats(Serial, stats_a);
+    }
 
     // Wait to let the other task execute
     Serial.println("Task A going to sleep");
-    vTaskDelay(500 / portTICK_PERIOD_MS);
+    vTaskDelay(msToTicksCeil(500));
   }
 }
 
@@ -75,36 +105,30 @@ void doTaskB(void *parameters) {
   // Loop forever
   while (1) {
 
-    // Take mutex 2
-    if (xSemaphoreTake(mutex_2, mutex_timeout) == pdTRUE) {
+    // Take both mutexes or neither (the order they are listed in doesn't matter)
+    if (takeAll({mutex_2, mutex_1}, mutex_timeout, &stats_b)) {
 
-      // Say we took mutex 2 and wait (to force deadlock)
-      Serial.println("Task B took mutex 2");
-      vTaskDelay(1 / portTICK_PERIOD_MS);
-  
-      // Take mutex 1
-      if (xSemaphoreTake(mutex_1, mutex_timeout) == pdTRUE) {
+      // Say we took both
+      Serial.println("Task B took mutex 1 and 2");
 
-        // Say we took mutex 1
-        Serial.println("Task B took mutex 1");
-  
-        // Critical section protected by 2 mutexes
-        Serial.println("Task B doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
-      } else {
-        Serial.println("Task B timed out waiting for mutex 1");
-      }
+      // Critical section protected by 2 mutexes
+      Serial.println("Task B doing some work");
+      vTaskDelay(msToTicksCeil(500));
+
+      // Give back mutexes
+      giveAll({mutex_2, mutex_1});
     } else {
-      Serial.println("Task B timed out waiting for mutex 2");
+      Serial.println("Task B timed out waiting for mutex 1 and 2");
     }
 
-    // Give back mutexes
-    xSemaphoreGive(mutex_1);
-    xSemaphoreGive(mutex_2);
+    if (stats_b.calls % stats_rounds == 0) {
+      Serial.print("Task B takes: ");
+      takeAllPrintStats(Serial, stats_b);
+    }
 
     // Wait to let the other task execute
     Serial.println("Task B going to sleep");
-    vTaskDelay(500 / portTICK_PERIOD_MS);
+    vTaskDelay(msToTicksCeil(500));
   }
 }
 
@@ -117,31 +141,27 @@ void setup() {
   Serial.begin(115200);
 
   // Wait a moment to start (so we don't miss Serial output)
-  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  vTaskDelay(msToTicksCeil(1000));
   Serial.println();
   Serial.println("---FreeRTOS Deadlock Demo Timeout---");
 
   // Create mutexes before starting tasks
-  mutex_1 = xSemaphoreCreateMutex();
-  mutex_2 = xSemaphoreCreateMutex();
+  mutex_1 = mutex_1_storage.create();
+  mutex_2 = mutex_2_storage.create();
 
   // Start Task A (high priority)
-  xTaskCreatePinnedToCore(doTaskA,
-                          "Task A",
-                          1024,
-                          NULL,
-                          2,
-                          NULL,
-                          app_cpu);
+  task_a.createPinnedToCore(doTaskA,
+                            "Task A",
+                            NULL,
+                            2,
+                            app_cpu);
 
   // Start Task B (low priority)
-  xTaskCreatePinnedToCore(doTaskB,
-                          "Task B",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  task_b.createPinnedToCore(doTaskB,
+                            "Task B",
+                            NULL,
+                            1,
+                            app_cpu);
 
   // Delete "setup and loop" task
   vTaskDelete(NULL);
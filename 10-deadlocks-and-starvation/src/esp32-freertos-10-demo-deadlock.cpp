@@ -4,6 +4,24 @@
 
     Efraim Manurung, 12th August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : Delays are converted to ticks rounding up (lib/PreciseDelay), so the
+                  1 ms wait that makes the deadlock likely is never truncated to 0 ticks
+
+    Efraim Manurung, 17th October 2026
+    Version 1.3 : Mutexes are taken through lib/DeadlockDetector. Built with
+                  DEADLOCK_DETECTOR=1 (the -deadlock-detector env) the take that would
+                  close the cycle is reported with its call sites and refused, that task
+                  gives back its mutex and tries again later. Otherwise nothing changes.
+
+    Efraim Manurung, 17th October 2026
+    Version 1.4 : Task stacks raised to 3 KB, the detector reports the cycle with
+                  printf() from the task that would close it
     
     Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-10-deadlock-and-starvation/872c6a057901432e84594d79fcb2cc5d
 
@@ -11,6 +29,9 @@
 */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <DeadlockDetector.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -23,6 +44,15 @@
 static SemaphoreHandle_t mutex_1;
 static SemaphoreHandle_t mutex_2;
 
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds), room for
+// the DeadlockReport and the printf() calls that print it
+static TaskStorage<3072> task_a;
+static TaskStorage<3072> task_b;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static MutexStorage mutex_1_storage;
+static MutexStorage mutex_2_storage;
+
 //*****************************************************************************
 // Tasks
 
@@ -33,25 +63,30 @@ void doTaskA(void *parameters) {
     while(1) {
 
         // Take mutex 1 (introduce wait to force deadlock)
-        xSemaphoreTake(mutex_1, portMAX_DELAY);
+        TRACKED_TAKE(mutex_1, portMAX_DELAY);
         Serial.println("Task A took mutex 1");
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-
-        // Take mutex 2
-        xSemaphoreTake(mutex_2, portMAX_DELAY);
+        vTaskDelay(msToTicksCeil(1));
+
+        // Take mutex 2, only refused if the detector breaks a deadlock
+        if (!TRACKED_TAKE(mutex_2, portMAX_DELAY)) {
+            Serial.println("Task A backs off");
+            TRACKED_GIVE(mutex_1);
+            vTaskDelay(msToTicksCeil(50));
+            continue;
+        }
         Serial.println("Task A took mutex 2");
 
         // Critical section protected by 2 mutexes
         Serial.println("Task A doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(500));
 
         // Give back mutexes
-        xSemaphoreGive(mutex_2);
-        xSemaphoreGive(mutex_1);
+        TRACKED_GIVE(mutex_2);
+        TRACKED_GIVE(mutex_1);
 
         // Wait to let the other task execute
         Serial.println("Task A going to sleep");
-        vTaskDelay(50 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(50));
     }
 }
 
@@ -62,25 +97,30 @@ void doTaskB(void *parameters) {
     while(1) {
 
         // Take mutex 2 (introduce wait to force deadlock)
-        xSemaphoreTake(mutex_2, portMAX_DELAY);
+        TRACKED_TAKE(mutex_2, portMAX_DELAY);
         Serial.println("Task B took mutex 2");
-        vTaskDelay(1 / portTICK_PERIOD_MS);
-
-        // Take mutex 1
-        xSemaphoreTake(mutex_1, portMAX_DELAY);
+        vTaskDelay(msToTicksCeil(1));
+
+        // Take mutex 1, only refused if the detector breaks a deadlock
+        if (!TRACKED_TAKE(mutex_1, portMAX_DELAY)) {
+            Serial.println("Task B backs off");
+            TRACKED_GIVE(mutex_2);
+            vTaskDelay(msToTicksCeil(50));
+            continue;
+        }
         Serial.println("Task B took mutex 1");
 
         // Critical section protected by 2 mutexes
         Serial.println("Task B doing some work");
-        vTaskDelay(500 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(500));
 
         // Give back mutexes
-        xSemaphoreGive(mutex_1);
-        xSemaphoreGive(mutex_2);
+        TRACKED_GIVE(mutex_1);
+        TRACKED_GIVE(mutex_2);
 
         // Wait to let the other task execute
         Serial.println("Task B going to sleep");
-        vTaskDelay(50 / portTICK_PERIOD_MS);
+        vTaskDelay(msToTicksCeil(50));
     }
 }
 
@@ -90,31 +130,34 @@ void setup() {
     Serial.begin(115200);
 
     // Wait a moment to start (so we don't miss Serial output)
-    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    vTaskDelay(msToTicksCeil(1000));
     Serial.println();
     Serial.println("---FreeRTOS Deadlock Demo---");
 
     // Create mutexes before starting tasks
-    mutex_1 = xSemaphoreCreateMutex();
-    mutex_2 = xSemaphoreCreateMutex();
+    mutex_1 = mutex_1_storage.create();
+    mutex_2 = mutex_2_storage.create();
+    TRACKED_NAME(mutex_1, "mutex 1");
+    TRACKED_NAME(mutex_2, "mutex 2");
+
+#if DEADLOCK_DETECTOR
+    // Report the cycle and let the task that would close it back off
+    deadlockDetectorSetPolicy(DEADLOCK_BREAK);
+#endif
 
     // Start task A (high priority)
-    xTaskCreatePinnedToCore(doTaskA,
-                            "Task A",
-                            1024,
-                            NULL,
-                            2,
-                            NULL,
-                            app_cpu);
+    task_a.createPinnedToCore(doTaskA,
+                              "Task A",
+                              NULL,
+                              2,
+                              app_cpu);
     
     // Start Task B (low priority)
-    xTaskCreatePinnedToCore(doTaskB,
-                            "Task B",
-                            1024,
-                            NULL,
-                            1,
-                            NULL,
-                            app_cpu);
+    task_b.createPinnedToCore(doTaskB,
+                              "Task B",
+                              NULL,
+                              1,
+                              app_cpu);
 
     // Delete "setup and loop" task
     vTaskDelete(NULL);
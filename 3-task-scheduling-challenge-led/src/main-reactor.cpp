@@ -0,0 +1,138 @@
+/*
+   LED delay challenge on one event loop
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   The same behaviour as main.cpp (type a number in milliseconds to change the blink
+   delay), but reading Serial and toggling the LED are callbacks of one reactor task
+   (lib/Reactor) instead of two tasks sharing the global led_delay. The serial callback
+   re-arms the blink timer directly, so the new delay applies right away instead of after
+   the current blink.
+
+   After every change it prints the loop statistics and how much of the single stack was
+   used; main.cpp needs two 1024 byte stacks and task control blocks for the same job.
+*/
+
+#include <Arduino.h>
+#include <stdlib.h>
+
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <Reactor.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+static const BaseType_t app_cpu = 0;
+#else
+static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const uint8_t buf_len = 20;
+
+// Pins
+static const int led_pin = LED_BUILTIN;
+
+// Globals (only used from the reactor task)
+static StaticReactor<1, 1, 4> reactor;    // 1 timer, 1 watch, 4 posted callbacks
+static Reactor::TimerId toggle_timer = -1;
+static char buf[buf_len];
+static uint8_t idx = 0;
+static TaskHandle_t reactor_task_handle = NULL;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<2048> reactor_task;
+
+//***********************************************************************************************
+// Callbacks (all run on the reactor task)
+
+static void toggleLED(void *arg) {
+  digitalWrite(led_pin, !digitalRead(led_pin));
+}
+
+static void printStats() {
+  ReactorStats stats;
+  reactor.getStats(&stats);
+
+  Serial.printf("Reactor: %u timer fires, %u serial fires, %u wake-ups, timer late by up to "
+                "%u ticks, longest callback %u us\n",
+                (unsigned)stats.timer_fires,
+                (unsigned)stats.watch_fires,
+                (unsigned)stats.wakeups,
+                (unsigned)stats.max_timer_late_ticks,
+                (unsigned)stats.max_callback_us);
+  Serial.printf("Reactor task: %u B stack, %u B never used\n",
+                (unsigned)reactor_task.stackDepth(),
+                (unsigned)uxTaskGetStackHighWaterMark(reactor_task_handle));
+}
+
+// Serial has data: collect a line, then apply the new delay
+static void readSerial(void *arg) {
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+
+    if (c == '\n') {
+      int led_delay = atoi(buf);
+      TickType_t period = msToTicksCeil(led_delay);
+
+      // A period of 0 would make the timer one-shot and stop the LED, keep it toggling
+      if (period == 0) {
+        period = 1;
+      }
+      reactor.setTimer(toggle_timer, period, period);
+
+      Serial.print("Updated LED delay to: ");
+      Serial.println(led_delay);
+      printStats();
+      memset(buf, 0, buf_len);
+      idx = 0;
+    } else if (idx < buf_len - 1) {
+
+      // Only append if index is not over message limit
+      buf[idx] = c;
+      idx++;
+    }
+  }
+}
+
+//***********************************************************************************************
+// Tasks
+
+void runReactor(void *parameter) {
+  reactor.begin();
+
+  TickType_t period = msToTicksCeil(500);
+  toggle_timer = reactor.addTimer(period, period, toggleLED, NULL);
+  reactor.watchStream(Serial, readSerial, NULL);
+
+  reactor.run();
+}
+
+//********************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure pin
+  pinMode(led_pin, OUTPUT);
+
+  // Configure serial and wait a second
+  Serial.begin(115200);
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println("Single-task LED Demo");
+  Serial.println("Enter a number in milliseconds to change the LED delay.");
+
+  reactor_task_handle = reactor_task.createPinnedToCore(runReactor,
+                                                        "Reactor",
+                                                        NULL,
+                                                        1,
+                                                        app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
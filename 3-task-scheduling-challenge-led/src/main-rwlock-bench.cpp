@@ -0,0 +1,247 @@
+/*
+  Shared configuration behind a plain mutex versus a reader-writer lock
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A configuration block of a few hundred bytes (here 256) is read by readers_per_core
+  control tasks on each core and rewritten by one writer every write_period_ms, the way
+  led_delay is in main.cpp but with more readers and more data. Each reader copies the
+  block and checks that it is not torn (every word carries the same version). The same
+  run is made twice:
+
+  - "mutex"  : readers and writer share one FreeRTOS mutex, readers wait for each other
+  - "rwlock" : lib/RwLock, readers only wait for the writer
+
+  For both, setup() prints the reads per second over all readers, the torn copies (must
+  be 0), and the longest time the writer waited for the lock.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <RwLock.h>
+
+// Settings
+static const int readers_per_core = 3;
+static const int num_readers = readers_per_core * portNUM_PROCESSORS;
+static const uint32_t run_ms = 2000;
+static const uint32_t write_period_ms = 10;
+static const uint32_t reads_per_yield = 1000;   // Lets the idle task (watchdog) run
+
+// Configuration block, every word holds the version that wrote it
+typedef struct Config {
+  uint32_t words[64];
+} Config;
+
+typedef enum LockKind {
+  LOCK_MUTEX,
+  LOCK_RWLOCK
+} LockKind;
+
+// Globals
+static Config config;
+static LockKind lock_kind;
+static SemaphoreHandle_t config_mutex;
+static RwLock config_rwlock;
+static volatile bool running = false;
+static volatile uint8_t num_done = 0;
+static uint32_t reads[num_readers];
+static uint32_t torn = 0;
+static uint32_t max_write_wait_us = 0;
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<2048> reader_tasks[num_readers];
+static TaskStorage<2048> writer_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static MutexStorage config_mutex_storage;
+
+//*****************************************************************************
+// Locking, the only difference between the two runs
+
+static void lockRead() {
+  if (lock_kind == LOCK_MUTEX) {
+    xSemaphoreTake(config_mutex, portMAX_DELAY);
+  } else {
+    config_rwlock.readLock(portMAX_DELAY);
+  }
+}
+
+static void unlockRead() {
+  if (lock_kind == LOCK_MUTEX) {
+    xSemaphoreGive(config_mutex);
+  } else {
+    config_rwlock.readUnlock();
+  }
+}
+
+static void lockWrite() {
+  if (lock_kind == LOCK_MUTEX) {
+    xSemaphoreTake(config_mutex, portMAX_DELAY);
+  } else {
+    config_rwlock.writeLock(portMAX_DELAY);
+  }
+}
+
+static void unlockWrite() {
+  if (lock_kind == LOCK_MUTEX) {
+    xSemaphoreGive(config_mutex);
+  } else {
+    config_rwlock.writeUnlock();
+  }
+}
+
+//*****************************************************************************
+// Tasks
+
+static void taskDone() {
+  portENTER_CRITICAL(&spinlock);
+  num_done++;
+  portEXIT_CRITICAL(&spinlock);
+  vTaskDelete(NULL);
+}
+
+// Task: copy the configuration as often as possible, count torn copies
+void readerTask(void *parameters) {
+  int index = (int)(intptr_t)parameters;
+  uint32_t count = 0;
+  uint32_t bad = 0;
+  Config copy;
+
+  while (running) {
+    lockRead();
+    memcpy(&copy, &config, sizeof(copy));
+    unlockRead();
+
+    for (int i = 1; i < 64; i++) {
+      if (copy.words[i] != copy.words[0]) {
+        bad++;
+        break;
+      }
+    }
+
+    count++;
+    if (count % reads_per_yield == 0) {
+      vTaskDelay(1);
+    }
+  }
+
+  reads[index] = count;
+  portENTER_CRITICAL(&spinlock);
+  torn += bad;
+  portEXIT_CRITICAL(&spinlock);
+  taskDone();
+}
+
+// Task: write a new version every write_period_ms, note the longest wait for the lock
+void writerTask(void *parameters) {
+  uint32_t version = 0;
+  uint32_t max_wait = 0;
+
+  while (running) {
+    int64_t start_us = esp_timer_get_time();
+    lockWrite();
+    uint32_t wait_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    version++;
+    for (int i = 0; i < 64; i++) {
+      config.words[i] = version;
+    }
+    unlockWrite();
+
+    if (wait_us > max_wait) {
+      max_wait = wait_us;
+    }
+    vTaskDelay(pdMS_TO_TICKS(write_period_ms));
+  }
+
+  max_write_wait_us = max_wait;
+  taskDone();
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+static void runBench(const char *name, LockKind kind) {
+  lock_kind = kind;
+  torn = 0;
+  num_done = 0;
+  running = true;
+
+  // Readers on both cores, the writer above them on core 1
+  for (int i = 0; i < num_readers; i++) {
+    reader_tasks[i].createPinnedToCore(readerTask,
+                                       "Reader",
+                                       (void *)(intptr_t)i,
+                                       1,
+                                       i % portNUM_PROCESSORS);
+  }
+  writer_task.createPinnedToCore(writerTask,
+                                 "Writer",
+                                 NULL,
+                                 2,
+                                 portNUM_PROCESSORS - 1);
+
+  vTaskDelay(pdMS_TO_TICKS(run_ms));
+  running = false;
+  while (num_done < num_readers + 1) {
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+
+  // Let the idle tasks finish deleting them before their storage is used again
+  vTaskDelay(100 / portTICK_PERIOD_MS);
+
+  uint32_t total = 0;
+  for (int i = 0; i < num_readers; i++) {
+    total += reads[i];
+  }
+
+  Serial.print(name);
+  Serial.print("\treads/s: ");
+  Serial.print((uint32_t)((uint64_t)total * 1000 / run_ms));
+  Serial.print("\ttorn: ");
+  Serial.print(torn);
+  Serial.print("\tmax write wait (us): ");
+  Serial.println(max_write_wait_us);
+}
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Reader-Writer Lock Benchmark---");
+  Serial.print(num_readers);
+  Serial.print(" readers of ");
+  Serial.print(sizeof(Config));
+  Serial.print(" bytes, one write every ");
+  Serial.print(write_period_ms);
+  Serial.println(" ms");
+
+  config_mutex = config_mutex_storage.create();
+  config_rwlock.begin();
+
+  runBench("mutex", LOCK_MUTEX);
+  runBench("rwlock", LOCK_RWLOCK);
+
+  RwLockStats stats;
+  config_rwlock.getStats(&stats);
+  Serial.print("rwlock\treads waiting for the writer: ");
+  Serial.print(stats.read_waits);
+  Serial.print(" of ");
+  Serial.print(stats.reads);
+  Serial.print("\twrites waiting for readers: ");
+  Serial.print(stats.write_waits);
+  Serial.print(" of ");
+  Serial.println(stats.writes);
+}
+
+void loop() {
+
+  // Do nothing but allow yielding to lower-priority tasks
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+}
@@ -12,6 +12,24 @@
    a variable when it sees an integer. The other task blinks the onboard LED (or other connected LED) at a rate specified by that integer.
    In effect, you want to create a multi-threaded system that allows for the user interface to run concurrently with 
    the control task (the blinking LED).
+
+   Efraim Manurung, 17th October 2026
+   Version 1.2 : Task stacks and control blocks are declared at compile time when
+                 built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.3 : The LED toggles on absolute release times (lib/PeriodicTask) instead of
+                 vTaskDelay(), so the blink keeps its phase. Overrun and jitter statistics
+                 are printed every time the delay is changed.
+
+   Efraim Manurung, 17th October 2026
+   Version 1.4 : led_delay is converted to ticks rounding up (lib/PreciseDelay), a delay
+                 below one tick no longer becomes 0
+
+   Efraim Manurung, 17th October 2026
+   Version 1.5 : led_delay is the shared configuration of the two tasks and is read and
+                 written under a reader-writer lock (lib/RwLock). Readers never wait for
+                 each other, only for the rare write from the command line.
 */
 
 /*
@@ -26,6 +44,11 @@
 // Needed for atoi()
 #include <stdlib.h>
 
+#include <StaticAlloc.h>
+#include <PeriodicTask.h>
+#include <PreciseDelay.h>
+#include <RwLock.h>
+
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
 static const BaseType_t app_cpu = 0;
@@ -40,18 +63,45 @@ static const uint8_t buf_len = 20;
 static const int led_pin = LED_BUILTIN;
 
 // Globals
-static int led_delay = 500;
+static int led_delay = 500;          // Configuration, guarded by config_lock
+static RwLock config_lock;
+static PeriodicTask toggle_period;   // Release times of toggleLED()
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> toggle_led_task;
+static TaskStorage<1024> read_serial_task;
+
+//***********************************************************************************************
+// Configuration
+
+static int readLedDelay() {
+  config_lock.readLock(portMAX_DELAY);
+  int delay_ms = led_delay;
+  config_lock.readUnlock();
+  return delay_ms;
+}
+
+static void writeLedDelay(int delay_ms) {
+  config_lock.writeLock(portMAX_DELAY);
+  led_delay = delay_ms;
+  config_lock.writeUnlock();
+}
 
 //***********************************************************************************************
 // Tasks
 
-// Task: Blink LED at rate set by global variable
+// Task: Blink LED at rate set by global variable (one toggle per led_delay)
 void toggleLED(void *parameter) {
+  toggle_period.begin(msToTicksCeil(readLedDelay()));
+
   while(1) {
     digitalWrite(led_pin, HIGH);
-    vTaskDelay(led_delay / portTICK_PERIOD_MS);
+    toggle_period.wait();
     digitalWrite(led_pin, LOW);
-    vTaskDelay(led_delay / portTICK_PERIOD_MS);
+    toggle_period.wait();
+
+    // Pick up a new delay once per blink, the phase of the blink is kept
+    toggle_period.setPeriod(msToTicksCeil(readLedDelay()));
   }
 }
 
@@ -84,9 +134,10 @@ void readSerial(void *parameter) {
         an integer. In this code, it is used to convert the string in the buffer `buf` to an integer,
         which is then used to set the `led_delay` variable.
         */
-        led_delay = atoi(buf); 
+        writeLedDelay(atoi(buf));
         Serial.print("Updated LED delay to: ");
-        Serial.println(led_delay);
+        Serial.println(readLedDelay());
+        toggle_period.printStats(Serial, "Toggle LED");
         memset(buf, 0, buf_len);
         idx = 0;
       } else {
@@ -115,23 +166,22 @@ void setup() {
   Serial.println("Multi-task LED Demo");
   Serial.println("Enter a number in milliseconds to change the LED delay.");
 
+  // Lock for the configuration, before the tasks that use it
+  config_lock.begin();
+
   // Task to run forever
-  xTaskCreatePinnedToCore(toggleLED,
-                          "Toggle LED",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  toggle_led_task.createPinnedToCore(toggleLED,
+                                     "Toggle LED",
+                                     NULL,
+                                     1,
+                                     app_cpu);
   
   // Task to run once with higher priority
-  xTaskCreatePinnedToCore(readSerial,
-                          "Read Serial",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  read_serial_task.createPinnedToCore(readSerial,
+                                      "Read Serial",
+                                      NULL,
+                                      1,
+                                      app_cpu);
 }
 
 void loop() {
@@ -0,0 +1,128 @@
+/*
+   Delay accuracy: tick-based vTaskDelay() versus PreciseDelay
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   For a few requested delays (from well below one tick to several ticks) this measures
+   how long the task really waited, averaged over num_runs, with:
+
+   - "truncate" : vTaskDelay(us / 1000 / portTICK_PERIOD_MS), the old conversion
+   - "ceil"     : vTaskDelay(usToTicksCeil(us)), never shorter than asked for
+   - "precise"  : PreciseDelay::delayUs(us), esp_timer sleep plus a short spin
+
+   The tick is left at its configured rate (configTICK_RATE_HZ).
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_runs = 20;
+static const uint32_t delays_us[] = {50, 300, 1000, 1500, 2500, 10000};
+
+// Globals
+static PreciseDelay precise;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<4096> bench_task;
+
+//*****************************************************************************
+// Measurements
+
+typedef void (*DelayFunc)(uint32_t us);
+
+static void truncateDelay(uint32_t us) { vTaskDelay(us / 1000 / portTICK_PERIOD_MS); }
+static void ceilDelay(uint32_t us) { vTaskDelay(usToTicksCeil(us)); }
+static void preciseDelay(uint32_t us) { precise.delayUs(us); }
+
+static void measure(const char *name, DelayFunc delay_func, uint32_t us) {
+  int64_t total = 0;
+  int64_t worst = 0;
+
+  for (int i = 0; i < num_runs; i++) {
+
+    // Start right after a tick, so every run sees the same phase
+    vTaskDelay(1);
+
+    int64_t start = esp_timer_get_time();
+    delay_func(us);
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    total += elapsed;
+    int64_t error = (elapsed > us) ? elapsed - us : us - elapsed;
+    if (error > worst) {
+      worst = error;
+    }
+  }
+
+  Serial.print(name);
+  Serial.print("\trequested: ");
+  Serial.print(us);
+  Serial.print(" us\tavg: ");
+  Serial.print((int32_t)(total / num_runs));
+  Serial.print(" us\tworst error: ");
+  Serial.print((int32_t)worst);
+  Serial.println(" us");
+}
+
+//*****************************************************************************
+// Tasks
+
+void benchTask(void *parameter) {
+  if (!precise.begin()) {
+    Serial.println("Could not create the esp_timer");
+    vTaskDelete(NULL);
+  }
+
+  Serial.print("Tick: ");
+  Serial.print(portTICK_PERIOD_MS);
+  Serial.print(" ms, spin margin: ");
+  Serial.print(precise.spinMarginUs());
+  Serial.println(" us");
+
+  for (size_t i = 0; i < sizeof(delays_us) / sizeof(delays_us[0]); i++) {
+    measure("truncate", truncateDelay, delays_us[i]);
+    measure("ceil", ceilDelay, delays_us[i]);
+    measure("precise", preciseDelay, delays_us[i]);
+  }
+
+  Serial.println("Done");
+  vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Delay Accuracy---");
+
+  // Start the benchmark task
+  bench_task.createPinnedToCore(benchTask,
+                                "Bench Task",
+                                NULL,
+                                1,
+                                app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
@@ -0,0 +1,150 @@
+/*
+   Earliest-deadline-first scheduling demo
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Two periodic tasks load core 1 to 88 %:
+
+   - Control : every 20 ms, 11 ms of work
+   - Filter  : every 30 ms, 10 ms of work
+
+   With rate-monotonic priorities (Control above Filter) Filter misses its deadline every
+   other job: Control runs twice inside most 30 ms windows and leaves Filter only 8 ms.
+   Here both run in an EDF band (lib/EdfScheduler), where the job with the earliest
+   deadline runs first, and neither misses. A fixed-priority report task above the band
+   prints the statistics every 2 seconds.
+
+   host-tools/tasksets/edf-demo.csv holds the same task set, compare the policies on the
+   PC with the sched-sim environment in host-tools.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <EdfScheduler.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const UBaseType_t edf_priority = 1;       // Band uses 1, 2 and 3
+static const UBaseType_t report_priority = 4;    // Above the band
+static const uint32_t control_work_ms = 11;
+static const uint32_t filter_work_ms = 10;
+
+// Globals
+static EdfBand band;
+static EdfTask control_edf;
+static EdfTask filter_edf;
+static volatile uint32_t loops_per_ms = 0;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<2048> control_task;
+static TaskStorage<2048> filter_task;
+static TaskStorage<4096> report_task;
+
+//*****************************************************************************
+// Helpers
+
+// The busy loop itself, burnMs() and calibrate() must run exactly the same code
+static void __attribute__((noinline)) spin(uint32_t loops) {
+  for (uint32_t i = 0; i < loops; i++) {
+    __asm__ __volatile__("nop");
+  }
+}
+
+// Busy loop that needs `ms` of CPU time, however often it gets preempted
+static void burnMs(uint32_t ms) {
+  const uint32_t n = ms * loops_per_ms;
+  spin(n);
+}
+
+// Count loops per millisecond before any other task runs on this core
+static void calibrate() {
+  const uint32_t loops = 1000000;
+
+  int64_t start = esp_timer_get_time();
+  spin(loops);
+  int64_t elapsed = esp_timer_get_time() - start;
+
+  loops_per_ms = (uint32_t)(loops * 1000LL / elapsed);
+}
+
+//*****************************************************************************
+// Tasks
+
+void control(void *parameters) {
+  control_edf.begin(band, pdMS_TO_TICKS(20));
+
+  while (1) {
+    burnMs(control_work_ms);
+    control_edf.wait();
+  }
+}
+
+void filter(void *parameters) {
+  filter_edf.begin(band, pdMS_TO_TICKS(30));
+
+  while (1) {
+    burnMs(filter_work_ms);
+    filter_edf.wait();
+  }
+}
+
+void report(void *parameters) {
+  while (1) {
+    vTaskDelay(2000 / portTICK_PERIOD_MS);
+    control_edf.printStats(Serial, "Control");
+    filter_edf.printStats(Serial, "Filter");
+  }
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS EDF Demo---");
+
+  calibrate();
+  Serial.print("Busy loop: ");
+  Serial.print(loops_per_ms);
+  Serial.println(" loops per ms");
+
+  band.begin(edf_priority, app_cpu);
+
+  control_task.createPinnedToCore(control,
+                                  "Control",
+                                  NULL,
+                                  edf_priority,
+                                  app_cpu);
+
+  filter_task.createPinnedToCore(filter,
+                                 "Filter",
+                                 NULL,
+                                 edf_priority,
+                                 app_cpu);
+
+  report_task.createPinnedToCore(report,
+                                 "Report",
+                                 NULL,
+                                 report_priority,
+                                 app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
@@ -4,6 +4,15 @@
 
    Efraim Manurung, 09th March 2024
    Version 1.0
+
+   Efraim Manurung, 17th October 2026
+   Version 1.1 : Task stacks and control blocks are declared at compile time when
+                 built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.2 : Task 2 runs on absolute release times (lib/PeriodicTask), so the time
+                 spent printing at 300 baud no longer stretches its period. Its overrun
+                 statistics are printed after the suspend/resume cycles.
 */
 
 /*
@@ -14,6 +23,8 @@
 
 #include <Arduino.h>
 // #include <FreeRTOSConfig.h>
+#include <StaticAlloc.h>
+#include <PeriodicTask.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -29,6 +40,13 @@ const char msg[] = "Hello, Efraim Manurung!";
 static TaskHandle_t task_1 = NULL;
 static TaskHandle_t task_2 = NULL;
 
+// Release times of task 2
+static PeriodicTask task_2_period;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> task_1_storage;
+static TaskStorage<1024> task_2_storage;
+
 //***********************************************************************************************
 // Tasks
 
@@ -51,9 +69,11 @@ void startTask1(void *parameter) {
 
 // Task: print to Serial Terminal with higher priority
 void startTask2(void *parameter) {
+  task_2_period.begin(100 / portTICK_PERIOD_MS);
+
   while(1) {
     Serial.print('*');
-    vTaskDelay(100 / portTICK_PERIOD_MS);
+    task_2_period.wait();
   }
 }
 
@@ -77,22 +97,18 @@ void setup() {
   Serial.println(uxTaskPriorityGet(NULL));
 
   // Task to run forever
-  xTaskCreatePinnedToCore(startTask1,
-                          "Task 1",
-                          1024,
-                          NULL,
-                          1,
-                          &task_1,
-                          app_cpu);
+  task_1 = task_1_storage.createPinnedToCore(startTask1,
+                                             "Task 1",
+                                             NULL,
+                                             1,
+                                             app_cpu);
   
   // Task to run once with higher priority
-  xTaskCreatePinnedToCore(startTask2,
-                          "Task 2",
-                          1024,
-                          NULL,
-                          2,
-                          &task_2,
-                          app_cpu);
+  task_2 = task_2_storage.createPinnedToCore(startTask2,
+                                             "Task 2",
+                                             NULL,
+                                             2,
+                                             app_cpu);
 }
 
 void loop() {
@@ -105,6 +121,10 @@ void loop() {
     vTaskDelay(2000 / portTICK_PERIOD_MS);
   }
 
+  // Suspending task 2 shows up as overruns with the skipped releases
+  Serial.println();
+  task_2_period.printStats(Serial, "Task 2");
+
   // Delete the lower priority task
   if (task_1 != NULL) {
     vTaskDelete(task_1);
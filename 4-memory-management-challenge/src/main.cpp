@@ -10,9 +10,20 @@
 
     Efraim Manurung, 3rd August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Message buffers come from a fixed-size block pool instead of
+                  pvPortMalloc()/vPortFree(), so allocation time is constant and
+                  the heap does not fragment.
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : Task stacks and control blocks are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
  */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <BlockPool.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -23,11 +34,17 @@
 
 // Settings
 static const uint8_t buf_len = 255;
+static const uint8_t msg_pool_len = 2;    // Only one message is in flight at a time
 
 // Globals
+static StaticBlockPool<buf_len, msg_pool_len> msg_pool;
 static char *msg_ptr = NULL;
 static volatile uint8_t msg_flag = 0;
 
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> read_serial_task;
+static TaskStorage<1024> print_message_task;
+
 //*****************************************************************************
 // Tasks
 
@@ -64,9 +81,9 @@ void readSerial(void *parameters) {
         // Try to allocate memory and copy over message. If message buffer is
         // still in use, ignore the entire message.
         if (msg_flag == 0) {
-          msg_ptr = (char *)pvPortMalloc(idx * sizeof(char));
+          msg_ptr = (char *)msg_pool.alloc();
 
-          // If malloc returns 0 (out of memory), throw an error and reset
+          // If the pool is empty a block was leaked, throw an error and reset
           configASSERT(msg_ptr);
 
           // Copy message
@@ -92,12 +109,12 @@ void printMessage(void *parameters) {
     if (msg_flag == 1) {
       Serial.println(msg_ptr);
 
-      // Give amount of free heap memory (uncomment if you'd like to see it)
-//      Serial.print("Free heap (bytes): ");
-//      Serial.println(xPortGetFreeHeapSize());
+      // Give amount of free pool blocks (uncomment if you'd like to see it)
+//      Serial.print("Free blocks: ");
+//      Serial.println(msg_pool.freeBlocks());
 
       // Free buffer, set pointer to null, and clear flag
-      vPortFree(msg_ptr);
+      msg_pool.free(msg_ptr);
       msg_ptr = NULL;
       msg_flag = 0;
     }
@@ -119,22 +136,18 @@ void setup() {
   Serial.println("Enter a string");
 
   // Start Serial receive task
-  xTaskCreatePinnedToCore(readSerial,
-                          "Read Serial",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  read_serial_task.createPinnedToCore(readSerial,
+                                      "Read Serial",
+                                      NULL,
+                                      1,
+                                      app_cpu);
 
   // Start Serial print task
-  xTaskCreatePinnedToCore(printMessage,
-                          "Print Message",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  print_message_task.createPinnedToCore(printMessage,
+                                        "Print Message",
+                                        NULL,
+                                        1,
+                                        app_cpu);
   
   // Delete "setup and loop" task
   vTaskDelete(NULL);
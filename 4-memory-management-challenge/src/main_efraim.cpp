@@ -6,6 +6,26 @@
    Efraim Manurung, 3rd August 2024
    Version 1.0
 
+   Efraim Manurung, 17th October 2026
+   Version 1.1 : Strings are stored in blocks from a fixed-size block pool instead of
+                 pvPortMalloc()/vPortFree(). The second task now loops forever, and a
+                 block whose notification can't be delivered is returned to the pool
+                 instead of being overwritten (and leaked).
+
+   Efraim Manurung, 17th October 2026
+   Version 1.2 : Task stacks and control blocks are declared at compile time when
+                 built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.3 : String blocks are recorded by the leak tracker (lib/LeakTracker) when built
+                 with LEAK_TRACKER=1. Type "mark", "leaks" or "dump" in the Serial Monitor
+                 to set a checkpoint, list the blocks allocated since and still alive, or
+                 list every live block.
+
+   Efraim Manurung, 17th October 2026
+   Version 1.4 : Carriage returns are dropped while reading, so lines from a monitor that
+                 sends CRLF match the leak tracker commands
+
    Concept of memory management 
 
    Volatile memory (e.g. RAM) in most microcontroller systems is divided up into 3 sections:
@@ -42,10 +62,17 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
 
 // Import FreeRTOS library
 #include <freertos/FreeRTOS.h>
 
+// Fixed-size block allocator (lib/BlockPool)
+#include <BlockPool.h>
+
+// Call-site recording of live blocks, only active with LEAK_TRACKER=1 (lib/LeakTracker)
+#include <LeakTracker.h>
+
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
   static const BaseType_t app_cpu = 0;
@@ -55,10 +82,44 @@
 
 // Set global variables
 static const uint8_t string_len = 255;
+static const uint8_t string_pool_len = 4;   // Strings that can be in flight at once
+
+// Pool of string buffers, every block holds one full line
+static StaticBlockPool<string_len, string_pool_len> string_pool;
 
 // Handle for the second task notification
 TaskHandle_t secondTaskHandle = NULL;
 
+#if LEAK_TRACKER
+  // Allocation sequence number of the last "mark" command
+  static uint32_t leak_checkpoint = 0;
+#endif
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<2048> first_task;
+static TaskStorage<2048> second_task;
+
+#if LEAK_TRACKER
+// Leak tracker commands, returns true if the line was one of them
+static bool handleLeakCommand(const char *line) {
+  if (strcmp(line, "mark") == 0) {
+    leak_checkpoint = leakTrackerCheckpoint();
+    Serial.print("Checkpoint set at #");
+    Serial.println(leak_checkpoint);
+    return true;
+  }
+  if (strcmp(line, "leaks") == 0) {
+    leakTrackerReport(Serial, leak_checkpoint);
+    return true;
+  }
+  if (strcmp(line, "dump") == 0) {
+    leakTrackerDump(Serial);
+    return true;
+  }
+  return false;
+}
+#endif
+
 // First task: Listen for input over UART (from the Serial Monitor).
 void firstTask(void *parameter) {
   // Initiate local variables
@@ -84,23 +145,37 @@ void firstTask(void *parameter) {
 
       // Update the string_input and reset buffer if we get a newline character
       if (c == '\n') {
-        
-        // Allocate memory for the string
-        char *string_send = (char *)pvPortMalloc((idx + 1) * sizeof(char));
+
+#if LEAK_TRACKER
+        // Commands for the leak tracker are not sent on as messages
+        if (handleLeakCommand(string_input)) {
+          memset(string_input, 0, string_len);
+          idx = 0;
+          continue;
+        }
+#endif
+
+        // Take a block for the string (constant time, never touches the heap)
+        char *string_send = (char *)string_pool.alloc();
 
         // Check the allocated memory
         if (string_send != NULL) {
+          TRACK_ALLOC(string_send, string_len);
 
           // char *strncpy(char *dest, const char *src, size_t n)
           strncpy(string_send, string_input, idx);
           string_send[idx] = '\0';
 
-          // Notify the second task
-          xTaskNotify(secondTaskHandle, (uint32_t)string_send, eSetValueWithOverwrite);
-
-          // string_send = string_input;
+          // Print before handing over, the second task owns the block afterwards
           Serial.print("Update send string message: ");
           Serial.println(string_send);
+
+          // Notify the second task, if it still has a pending string give the block back
+          if (xTaskNotify(secondTaskHandle, (uint32_t)string_send, eSetValueWithoutOverwrite) != pdPASS) {
+            Serial.println("Second task busy, message dropped!");
+            TRACK_FREE(string_send);
+            string_pool.free(string_send);
+          }
         } else {
           Serial.println("Memory allocation failed!");
         }
@@ -108,8 +183,8 @@ void firstTask(void *parameter) {
         // Clear whole buffer
         memset(string_input, 0, string_len);
         idx = 0;
-      } else if (idx < string_len - 1) {
-        // Append character to the string
+      } else if (c != '\r' && idx < string_len - 1) {
+        // Append character to the string (without the '\r' of a CRLF line ending)
         string_input[idx++] = c;
       }
     }
@@ -118,17 +193,23 @@ void firstTask(void *parameter) {
 
 // Second task: Wait and receives the notification, it prints the message in heap memory to the Serial monitor.
 void secondTask(void *parameter) {
-  // Wait for notification
   char *received_string;
-  if (xTaskNotifyWait(0, 0, (uint32_t *)&received_string, portMAX_DELAY)) {
-
-    // Check again the received string 
-    if (received_string != NULL) {
-        Serial.print("Received string message: ");
-        Serial.println(received_string);
-      
-        // Free the memory of microcontroller
-        vPortFree(received_string);
+
+  // Loop forever
+  while (1) {
+
+    // Wait for notification
+    if (xTaskNotifyWait(0, 0, (uint32_t *)&received_string, portMAX_DELAY)) {
+
+      // Check again the received string 
+      if (received_string != NULL) {
+          Serial.print("Received string message: ");
+          Serial.println(received_string);
+        
+          // Give the block back to the pool
+          TRACK_FREE(received_string);
+          string_pool.free(received_string);
+      }
     }
   }
 }
@@ -140,22 +221,18 @@ void setup() {
 
   // Create tasks
   // Task to run forever
-  xTaskCreatePinnedToCore(firstTask,
-                          "First Task",
-                          2048,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  first_task.createPinnedToCore(firstTask,
+                                "First Task",
+                                NULL,
+                                1,
+                                app_cpu);
   
   // Task to run once with higher priority
-  xTaskCreatePinnedToCore(secondTask,
-                          "Second Task",
-                          2048,
-                          NULL,
-                          1,
-                          &secondTaskHandle,
-                          app_cpu);
+  secondTaskHandle = second_task.createPinnedToCore(secondTask,
+                                                    "Second Task",
+                                                    NULL,
+                                                    1,
+                                                    app_cpu);
 
 }
 
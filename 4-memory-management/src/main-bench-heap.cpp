@@ -0,0 +1,334 @@
+/*
+   Heap benchmark: TLSF versus the default ESP-IDF heap
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Replays the allocation patterns of the memory management sketches against two heaps and
+   prints the average and worst-case cost of malloc/free in CPU cycles, failed requests and
+   how fragmented the heap is at the end of each trace:
+
+   - "demo"   : 4-memory-management, malloc 1024 ints, free, repeat
+   - "lines"  : 4-memory-management-challenge, one buffer per received line (2..255 bytes),
+                up to 4 lines in flight, freed in order
+   - "mixed"  : both of the above plus small Message structs, up to 32 blocks alive (at
+                most max_big_alive of them 4 KB buffers), freed in random order (the
+                pattern that fragments a first-fit heap)
+
+   The traces are generated once from a fixed seed, so both heaps see exactly the same
+   requests. The TLSF heap runs on its own 48 KB region, about twice the peak of live bytes
+   of any trace; the ESP-IDF heap is the whole system heap, so its fragmentation figure
+   also includes everything else that lives there.
+   Build this with the default environment (in the -tlsf one pvPortMalloc() is TLSF too).
+
+   Fragmentation (%) = 100 * (1 - largest free block / total free bytes)
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <esp_heap_caps.h>
+#include <TlsfHeap.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_ops = 4000;        // Operations per trace
+static const int max_slots = 32;        // Blocks that can be alive at once
+static const int max_big_alive = 4;     // 4 KB buffers alive at once in the mixed trace
+static const size_t tlsf_size = 48 * 1024;
+
+// One trace operation: allocate `size` bytes into `slot`, or free `slot` if size is 0
+typedef struct TraceOp {
+  uint16_t size;
+  uint8_t slot;
+} TraceOp;
+
+// Result of replaying one trace on one heap
+typedef struct BenchResult {
+  uint32_t alloc_count;
+  uint32_t alloc_total;
+  uint32_t alloc_max;
+  uint32_t free_count;
+  uint32_t free_total;
+  uint32_t free_max;
+  uint32_t fail_count;
+  uint8_t fragmentation;
+} BenchResult;
+
+typedef void *(*AllocFunc)(size_t size);
+typedef void (*FreeFunc)(void *ptr);
+typedef uint8_t (*FragFunc)(void);
+
+// Globals
+static TraceOp trace[num_ops];
+static int trace_len = 0;
+static void *slots[max_slots];
+static uint32_t rng_state = 1;
+
+static uint8_t tlsf_region[tlsf_size] __attribute__((aligned(8)));
+static TlsfHeap tlsf_heap;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<4096> bench_task;
+
+//*****************************************************************************
+// Heaps under test
+
+static void *tlsfAlloc(size_t size) { return tlsf_heap.malloc(size); }
+static void tlsfFree(void *ptr) { tlsf_heap.free(ptr); }
+
+static uint8_t tlsfFragmentation() {
+  TlsfHeapStats stats;
+  tlsf_heap.getStats(&stats);
+  return stats.fragmentation;
+}
+
+static uint8_t idfFragmentation() {
+  size_t free_bytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  if (free_bytes == 0) {
+    return 0;
+  }
+  return 100 - (uint8_t)((uint64_t)largest * 100 / free_bytes);
+}
+
+//*****************************************************************************
+// Trace generation (xorshift, fixed seed so every run is identical)
+
+static uint32_t nextRandom() {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static void addOp(uint16_t size, uint8_t slot) {
+  if (trace_len < num_ops) {
+    trace[trace_len].size = size;
+    trace[trace_len].slot = slot;
+    trace_len++;
+  }
+}
+
+// 4-memory-management: 1024 ints, freed right away
+static void makeDemoTrace() {
+  trace_len = 0;
+  while (trace_len < num_ops) {
+    addOp(1024 * sizeof(int), 0);
+    addOp(0, 0);
+  }
+}
+
+// 4-memory-management-challenge: one buffer per line, a few lines in flight
+static void makeLinesTrace() {
+  const uint8_t in_flight = 4;
+  uint8_t head = 0;
+  uint8_t tail = 0;
+
+  trace_len = 0;
+  rng_state = 1;
+  while (trace_len < num_ops) {
+    if ((uint8_t)(head - tail) < in_flight && (nextRandom() & 1)) {
+      addOp(2 + nextRandom() % 254, head % in_flight);
+      head++;
+    } else if (head != tail) {
+      addOp(0, tail % in_flight);
+      tail++;
+    }
+  }
+}
+
+// Lines, big buffers and small structs with random lifetimes
+static void makeMixedTrace() {
+  bool used[max_slots] = {false};
+  bool big[max_slots] = {false};
+  int big_alive = 0;
+
+  trace_len = 0;
+  rng_state = 12345;
+  while (trace_len < num_ops) {
+    uint8_t slot = nextRandom() % max_slots;
+    if (used[slot]) {
+      addOp(0, slot);
+      used[slot] = false;
+      if (big[slot]) {
+        big[slot] = false;
+        big_alive--;
+      }
+    } else {
+      uint32_t kind = nextRandom() % 8;
+      uint16_t size;
+      if (kind == 0 && big_alive < max_big_alive) {
+        size = 1024 * sizeof(int);
+        big[slot] = true;
+        big_alive++;
+      } else if (kind < 4) {
+        size = 2 + nextRandom() % 254;
+      } else {
+        size = 24;  // sizeof(Message) in the queue sketches
+      }
+      addOp(size, slot);
+      used[slot] = true;
+    }
+  }
+}
+
+// Most bytes the trace has alive at once
+static uint32_t tracePeakBytes() {
+  uint16_t sizes[max_slots] = {0};
+  uint32_t live = 0;
+  uint32_t peak = 0;
+
+  for (int i = 0; i < trace_len; i++) {
+    uint8_t slot = trace[i].slot;
+    live -= sizes[slot];
+    sizes[slot] = trace[i].size;
+    live += sizes[slot];
+    if (live > peak) {
+      peak = live;
+    }
+  }
+  return peak;
+}
+
+//*****************************************************************************
+// Replay
+
+static void replay(AllocFunc alloc_func, FreeFunc free_func, FragFunc frag_func,
+                   BenchResult *result) {
+  memset(result, 0, sizeof(BenchResult));
+  memset(slots, 0, sizeof(slots));
+
+  // Keep other tasks on this core from landing inside a measurement
+  vTaskSuspendAll();
+
+  for (int i = 0; i < trace_len; i++) {
+    uint8_t slot = trace[i].slot;
+
+    if (trace[i].size > 0) {
+      uint32_t start = ESP.getCycleCount();
+      slots[slot] = alloc_func(trace[i].size);
+      uint32_t cycles = ESP.getCycleCount() - start;
+
+      if (slots[slot] == NULL) {
+        result->fail_count++;
+        continue;
+      }
+      result->alloc_count++;
+      result->alloc_total += cycles;
+      if (cycles > result->alloc_max) {
+        result->alloc_max = cycles;
+      }
+    } else if (slots[slot] != NULL) {
+      uint32_t start = ESP.getCycleCount();
+      free_func(slots[slot]);
+      uint32_t cycles = ESP.getCycleCount() - start;
+
+      slots[slot] = NULL;
+      result->free_count++;
+      result->free_total += cycles;
+      if (cycles > result->free_max) {
+        result->free_max = cycles;
+      }
+    }
+  }
+
+  // Measure with whatever the trace left alive, then clean up
+  result->fragmentation = frag_func();
+  for (int i = 0; i < max_slots; i++) {
+    free_func(slots[i]);
+    slots[i] = NULL;
+  }
+
+  xTaskResumeAll();
+}
+
+static void printResult(const char *trace_name, const char *heap_name, BenchResult *result) {
+  Serial.print(trace_name);
+  Serial.print("\t");
+  Serial.print(heap_name);
+  Serial.print("\talloc avg/max: ");
+  Serial.print(result->alloc_count ? result->alloc_total / result->alloc_count : 0);
+  Serial.print("/");
+  Serial.print(result->alloc_max);
+  Serial.print("\tfree avg/max: ");
+  Serial.print(result->free_count ? result->free_total / result->free_count : 0);
+  Serial.print("/");
+  Serial.print(result->free_max);
+  Serial.print("\tfails: ");
+  Serial.print(result->fail_count);
+  Serial.print("\tfrag (%): ");
+  Serial.println(result->fragmentation);
+}
+
+static void runTrace(const char *trace_name) {
+  BenchResult result;
+
+  Serial.print(trace_name);
+  Serial.print("\tpeak live bytes: ");
+  Serial.print(tracePeakBytes());
+  Serial.print(" (TLSF region ");
+  Serial.print(tlsf_size);
+  Serial.println(")");
+
+  replay(pvPortMalloc, vPortFree, idfFragmentation, &result);
+  printResult(trace_name, "esp-idf", &result);
+
+  replay(tlsfAlloc, tlsfFree, tlsfFragmentation, &result);
+  printResult(trace_name, "tlsf", &result);
+}
+
+//*****************************************************************************
+// Tasks
+
+// Task: run every trace on both heaps once
+void benchTask(void *parameter) {
+  Serial.println("Cycles per call (CPU clock), lower is better");
+
+  makeDemoTrace();
+  runTrace("demo");
+
+  makeLinesTrace();
+  runTrace("lines");
+
+  makeMixedTrace();
+  runTrace("mixed");
+
+  Serial.println("Done");
+  vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Heap Benchmark---");
+
+  tlsf_heap.init(tlsf_region, sizeof(tlsf_region));
+
+  // Start the benchmark task
+  bench_task.createPinnedToCore(benchTask,
+                                "Bench Task",
+                                NULL,
+                                1,
+                                app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
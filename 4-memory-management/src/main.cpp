@@ -4,9 +4,31 @@
    
    Efraim Manurung, 10th March 2024
    Version 1.0
+
+   Efraim Manurung, 17th October 2026
+   Version 1.1 : pvPortMalloc()/vPortFree() can be backed by the TLSF heap (lib/TlsfHeap)
+                 by building the esp32doit-devkit-v1-tlsf environment. The allocation
+                 benchmark lives in main-bench-heap.cpp.
+
+   Efraim Manurung, 17th October 2026
+   Version 1.2 : Task stacks and control blocks are declared at compile time when
+                 built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.3 : A telemetry task prints a heap summary (largest free block, minimum ever
+                 free, fragmentation) every few seconds and warns as soon as the 4 KB block
+                 used by the test task no longer fits. Type "heap" in the Serial Monitor
+                 for the full free-block histogram (lib/HeapStats).
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
+
+// Selects the heap behind pvPortMalloc() when built with -DUSE_TLSF_HEAP=1
+#include <TlsfHeap.h>
+
+// Free-block histogram and fragmentation of the heap behind pvPortMalloc()
+#include <HeapStats.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -15,6 +37,16 @@
   static const BaseType_t app_cpu = 1;
 #endif
 
+// Settings
+static const size_t test_block_size = 1024 * sizeof(int);  // What the test task allocates
+static const int telemetry_period = 5000;                  // ms between heap summaries
+static const int cli_poll_period = 50;                     // ms between Serial reads
+static const uint8_t cmd_buf_len = 16;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1500> test_task;
+static TaskStorage<3072> telemetry_task;
+
 // Task: Perform some mundane task
 void testTask(void *parameter) {
   while(1) {
@@ -35,7 +67,7 @@ void testTask(void *parameter) {
     Serial.print("Heap before malloc (bytes): ");
     Serial.println(xPortGetFreeHeapSize());
 
-    int *ptr = (int*)pvPortMalloc(1024 * sizeof(int));
+    int *ptr = (int*)pvPortMalloc(test_block_size);
 
     // One way to prevent heap overflow is to check the malloc output
     if (ptr == NULL) {
@@ -59,6 +91,49 @@ void testTask(void *parameter) {
   }
 }
 
+// Task: periodic heap summary, full report on the "heap" command
+void heapTelemetry(void *parameter) {
+  char cmd_buf[cmd_buf_len];
+  uint8_t idx = 0;
+  TickType_t last_report = xTaskGetTickCount();
+  HeapReport report;
+
+  while (1) {
+
+    // Read characters from serial
+    while (Serial.available() > 0) {
+      char c = Serial.read();
+
+      if (c == '\n' || c == '\r') {
+        cmd_buf[idx] = '\0';
+        if (strcmp(cmd_buf, "heap") == 0) {
+          heapStatsCollect(&report);
+          heapStatsPrint(Serial, &report);
+        } else if (idx > 0) {
+          Serial.println("Unknown command, try \"heap\"");
+        }
+        idx = 0;
+      } else if (idx < cmd_buf_len - 1) {
+        cmd_buf[idx++] = c;
+      }
+    }
+
+    // Periodic summary, with an alarm before allocations start to fail
+    if (xTaskGetTickCount() - last_report >= telemetry_period / portTICK_PERIOD_MS) {
+      last_report = xTaskGetTickCount();
+      heapStatsCollect(&report);
+      heapStatsPrintSummary(Serial, &report);
+      if (report.largest_free_block < test_block_size) {
+        Serial.print("WARNING: largest free block is below ");
+        Serial.print(test_block_size);
+        Serial.println(" bytes, the next test allocation will fail");
+      }
+    }
+
+    vTaskDelay(cli_poll_period / portTICK_PERIOD_MS);
+  }
+}
+
 void setup() {
 
   // Configure Serial
@@ -69,14 +144,19 @@ void setup() {
   Serial.println();
   Serial.println("---FreeRTOS Memory Demo---");
 
-  // Start the only other task
-  xTaskCreatePinnedToCore(testTask,
-                          "Test Task",
-                          1500,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  // Start the test task
+  test_task.createPinnedToCore(testTask,
+                               "Test Task",
+                               NULL,
+                               1,
+                               app_cpu);
+
+  // Start the heap telemetry task
+  telemetry_task.createPinnedToCore(heapTelemetry,
+                                    "Heap Telemetry",
+                                    NULL,
+                                    1,
+                                    app_cpu);
 
   // Delete "setup and loop" task
   vTaskDelete(NULL);
@@ -0,0 +1,291 @@
+/*
+  Event loop benchmark: two tasks with a queue versus one reactor task
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Models the queue challenge with measurable events. A producer task (standing in for the
+  serial driver) sends a timestamp every stamp_period_ms; a periodic activity (standing in
+  for the blink) runs every blink_period_ms. Both are handled in two ways:
+
+  - "tasks"   : a consumer task blocked on a FreeRTOS queue and a blink task on
+                vTaskDelayUntil(), like main.cpp
+  - "reactor" : one reactor task (lib/Reactor); the producer post()s the timestamp and
+                the blink is a periodic timer, like main-reactor.cpp
+
+  For each it prints the event latency (producer timestamp to handler) and how late the
+  periodic activity ran against its ideal grid (average and worst), and the RAM the
+  design needs: stacks, task control blocks and queue buffers, plus the stack really used.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <Reactor.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_stamps = 1000;
+static const uint32_t stamp_period_ms = 3;
+static const uint32_t blink_period_ms = 10;
+static const uint32_t stack_size = 2048;
+static const int stamp_queue_len = 8;
+static const UBaseType_t producer_priority = 2;   // Like a driver task, above the app
+
+// Latency samples
+typedef struct Samples {
+  uint32_t count;
+  uint64_t sum_us;
+  uint32_t max_us;
+} Samples;
+
+// RAM of one design
+typedef struct Footprint {
+  uint32_t tasks;
+  uint32_t stack_bytes;
+  uint32_t stack_used;
+  uint32_t tcb_bytes;
+  uint32_t queue_bytes;
+  uint32_t table_bytes;
+} Footprint;
+
+// Globals
+static TaskHandle_t bench_handle = NULL;
+static volatile bool use_reactor = false;
+static volatile bool phase_done = false;
+static QueueHandle_t stamp_queue = NULL;
+static StaticReactor<1, 1, stamp_queue_len> reactor;
+static Reactor::TimerId blink_timer = -1;
+static Samples stamp_samples;
+static Samples blink_samples;
+static uint32_t blink_start_us;
+static uint32_t blink_count;
+static uint32_t phase_stack_used;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<stack_size> consumer_task;
+static TaskStorage<stack_size> blink_task;
+static TaskStorage<stack_size> reactor_task;
+static TaskStorage<2048> producer_task;
+static TaskStorage<4096> bench_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static QueueStorage<uint32_t, stamp_queue_len> stamp_queue_storage;
+
+//*****************************************************************************
+// Helpers
+
+static void record(Samples *samples, uint32_t us) {
+  samples->count++;
+  samples->sum_us += us;
+  if (us > samples->max_us) {
+    samples->max_us = us;
+  }
+}
+
+// Lateness of blink number `blink_count` against start + n * period
+static void recordBlink() {
+  blink_count++;
+  uint32_t ideal = blink_start_us + blink_count * blink_period_ms * 1000;
+  int32_t late = (int32_t)(micros() - ideal);
+  record(&blink_samples, (late > 0) ? late : 0);
+}
+
+static void stampDone() {
+  if (stamp_samples.count == num_stamps) {
+    phase_done = true;
+    xTaskNotifyGive(bench_handle);
+  }
+}
+
+// Start right after a tick, so the micros() grid and the tick grid line up
+static void startBlinkGrid() {
+  vTaskDelay(1);
+  blink_start_us = micros();
+  blink_count = 0;
+}
+
+static void printSamples(const char *label, const Samples *samples) {
+  Serial.printf("  %-16s avg %6u us   max %6u us\n",
+                label,
+                (unsigned)(samples->count ? samples->sum_us / samples->count : 0),
+                (unsigned)samples->max_us);
+}
+
+static void printFootprint(const Footprint *ram) {
+  Serial.printf("  %u task(s): stacks %u B (%u B used), TCBs %u B, queues %u B, "
+                "tables %u B, total %u B\n",
+                (unsigned)ram->tasks,
+                (unsigned)ram->stack_bytes,
+                (unsigned)ram->stack_used,
+                (unsigned)ram->tcb_bytes,
+                (unsigned)ram->queue_bytes,
+                (unsigned)ram->table_bytes,
+                (unsigned)(ram->stack_bytes + ram->tcb_bytes + ram->queue_bytes +
+                           ram->table_bytes));
+}
+
+//*****************************************************************************
+// Two-task design
+
+void consumer(void *parameters) {
+  uint32_t stamp;
+
+  while (!phase_done) {
+    if (xQueueReceive(stamp_queue, &stamp, portMAX_DELAY) == pdTRUE) {
+      record(&stamp_samples, micros() - stamp);
+      stampDone();
+    }
+  }
+
+  phase_stack_used += stack_size - uxTaskGetStackHighWaterMark(NULL);
+  vTaskDelete(NULL);
+}
+
+void blinker(void *parameters) {
+  startBlinkGrid();
+  TickType_t last_wake = xTaskGetTickCount();
+
+  while (!phase_done) {
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(blink_period_ms));
+    recordBlink();
+  }
+
+  phase_stack_used += stack_size - uxTaskGetStackHighWaterMark(NULL);
+  vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Reactor design
+
+static void onStamp(void *arg) {
+  if (!phase_done) {
+    record(&stamp_samples, micros() - (uint32_t)(uintptr_t)arg);
+    stampDone();
+  }
+}
+
+static void onBlink(void *arg) {
+  if (phase_done) {
+    phase_stack_used = stack_size - uxTaskGetStackHighWaterMark(NULL);
+    reactor.cancelTimer(blink_timer);
+    xTaskNotifyGive(bench_handle);
+    return;
+  }
+  recordBlink();
+}
+
+void runReactor(void *parameters) {
+  startBlinkGrid();
+  TickType_t period = pdMS_TO_TICKS(blink_period_ms);
+  blink_timer = reactor.addTimer(period, period, onBlink, NULL);
+
+  reactor.run();
+}
+
+//*****************************************************************************
+// Producer and benchmark
+
+void producer(void *parameters) {
+  TickType_t last_wake = xTaskGetTickCount();
+
+  while (1) {
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(stamp_period_ms));
+    if (phase_done) {
+      continue;
+    }
+
+    uint32_t stamp = micros();
+    if (use_reactor) {
+      reactor.post(onStamp, (void *)(uintptr_t)stamp);
+    } else {
+      xQueueSend(stamp_queue, &stamp, 0);
+    }
+  }
+}
+
+static void resetPhase() {
+  memset(&stamp_samples, 0, sizeof(stamp_samples));
+  memset(&blink_samples, 0, sizeof(blink_samples));
+  phase_stack_used = 0;
+  phase_done = false;
+}
+
+void runBench(void *parameters) {
+  Footprint tasks_ram = {};
+  Footprint reactor_ram = {};
+
+  // Two tasks: wait for the samples, then a few periods for both tasks to exit
+  resetPhase();
+  use_reactor = false;
+  consumer_task.createPinnedToCore(consumer, "Consumer", NULL, 1, app_cpu);
+  blink_task.createPinnedToCore(blinker, "Blink", NULL, 1, app_cpu);
+  ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+  vTaskDelay(pdMS_TO_TICKS(4 * blink_period_ms));
+
+  Serial.println("tasks (queue + vTaskDelayUntil)");
+  printSamples("event latency", &stamp_samples);
+  printSamples("blink late", &blink_samples);
+  tasks_ram.tasks = 2;
+  tasks_ram.stack_bytes = 2 * stack_size;
+  tasks_ram.stack_used = phase_stack_used;
+  tasks_ram.tcb_bytes = 2 * sizeof(StaticTask_t);
+  tasks_ram.queue_bytes = sizeof(StaticQueue_t) + stamp_queue_len * sizeof(uint32_t);
+  printFootprint(&tasks_ram);
+
+  // Reactor: the blink callback reports its stack once the samples are in
+  resetPhase();
+  reactor_task.createPinnedToCore(runReactor, "Reactor", NULL, 1, app_cpu);
+  use_reactor = true;
+  ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+  ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+  Serial.println("reactor (post + periodic timer)");
+  printSamples("event latency", &stamp_samples);
+  printSamples("blink late", &blink_samples);
+  reactor_ram.tasks = 1;
+  reactor_ram.stack_bytes = stack_size;
+  reactor_ram.stack_used = phase_stack_used;
+  reactor_ram.tcb_bytes = sizeof(StaticTask_t);
+  reactor_ram.queue_bytes = sizeof(StaticQueue_t) + stamp_queue_len * 2 * sizeof(void *);
+  reactor_ram.table_bytes = sizeof(reactor) -
+                            (USE_STATIC_ALLOCATION ? reactor_ram.queue_bytes : 0);
+  printFootprint(&reactor_ram);
+
+  Serial.println("Done");
+  vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---Event loop benchmark---");
+  Serial.printf("%d events every %u ms, blink every %u ms\n",
+                num_stamps, (unsigned)stamp_period_ms, (unsigned)blink_period_ms);
+
+  stamp_queue = stamp_queue_storage.create();
+  reactor.begin();
+
+  bench_handle = bench_task.createPinnedToCore(runBench, "Bench", NULL, 1, app_cpu);
+  producer_task.createPinnedToCore(producer, "Producer", NULL, producer_priority, app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
@@ -0,0 +1,220 @@
+/*
+  Queue challenge with coroutines on one task
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  The same behaviour as main.cpp, but the CLI, the message printer and the blink loop are
+  C++20 coroutines (lib/CoExecutor) that share one FreeRTOS task instead of having a task
+  and a stack each. They talk through CoQueues, which are plain ring buffers inside the
+  executor task, not kernel objects.
+
+  Type "delay xxx" to change the blink delay and "stats" to see what the coroutines cost:
+  the executor's frame size and live frames, and the stack high-water mark of the one
+  task they run on.
+
+  Needs a C++20 compiler, build it with the esp32doit-devkit-v1-coroutines environment.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <CoExecutor.h>
+
+using namespace std::chrono_literals;
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const uint8_t buf_len = 255;     // Size of buffer to look for command
+static const char command[] = "delay "; // Note that space!
+static const int delay_queue_len = 5;   // Size of delay_queue
+static const int msg_queue_len = 5;     // Size of msg_queue
+static const uint8_t blink_max = 100;   // Num times to blink before message
+
+// Pins (change this if your Arduino board does not have LED_BUILTIN defined)
+static const int led_pin = LED_BUILTIN;
+
+// Message struct: used to wrap strings
+typedef struct Message {
+  char body[20];
+  int count;
+} Message;
+
+// Globals
+static StaticCoExecutor<192, 4> executor;   // Frames of 192 bytes, 3 coroutines + 1 spare
+static CoQueue<int, delay_queue_len> delay_queue;
+static CoQueue<Message, msg_queue_len> msg_queue;
+static TaskHandle_t coroutine_task_handle = NULL;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<3072> coroutine_task;
+
+//*****************************************************************************
+// Helpers
+
+static bool serialHasData(void *arg) {
+  return Serial.available() > 0;
+}
+
+static void printStats() {
+  CoExecutorStats stats;
+  executor.getStats(&stats);
+
+  Serial.printf("Coroutines: %u live (max %u), frames %u B (largest request %u B), "
+                "%u failed spawns\n",
+                (unsigned)stats.live_coroutines,
+                (unsigned)stats.max_live_coroutines,
+                (unsigned)stats.frame_size,
+                (unsigned)stats.max_frame_request,
+                (unsigned)stats.failed_spawns);
+  Serial.printf("Executor task: %u B stack, %u B never used, %u wake-ups, %u resumes\n",
+                (unsigned)coroutine_task.stackDepth(),
+                (unsigned)uxTaskGetStackHighWaterMark(coroutine_task_handle),
+                (unsigned)stats.wake_count,
+                (unsigned)stats.resume_count);
+}
+
+//*****************************************************************************
+// Coroutines
+
+// Command line interface: echo input, send "delay xxx" to the blink coroutine
+CoTask doCLI() {
+  static char buf[buf_len];   // Static, so the 255 bytes are not part of the frame
+  uint8_t idx = 0;
+  uint8_t cmd_len = strlen(command);
+
+  memset(buf, 0, buf_len);
+
+  while (1) {
+    co_await coUntil(serialHasData);
+    char c = Serial.read();
+
+    // Store received character to buffer if not over buffer limit
+    if (idx < buf_len - 1) {
+      buf[idx] = c;
+      idx++;
+    }
+
+    // Print newline and check input on 'enter'
+    if ((c == '\n') || (c == '\r')) {
+      Serial.print("\r\n");
+
+      if (memcmp(buf, command, cmd_len) == 0) {
+
+        // Convert last part to positive integer (negative int crashes)
+        int led_delay = abs(atoi(buf + cmd_len));
+        if (!delay_queue.trySend(led_delay)) {
+          Serial.println("ERRORL Could not put item on delay queue.");
+        }
+      } else if (strncmp(buf, "stats", 5) == 0) {
+        printStats();
+      }
+
+      // Reset receive buffer and index counter
+      memset(buf, 0, buf_len);
+      idx = 0;
+
+    // Otherwise, echo character back to serial terminal
+    } else {
+      Serial.print(c);
+    }
+  }
+}
+
+// Print every message from the blink coroutine
+CoTask printMessages() {
+  while (1) {
+    Message msg = co_await msg_queue.receive();
+    Serial.println(msg.body);
+    Serial.println(msg.count);
+  }
+}
+
+// Flash LED based on delay provided, report every 100 blinks
+CoTask blinkLED() {
+  Message msg;
+  int led_delay = 500;
+  uint8_t counter = 0;
+
+  pinMode(led_pin, OUTPUT);
+
+  while (1) {
+
+    // See if there's a new delay (do not wait)
+    if (delay_queue.tryReceive(&led_delay)) {
+      strcpy(msg.body, "Message received ");
+      msg.count = 1;
+      msg_queue.trySend(msg);
+    }
+
+    // Blink
+    digitalWrite(led_pin, HIGH);
+    co_await coDelay(msToTicksCeil(led_delay));
+    digitalWrite(led_pin, LOW);
+    co_await coDelay(msToTicksCeil(led_delay));
+
+    // If we've blinked 100 times, send a message to the printer
+    counter++;
+    if (counter >= blink_max) {
+      strcpy(msg.body, "Blinked: ");
+      msg.count = counter;
+      co_await msg_queue.send(msg);
+      counter = 0;
+    }
+  }
+}
+
+//*****************************************************************************
+// Tasks
+
+// Task: runs all coroutines
+void runCoroutines(void *parameters) {
+  executor.spawn(doCLI());
+  executor.spawn(printMessages());
+  executor.spawn(blinkLED());
+
+  // Let the CLI report if a frame didn't fit
+  CoExecutorStats stats;
+  executor.getStats(&stats);
+  if (stats.failed_spawns > 0) {
+    Serial.println("ERROR: coroutine frame too large for the executor");
+    printStats();
+  }
+
+  executor.run();
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Queue Solution (coroutines)---");
+  Serial.println("Enter the command 'delay xxx' where xxx is your desired ");
+  Serial.println("LED blink delay time in milliseconds, or 'stats'");
+
+  coroutine_task_handle = coroutine_task.createPinnedToCore(runCoroutines,
+                                                            "Coroutines",
+                                                            NULL,
+                                                            1,
+                                                            app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
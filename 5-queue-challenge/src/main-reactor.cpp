@@ -0,0 +1,170 @@
+/*
+  Queue challenge on one event loop
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  The same behaviour as main.cpp, but the CLI and the blink loop are callbacks of one
+  reactor task (lib/Reactor) instead of two tasks with two queues between them. The CLI
+  callback changes the blink timer directly and the blink callback prints its own
+  messages, so nothing is copied through a queue. A new delay applies right away instead
+  of after the current blink.
+
+  Type "delay xxx" to change the blink delay and "stats" to see the loop statistics and
+  the stack use of the single task; compare with main-bench-reactor.cpp for numbers
+  against the two-task version.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <PreciseDelay.h>
+#include <Reactor.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const uint8_t buf_len = 255;     // Size of buffer to look for command
+static const char command[] = "delay "; // Note that space!
+static const uint8_t blink_max = 100;   // Num times to blink before message
+
+// Pins (change this if your Arduino board does not have LED_BUILTIN defined)
+static const int led_pin = LED_BUILTIN;
+
+// Globals (only used from the reactor task)
+static StaticReactor<1, 1, 4> reactor;    // 1 timer, 1 watch, 4 posted callbacks
+static Reactor::TimerId blink_timer = -1;
+static char buf[buf_len];
+static uint8_t idx = 0;
+static uint8_t counter = 0;
+static TaskHandle_t reactor_task_handle = NULL;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<2048> reactor_task;
+
+//******************************************************************************
+// Callbacks (all run on the reactor task)
+
+static void printStats() {
+  ReactorStats stats;
+  reactor.getStats(&stats);
+
+  Serial.printf("Reactor: %u passes, %u wake-ups, %u timer fires, %u serial fires, "
+                "timer late by up to %u ticks, longest callback %u us\n",
+                (unsigned)stats.passes,
+                (unsigned)stats.wakeups,
+                (unsigned)stats.timer_fires,
+                (unsigned)stats.watch_fires,
+                (unsigned)stats.max_timer_late_ticks,
+                (unsigned)stats.max_callback_us);
+  Serial.printf("Reactor task: %u B stack, %u B never used\n",
+                (unsigned)reactor_task.stackDepth(),
+                (unsigned)uxTaskGetStackHighWaterMark(reactor_task_handle));
+}
+
+// Toggle the LED, report every 100 blinks (on, off)
+static void blinkLED(void *arg) {
+  bool on = !digitalRead(led_pin);
+  digitalWrite(led_pin, on);
+
+  if (!on) {
+    counter++;
+    if (counter >= blink_max) {
+      Serial.println("Blinked: ");
+      Serial.println(counter);
+      counter = 0;
+    }
+  }
+}
+
+// Command line interface: echo input, apply "delay xxx"
+static void doCLI(void *arg) {
+  uint8_t cmd_len = strlen(command);
+
+  while (Serial.available() > 0) {
+    char c = Serial.read();
+
+    // Store received character to buffer if not over buffer limit
+    if (idx < buf_len - 1) {
+      buf[idx] = c;
+      idx++;
+    }
+
+    // Print newline and check input on 'enter'
+    if ((c == '\n') || (c == '\r')) {
+      Serial.print("\r\n");
+
+      if (memcmp(buf, command, cmd_len) == 0) {
+
+        // Convert last part to positive integer (negative int crashes)
+        int led_delay = abs(atoi(buf + cmd_len));
+        TickType_t period = msToTicksCeil(led_delay);
+
+        // A period of 0 would make the timer one-shot and stop the LED, keep it toggling
+        if (period == 0) {
+          period = 1;
+        }
+        reactor.setTimer(blink_timer, period, period);
+        Serial.println("Message received ");
+        Serial.println(1);
+      } else if (strncmp(buf, "stats", 5) == 0) {
+        printStats();
+      }
+
+      // Reset receive buffer and index counter
+      memset(buf, 0, buf_len);
+      idx = 0;
+
+    // Otherwise, echo character back to serial terminal
+    } else {
+      Serial.print(c);
+    }
+  }
+}
+
+//******************************************************************************
+// Tasks
+
+void runReactor(void *parameters) {
+  reactor.begin();
+
+  pinMode(led_pin, OUTPUT);
+  TickType_t period = msToTicksCeil(500);
+  blink_timer = reactor.addTimer(period, period, blinkLED, NULL);
+  reactor.watchStream(Serial, doCLI, NULL);
+
+  reactor.run();
+}
+
+//******************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Queue Solution (event loop)---");
+  Serial.println("Enter the command 'delay xxx' where xxx is your desired ");
+  Serial.println("LED blink delay time in milliseconds, or 'stats'");
+
+  reactor_task_handle = reactor_task.createPinnedToCore(runReactor,
+                                                        "Reactor",
+                                                        NULL,
+                                                        1,
+                                                        app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
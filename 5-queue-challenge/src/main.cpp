@@ -4,6 +4,23 @@
    
   Efraim Manurung, 4th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : The LED blinks on absolute release times (lib/PeriodicTask). Overruns are
+                reported to the CLI task together with the "Blinked" message.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.3 : led_delay is converted to ticks rounding up (lib/PreciseDelay), a delay
+                below one tick no longer becomes 0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.4 : New "status" command. The blink task publishes its delay, blink count and
+                overruns as a Snapshot (lib/SeqLock) after every blink, and the CLI task
+                prints a consistent copy without a lock or another queue.
   
   Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-5-freertos-queue-example/72d2b361f7b94e0691d947c7c29a03c9
 
@@ -42,6 +59,10 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
+#include <PeriodicTask.h>
+#include <PreciseDelay.h>
+#include <SeqLock.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -53,6 +74,7 @@
 // Settings
 static const uint8_t buf_len = 255;     // Size of buffer to look for command
 static const char command[] = "delay "; // Note that space!
+static const char status_command[] = "status";
 static const int delay_queue_len = 5;   // Size of delay_queue
 static const int msg_queue_len = 5;     // Size of msg_queue
 static const uint8_t blink_max = 100;   // Num times to blink before message
@@ -73,12 +95,29 @@ typedef struct Message {
   int count;
 } Message;
 
+// State of the blink task for the "status" command (several fields, read together)
+typedef struct BlinkStatus {
+  int led_delay;
+  uint32_t blinks;
+  uint32_t overruns;
+} BlinkStatus;
+
 // Globals
 /*
 Two separate queues, so we create those as global variables
 */
 static QueueHandle_t delay_queue;
 static QueueHandle_t msg_queue;
+static PeriodicTask blink_period;   // Release times of blinkLED()
+static Snapshot<BlinkStatus> blink_status;  // Written by blinkLED() only
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> cli_task;
+static TaskStorage<1024> blink_led_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static QueueStorage<int, delay_queue_len> delay_queue_storage;
+static QueueStorage<Message, msg_queue_len> msg_queue_storage;
 
 //******************************************************************************
 // Tasks
@@ -163,6 +202,16 @@ void doCLI(void *parameters) {
           if (xQueueSend(delay_queue, (void *)&led_delay, 10) != pdTRUE) {
             Serial.println("ERRORL Could not put item on delay queue.");
           }
+
+        // Print the latest state of the blink task, never waits for it
+        } else if (memcmp(buf, status_command, strlen(status_command)) == 0) {
+          BlinkStatus status = blink_status.read();
+          Serial.print("Delay: ");
+          Serial.print(status.led_delay);
+          Serial.print(" ms, blinks: ");
+          Serial.print(status.blinks);
+          Serial.print(", overruns: ");
+          Serial.println(status.overruns);
         }
 
         // Reset receive buffer and index counter
@@ -189,10 +238,17 @@ void blinkLED(void *parameters) {
   Message msg;
   int led_delay = 500;
   uint8_t counter = 0;
+  PeriodicStats stats;
+  uint32_t reported_overruns = 0;
+  BlinkStatus status = {led_delay, 0, 0};
 
   // Set up pin
   pinMode(LED_BUILTIN, OUTPUT);
 
+  // One release per LED edge
+  blink_period.begin(msToTicksCeil(led_delay));
+  blink_status.publish(status);
+
   // Loop forever
   while (1) {
 
@@ -209,13 +265,23 @@ void blinkLED(void *parameters) {
       strcpy(msg.body, "Message received ");
       msg.count = 1;
       xQueueSend(msg_queue, (void *)&msg, 10);
+
+      // New period from the next release on
+      blink_period.setPeriod(msToTicksCeil(led_delay));
     }
 
     // Blink
     digitalWrite(led_pin, HIGH);
-    vTaskDelay(led_delay / portTICK_PERIOD_MS);
+    blink_period.wait();
     digitalWrite(led_pin, LOW);
-    vTaskDelay(led_delay / portTICK_PERIOD_MS);
+    blink_period.wait();
+
+    // Publish the state for the "status" command
+    blink_period.getStats(&stats);
+    status.led_delay = led_delay;
+    status.blinks++;
+    status.overruns = stats.overruns;
+    blink_status.publish(status);
 
     /*
     If something is in the queue, we read it, and it updates the led_delay variable. Note that if nothing is in
@@ -240,6 +306,14 @@ void blinkLED(void *parameters) {
 
       // Reser counter
       counter = 0;
+
+      // Also report if the blink missed release times since the last report
+      if (stats.overruns != reported_overruns) {
+        strcpy(msg.body, "Overruns: ");
+        msg.count = stats.overruns;
+        xQueueSend(msg_queue, (void *)&msg, 10);
+        reported_overruns = stats.overruns;
+      }
     }
   }
 }
@@ -269,28 +343,25 @@ void setup() {
   Serial.println("---FreeRTOS Queue Solution---");
   Serial.println("Enter the command 'delay xxx' where xxx is your desired ");
   Serial.println("LED blink delay time in milliseconds");
+  Serial.println("Enter 'status' for the current delay, blinks and overruns");
 
   // Create queues
-  delay_queue = xQueueCreate(delay_queue_len, sizeof(int));
-  msg_queue = xQueueCreate(msg_queue_len, sizeof(Message));
+  delay_queue = delay_queue_storage.create();
+  msg_queue = msg_queue_storage.create();
 
   // Start CLI task
-  xTaskCreatePinnedToCore(doCLI,
-                          "CLI",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  cli_task.createPinnedToCore(doCLI,
+                              "CLI",
+                              NULL,
+                              1,
+                              app_cpu);
 
   // Start blink task
-  xTaskCreatePinnedToCore(blinkLED,
-                          "Blink LED",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  blink_led_task.createPinnedToCore(blinkLED,
+                                    "Blink LED",
+                                    NULL,
+                                    1,
+                                    app_cpu);
 
   // Delete "setup and loop" task
   vTaskDelete(NULL);
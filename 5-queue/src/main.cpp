@@ -4,6 +4,10 @@
    
   Efraim Manurung, 4th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
   
   Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-5-freertos-queue-example/72d2b361f7b94e0691d947c7c29a03c9
 
@@ -30,6 +34,7 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -44,6 +49,12 @@ static const uint8_t msg_queue_len = 5;
 // Globals
 static QueueHandle_t msg_queue;
 
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> print_messages_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static QueueStorage<int, msg_queue_len> msg_queue_storage;
+
 //************************************************************
 // Tasks
 
@@ -78,16 +89,14 @@ void setup() {
   Serial.println("---FreeRTOS Queue Demo---");
 
   // Create queue
-  msg_queue = xQueueCreate(msg_queue_len, sizeof(int));
+  msg_queue = msg_queue_storage.create();
 
   // Start print task
-  xTaskCreatePinnedToCore(printMessages,
-                          "Print Messages",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  print_messages_task.createPinnedToCore(printMessages,
+                                         "Print Messages",
+                                         NULL,
+                                         1,
+                                         app_cpu);
 }
 
 void loop() {
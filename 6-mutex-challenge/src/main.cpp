@@ -4,6 +4,20 @@
    
   Efraim Manurung, 6th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : The task only reads the parameter and hands the blinking over to a
+                software-timer pattern (lib/LedPattern), then deletes itself, so no stack
+                stays reserved for toggling the LED.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.3 : delay_arg is passed to the task by value (lib/TaskSpawn), setup() no longer
+                waits on the mutex until the task has copied it. The task also no longer reads
+                the long through an int pointer.
   
   Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-6-freertos-mutex-example/c6e3581aa2204f1380e83a9b4c3807a6
 
@@ -50,6 +64,9 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
+#include <LedPattern.h>
+#include <TaskSpawn.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -61,37 +78,27 @@
 // Pins
 static const int led_pin = LED_BUILTIN;
 
-// Globals
-// The first is to create a global mutex handle at the top.
-static SemaphoreHandle_t mutex;
+// Task storage with room for its argument (stack size in bytes, static in
+// USE_STATIC_ALLOCATION builds)
+static TaskSpawn<long, 1024> blink_led_task;
+
+// Blink pattern (a software timer, static in USE_STATIC_ALLOCATION builds)
+static LedPattern blink_led;
 
 //*************************************************************************************************
 // Tasks
 
-// Blink LED based on rate passed by parameter
-void blinkLED(void *parameters) {
-
-  // Copy the parameters into a local variable
-  int num = *(int *)parameters;
-
-  // Release the mutex so that the creating function can finish
-  // In this task function, we "give" the mutex back just after copying in the value from the parameters pointer.
-  xSemaphoreGive(mutex);
+// Blink LED based on rate passed by value (num is the task's own copy)
+void blinkLED(long &num) {
 
   // Print the parameter
   Serial.print("Received: ");
   Serial.println(num);
 
-  // Configure the LED pin
-  pinMode(led_pin, OUTPUT);
+  // Blink forever and ever (the timer service task does the toggling from now on)
+  blink_led.begin(led_pin, num, num);
 
-  // Blink forever and ever
-  while (1) {
-    digitalWrite(led_pin, HIGH);
-    vTaskDelay(num / portTICK_PERIOD_MS);
-    digitalWrite(led_pin, LOW);
-    vTaskDelay(num / portTICK_PERIOD_MS);
-  }
+  // Nothing left to do for this task (TaskSpawn deletes it on return)
 }
 
 //*************************************************************************************************
@@ -117,28 +124,13 @@ void setup() {
   delay_arg = Serial.parseInt();
   Serial.print("Sending: ");
   Serial.println(delay_arg);
-  
-  // Because a mutex will initialize at 1, it means we need to "take" the mutex in our setup code,
-  // which we do just after creating it (before we start the task).
-  // Create mutex before starting tasks
-  mutex = xSemaphoreCreateMutex();
-
-  // Take the mutex
-  xSemaphoreTake(mutex, portMAX_DELAY);
-
-  // Start task 1
-  xTaskCreatePinnedToCore(blinkLED,
-                          "Blink LED",
-                          1024,
-                          (void *)&delay_arg,
-                          1,
-                          NULL,
-                          app_cpu);
-
-  // After we start the task, we block the "setup and loop" task until the mutex is given back (which is done in the task).
-  // We do this by trying to "take" the mutex and delaying (blocking) for the maximum amount of time.
-  // Do nothing until mutex has been returned (maximum delay)
-  xSemaphoreTake(mutex, portMAX_DELAY);
+
+  // Start task 1, it gets its own copy of delay_arg so there is nothing to wait for
+  blink_led_task.createPinnedToCore(blinkLED,
+                                    "Blink LED",
+                                    delay_arg,
+                                    1,
+                                    app_cpu);
 
   // Show that we accomplished our task of passing the stack-based argument
   Serial.println("Done!");
@@ -4,6 +4,10 @@
    
   Efraim Manurung, 6th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
   
   Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-6-freertos-mutex-example/c6e3581aa2204f1380e83a9b4c3807a6
 
@@ -39,6 +43,7 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -51,6 +56,13 @@
 static int shared_var = 0;
 static SemaphoreHandle_t mutex;
 
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> inc_task_1;
+static TaskStorage<1024> inc_task_2;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static MutexStorage mutex_storage;
+
 //******************************************************************************
 // Tasks
 
@@ -101,25 +113,21 @@ void setup() {
   Serial.println("---FreeRTOS Race Condition Demo---");
 
   // Create mutex before starting tasks
-  mutex = xSemaphoreCreateMutex();
+  mutex = mutex_storage.create();
 
   // Start task 1
-  xTaskCreatePinnedToCore(incTask,
-                          "Increment Task 1",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  inc_task_1.createPinnedToCore(incTask,
+                                "Increment Task 1",
+                                NULL,
+                                1,
+                                app_cpu);
   
   // Start task 2
-  xTaskCreatePinnedToCore(incTask,
-                          "Increment Task 2",
-                          1024,
-                          NULL,
-                          1,
-                          NULL,
-                          app_cpu);
+  inc_task_2.createPinnedToCore(incTask,
+                                "Increment Task 2",
+                                NULL,
+                                1,
+                                app_cpu);
   
   // Delete "setup and loop" task
   vTaskDelete(NULL);
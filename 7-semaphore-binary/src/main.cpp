@@ -4,6 +4,23 @@
    
   Efraim Manurung, 8th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : The task only reads the parameter and hands the blinking over to a
+                software-timer pattern (lib/LedPattern), then deletes itself, so no stack
+                stays reserved for toggling the LED.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.3 : The "parameter copied" hand-off is a task notification (lib/NotifySignal)
+                instead of a binary semaphore, there is no kernel object to create.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.4 : delay_arg is passed to the task by value (lib/TaskSpawn), so there is no
+                hand-off left to wait for and setup() finishes right away.
   
   Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-7-freertos-semaphore-example/51aa8660524c4daba38cba7c2f5baba7
   
@@ -56,6 +73,9 @@
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
+#include <LedPattern.h>
+#include <TaskSpawn.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -67,35 +87,27 @@
 // Pins
 static const int led_pin = LED_BUILTIN;
 
-// Globals
-static SemaphoreHandle_t bin_sem;
+// Task storage with room for its argument (stack size in bytes, static in
+// USE_STATIC_ALLOCATION builds)
+static TaskSpawn<long, 1024> blink_led_task;
+
+// Blink pattern (a software timer, static in USE_STATIC_ALLOCATION builds)
+static LedPattern blink_led;
 
 //*************************************************************************************************
 // Tasks
 
-// Blink LED based on rate passed by parameter
-void blinkLED(void *parameters) {
-
-  // Copy the parameters into a local variable
-  int num = *(int *)parameters;
-
-  // Release the binary semaphore so that the creating function can finish
-  xSemaphoreGive(bin_sem);
+// Blink LED based on rate passed by value (num is the task's own copy)
+void blinkLED(long &num) {
 
   // Print the parameter
   Serial.print("Received: ");
   Serial.println(num);
 
-  // Configure the LED pin
-  pinMode(led_pin, OUTPUT);
+  // Blink forever and ever (the timer service task does the toggling from now on)
+  blink_led.begin(led_pin, num, num);
 
-  // Blink forever and ever
-  while (1) {
-    digitalWrite(led_pin, HIGH);
-    vTaskDelay(num / portTICK_PERIOD_MS);
-    digitalWrite(led_pin, LOW);
-    vTaskDelay(num / portTICK_PERIOD_MS);
-  }
+  // Nothing left to do for this task (TaskSpawn deletes it on return)
 }
 
 //*************************************************************************************************
@@ -121,21 +133,13 @@ void setup() {
   delay_arg = Serial.parseInt();
   Serial.print("Sending: ");
   Serial.println(delay_arg);
-  
-  // Create binary sempahore before starting tasks
-  bin_sem = xSemaphoreCreateBinary();
-
-  // Start task 1
-  xTaskCreatePinnedToCore(blinkLED,
-                          "Blink LED",
-                          1024,
-                          (void *)&delay_arg,
-                          1,
-                          NULL,
-                          app_cpu);
-
-  // Do nothing until binary semaphore has been returned
-  xSemaphoreTake(bin_sem, portMAX_DELAY);
+
+  // Start task 1, it gets its own copy of delay_arg so there is nothing to wait for
+  blink_led_task.createPinnedToCore(blinkLED,
+                                    "Blink LED",
+                                    delay_arg,
+                                    1,
+                                    app_cpu);
 
   // Show that we accomplished our task of passing the stack-based argument
   Serial.println("Done!");
@@ -0,0 +1,158 @@
+/*
+  Introduction to RTOS Part 7 - Semaphore by Shawn Hymel, started as one batch
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  The lecture demo starts num_tasks tasks with the same parameter one after another and
+  takes a counting semaphore num_tasks times to learn that they have all read it. Here
+  the same tasks are started twice:
+
+  - "handshake" : create a task, wait for its semaphore give, create the next one
+  - "batch"     : TaskBatch (lib/StartBarrier) creates all of them, holds them at an
+                  event-group barrier and releases them together
+
+  For both, setup() prints how long it took until every task was running and how far
+  apart the tasks started their work (first to last).
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <StartBarrier.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_tasks = 5;
+
+// Example struct for passing a string as parameter
+typedef struct Message {
+  char body[20];
+  uint8_t len;
+} Message;
+
+// Globals
+static SemaphoreHandle_t sem_params;        // Counts up when a parameter has been read
+static int64_t start_us[num_tasks];         // When each task started its work
+static volatile uint8_t num_done = 0;
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> handshake_tasks[num_tasks];
+static TaskBatch<Message, num_tasks, 1024> batch_tasks;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static CountingSemaphoreStorage sem_params_storage;
+
+//*****************************************************************************
+// Tasks
+
+// Print out the message, the same for both ways of starting
+static void printMessage(const Message &msg, uint8_t index) {
+  start_us[index] = esp_timer_get_time();
+
+  Serial.print("Received: ");
+  Serial.print(msg.body);
+  Serial.print(" | len: ");
+  Serial.println(msg.len);
+
+  portENTER_CRITICAL(&spinlock);
+  num_done++;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+// Task: copy the parameter, hand the semaphore back, then do the work
+void handshakeTask(void *parameters) {
+  Message msg = *(Message *)parameters;
+  uint8_t index = (uint8_t)(msg.body[0] - '0');
+
+  xSemaphoreGive(sem_params);
+  printMessage(msg, index);
+  vTaskDelete(NULL);
+}
+
+// Task code of the batch, starts once every task exists
+void batchTask(const Message &msg, uint8_t index) {
+  printMessage(msg, index);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+static void printTiming(const char *name, int64_t started_us, int64_t running_us) {
+  int64_t first = start_us[0];
+  int64_t last = start_us[0];
+
+  // Wait until everybody has printed
+  while (num_done < num_tasks) {
+    vTaskDelay(10 / portTICK_PERIOD_MS);
+  }
+
+  for (int i = 1; i < num_tasks; i++) {
+    if (start_us[i] < first) {
+      first = start_us[i];
+    }
+    if (start_us[i] > last) {
+      last = start_us[i];
+    }
+  }
+
+  Serial.print(name);
+  Serial.print("\tall running after (us): ");
+  Serial.print((int32_t)(running_us - started_us));
+  Serial.print("\tstart spread (us): ");
+  Serial.println((int32_t)(last - first));
+}
+
+void setup() {
+
+  Message msg;
+  int64_t started_us;
+  int64_t running_us;
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Batch Start Demo---");
+
+  sem_params = sem_params_storage.create(num_tasks, 0);
+
+  // One at a time, each task reads its index from the first character
+  num_done = 0;
+  started_us = esp_timer_get_time();
+  for (int i = 0; i < num_tasks; i++) {
+    snprintf(msg.body, sizeof(msg.body), "%d: handshake", i);
+    msg.len = strlen(msg.body);
+    handshake_tasks[i].createPinnedToCore(handshakeTask,
+                                          "Handshake",
+                                          (void *)&msg,
+                                          1,
+                                          app_cpu);
+    xSemaphoreTake(sem_params, portMAX_DELAY);
+  }
+  running_us = esp_timer_get_time();
+  printTiming("handshake", started_us, running_us);
+
+  // All at once
+  strcpy(msg.body, "All your base batch");
+  msg.len = strlen(msg.body);
+  num_done = 0;
+  started_us = esp_timer_get_time();
+  batch_tasks.createPinnedToCore(batchTask, "Batch", msg, 1, app_cpu, portMAX_DELAY);
+  running_us = esp_timer_get_time();
+  printTiming("batch", started_us, running_us);
+}
+
+void loop() {
+
+  // Do nothing but allow yielding to lower-priority tasks
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+}
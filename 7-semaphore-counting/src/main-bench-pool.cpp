@@ -0,0 +1,180 @@
+/*
+   Worker pool benchmark: fixed workers versus a new task per job
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Runs the same small job num_jobs times in two ways and prints jobs per second:
+
+   - "spawn" : xTaskCreatePinnedToCore() per job, the job signals and the benchmark task
+               deletes it (the pattern of main.cpp version 1.1)
+   - "pool"  : submit() to a StaticWorkerPool and wait for the completion notification
+
+   Each is measured with one job in flight at a time (round trip) and in batches of
+   batch_len jobs. The spawned tasks are deleted by the benchmark task instead of deleting
+   themselves, so their stack and TCB are freed right away rather than whenever the idle
+   task gets to run; otherwise the heap would run out before the loop ends.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <WorkerPool.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+  static const BaseType_t app_cpu = 0;
+#else
+  static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_jobs = 1000;
+static const int batch_len = 8;
+static const int num_workers = 2;
+static const uint32_t job_stack_size = 2048;
+static const UBaseType_t job_priority = 1;
+static const UBaseType_t bench_priority = 2;  // Above the jobs, so it isn't preempted
+
+// Globals
+static TaskHandle_t bench_handle = NULL;
+static volatile uint32_t job_result = 0;
+
+// Workers and job queue, static in USE_STATIC_ALLOCATION builds
+static StaticWorkerPool<num_workers, job_stack_size, batch_len> pool;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<4096> bench_task;
+
+//*****************************************************************************
+// Job
+
+// Something small, the benchmark is about the overhead around it
+static void doWork() {
+  uint32_t sum = 0;
+  for (int i = 0; i < 100; i++) {
+    sum += i;
+  }
+  job_result = sum;
+}
+
+static void poolJob(void *parameter) {
+  doWork();
+}
+
+// Task: one job, then wait to be deleted by the benchmark task
+static void spawnedJob(void *parameter) {
+  doWork();
+  xTaskNotifyGive(bench_handle);
+  vTaskDelay(portMAX_DELAY);
+}
+
+//*****************************************************************************
+// Benchmarks (return elapsed microseconds for num_jobs jobs)
+
+static int64_t runSpawn(int in_flight) {
+  TaskHandle_t handles[batch_len];
+  int64_t start = esp_timer_get_time();
+
+  for (int done = 0; done < num_jobs; done += in_flight) {
+    for (int i = 0; i < in_flight; i++) {
+      handles[i] = NULL;
+      xTaskCreatePinnedToCore(spawnedJob,
+                              "Job",
+                              job_stack_size,
+                              NULL,
+                              job_priority,
+                              &handles[i],
+                              app_cpu);
+    }
+    WorkerPool::waitDone(in_flight, portMAX_DELAY);
+    for (int i = 0; i < in_flight; i++) {
+      vTaskDelete(handles[i]);
+    }
+  }
+
+  return esp_timer_get_time() - start;
+}
+
+static int64_t runPool(int in_flight) {
+  int64_t start = esp_timer_get_time();
+
+  for (int done = 0; done < num_jobs; done += in_flight) {
+    for (int i = 0; i < in_flight; i++) {
+      pool.submit(poolJob, NULL, bench_handle);
+    }
+    WorkerPool::waitDone(in_flight, portMAX_DELAY);
+  }
+
+  return esp_timer_get_time() - start;
+}
+
+static void printResult(const char *name, int in_flight, int64_t elapsed_us) {
+  Serial.print(name);
+  Serial.print("\tin flight: ");
+  Serial.print(in_flight);
+  Serial.print("\tjobs/s: ");
+  Serial.print((uint32_t)((int64_t)num_jobs * 1000000 / elapsed_us));
+  Serial.print("\tus/job: ");
+  Serial.println((float)elapsed_us / num_jobs);
+}
+
+//*****************************************************************************
+// Tasks
+
+// Task: run both variants once
+void benchTask(void *parameter) {
+  WorkerPoolStats stats;
+
+  bench_handle = xTaskGetCurrentTaskHandle();
+  pool.begin("Worker", job_priority, app_cpu);
+
+  Serial.print("Free heap before (bytes): ");
+  Serial.println(xPortGetFreeHeapSize());
+
+  printResult("spawn", 1, runSpawn(1));
+  printResult("spawn", batch_len, runSpawn(batch_len));
+  printResult("pool", 1, runPool(1));
+  printResult("pool", batch_len, runPool(batch_len));
+
+  Serial.print("Free heap after (bytes): ");
+  Serial.println(xPortGetFreeHeapSize());
+
+  pool.getStats(&stats);
+  Serial.print("Pool jobs: ");
+  Serial.print(stats.done_count);
+  Serial.print(" | max queued: ");
+  Serial.print(stats.max_queued_jobs);
+  Serial.print(" | max busy: ");
+  Serial.println(stats.max_busy_workers);
+
+  Serial.println("Done");
+  vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Worker Pool Benchmark---");
+
+  // Start the benchmark task
+  bench_task.createPinnedToCore(benchTask,
+                                "Bench Task",
+                                NULL,
+                                bench_priority,
+                                app_cpu);
+
+  // Delete "setup and loop" task
+  vTaskDelete(NULL);
+}
+
+void loop() {
+  // Execution should never get here
+}
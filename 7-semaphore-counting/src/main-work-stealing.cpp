@@ -0,0 +1,109 @@
+/*
+   Work-stealing demo: the messages of main.cpp processed on both cores
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   setup() runs on core 1 and submits a burst of num_msgs message jobs, so they all land
+   on the deque of the core 1 worker. The core 0 worker finds its own deque empty, steals
+   half of them and both cores work through the burst (lib/WorkStealing). Every job
+   records the core it ran on; at the end the per-core counts and the runtime statistics
+   are printed.
+*/
+
+#include <Arduino.h>
+#include <WorkStealing.h>
+
+// Settings
+static const int num_msgs = 40;           // Jobs per burst
+static const int work_us = 2000;          // Simulated processing time per message
+
+// Example struct for passing a string as parameter
+typedef struct Message {
+  char body[20];
+  uint8_t len;
+  BaseType_t core;                        // Filled in by the job
+} Message;
+
+// Globals
+static WorkStealingRuntime runtime;
+static JobGroup group;
+static Message msgs[num_msgs];
+
+//*****************************************************************************
+// Jobs
+
+void processMessage(void *parameters) {
+  Message *msg = (Message *)parameters;
+
+  // Pretend to do something with the message
+  int64_t end = esp_timer_get_time() + work_us;
+  while (esp_timer_get_time() < end) {
+  }
+  msg->core = xPortGetCoreID();
+
+  group.done();
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+  char text[20] = "All your base";
+  int per_core[portNUM_PROCESSORS] = {0};
+
+  // Configure Serial
+  Serial.begin(115200);
+
+  // Wait a moment to start (so we don't miss Serial output)
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+  Serial.println();
+  Serial.println("---FreeRTOS Work-Stealing Demo---");
+
+  // One worker per core, same priority as this task
+  runtime.begin(portNUM_PROCESSORS, 1);
+
+  // Submit the whole burst from this core
+  int64_t start = esp_timer_get_time();
+  group.add(num_msgs);
+  for (int i = 0; i < num_msgs; i++) {
+    strcpy(msgs[i].body, text);
+    msgs[i].len = strlen(text);
+    runtime.submit(processMessage, &msgs[i]);
+  }
+  group.wait();
+  int64_t elapsed = esp_timer_get_time() - start;
+
+  for (int i = 0; i < num_msgs; i++) {
+    per_core[msgs[i].core]++;
+  }
+
+  Serial.print("Burst of ");
+  Serial.print(num_msgs);
+  Serial.print(" messages done in ");
+  Serial.print((int32_t)(elapsed / 1000));
+  Serial.print(" ms (");
+  Serial.print(num_msgs * work_us / 1000);
+  Serial.println(" ms of work)");
+
+  for (int i = 0; i < runtime.numWorkers(); i++) {
+    WsWorkerStats stats;
+    runtime.getStats(i, &stats);
+    Serial.print("Core ");
+    Serial.print(i);
+    Serial.print(" | messages: ");
+    Serial.print(per_core[i]);
+    Serial.print(" | steals: ");
+    Serial.print(stats.steals);
+    Serial.print(" (");
+    Serial.print(stats.stolen_jobs);
+    Serial.print(" jobs) | max depth: ");
+    Serial.println(stats.max_depth);
+  }
+}
+
+void loop() {
+
+  // Do nothing but allow yielding to lower-priority tasks
+  vTaskDelay(1000 / portTICK_PERIOD_MS);
+}
@@ -4,12 +4,39 @@
    
   Efraim Manurung, 8th August 2024
   Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Task stacks and the semaphore are declared at compile time when built
+                with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc). Start exactly num_tasks
+                tasks (the loop used to start one more than the semaphore counts).
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : The messages are handled as jobs by a fixed pool of workers (lib/WorkerPool)
+                instead of one task per message that deletes itself. setup() waits for
+                every job to finish and prints the pool statistics. The jobs/s comparison
+                with create/delete tasks lives in main-bench-pool.cpp.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.3 : Each job gets its own copy of the message (WorkerPool::submitCopy()), so
+                the counting semaphore that made setup() wait until every job had read
+                msg_input is gone.
+
+  Efraim Manurung, 17th October 2026
+  Version 1.4 : The text is copied into Message.body with snprintf(), bounded by the size
+                of body (strcpy() wrote 23 bytes into 20), so it arrives cut to 19 chars
   
   Demo in the lecture:
   Demonstrate a counting semaphore by creating several tasks with the same parameters.
+
+  This sketch:
+  The same messages are handed to a fixed pool of workers as jobs, each with its own copy
+  of the message. No counting semaphore is left; setup() waits for the jobs only to print
+  the pool statistics.
 */
 
 #include <Arduino.h>
+#include <StaticAlloc.h>
+#include <WorkerPool.h>
 #include <stdio.h>
 #include <iostream>
 
@@ -21,7 +48,8 @@
 #endif
 
 // Settings
-static const int num_tasks = 5; // Number of tasks to create
+static const int num_tasks = 5;     // Number of jobs to submit
+static const int num_workers = 2;   // Tasks in the pool that run them
 
 // Example struct for passing a string as parameter
 typedef struct Message {
@@ -29,19 +57,16 @@ typedef struct Message {
   uint8_t len;
 } Message;
 
-// Globals
-static SemaphoreHandle_t sem_params;  // Counts down when parameters read
+// Workers (stack size in bytes) and job queue, static in USE_STATIC_ALLOCATION builds
+static StaticWorkerPool<num_workers, 1024, num_tasks> pool;
 
 //******************************************************************************************
-// Tasks
-
-void myTask(void *parameters) {
+// Jobs
 
-  // Copy the message struct from the parameter to a local variable
-  Message msg = *(Message *)parameters;
+void myJob(void *parameters) {
 
-  // Increment semaphore to indicate that the parameter has been read
-  xSemaphoreGive(sem_params);
+  // The job's own copy of the message, valid until this function returns
+  const Message &msg = *(Message *)parameters;
 
   // Print out message contents
   Serial.print("Received: ");
@@ -49,9 +74,8 @@ void myTask(void *parameters) {
   Serial.print(" | len: ");
   Serial.println(msg.len);
 
-  // Wait for a while and delete self
+  // Wait for a while, the worker then picks up the next job
   vTaskDelay(1000 / portTICK_PERIOD_MS);
-  vTaskDelete(NULL);
 }
 
 //*****************************************************************************
@@ -61,8 +85,8 @@ void setup() {
   // printf("VOID SETUP!");
   // std::cout << "VOID SETUP std" << std::endl;
 
-  char task_name[12];
   Message msg_input;
+  WorkerPoolStats stats;
   char text[30] = "All your base EfraimMM";
 
   // Configure Serial
@@ -71,38 +95,36 @@ void setup() {
   // Wait a moment to start (so we don't miss Serial output)
   vTaskDelay(1000 / portTICK_PERIOD_MS);
   Serial.println();
-  Serial.println("---FreeRTOS Counting Semaphore Demo---");
-
-  // Create semaphores (initialize at 0)
-  sem_params = xSemaphoreCreateCounting(num_tasks, 0);
+  Serial.println("---FreeRTOS Worker Pool Demo---");
 
   // Create message to use as argument common to all tasks
-  strcpy(msg_input.body, text);
-  msg_input.len = strlen(text);
-
-  // Start tasks
-  for (int i = 0; i <= num_tasks; i++) {
-
-    // Generate unique name string for task
-    sprintf(task_name, "Task %i", i);
-
-    // Start task and pass argument (common Message struct)
-    xTaskCreatePinnedToCore(myTask,
-                            task_name,
-                            1024,
-                            (void *)&msg_input,
-                            1,
-                            NULL,
-                            app_cpu);
-  }
+  // Bounded copy, the text is longer than body and is cut (always terminated)
+  snprintf(msg_input.body, sizeof(msg_input.body), "%s", text);
+  msg_input.len = strlen(msg_input.body);
+
+  // Start the workers
+  pool.begin("Worker", 1, app_cpu);
 
-  // Wait for all tasks to read shared memory
+  // Submit jobs, each with a copy of the message, report back to this task
   for (int i = 0; i < num_tasks; i++) {
-    xSemaphoreTake(sem_params, portMAX_DELAY);
+    pool.submitCopy(myJob, msg_input, xTaskGetCurrentTaskHandle());
   }
 
-  // Notify that all tasks have been created
-  Serial.println("All tasks created");
+  // Nothing to wait for before msg_input goes out of scope
+  Serial.println("All jobs submitted");
+
+  // Wait until every job has finished, only to print the statistics
+  WorkerPool::waitDone(num_tasks, portMAX_DELAY);
+
+  pool.getStats(&stats);
+  Serial.print("All jobs done | workers: ");
+  Serial.print(stats.num_workers);
+  Serial.print(" | jobs: ");
+  Serial.print(stats.done_count);
+  Serial.print(" | max queued: ");
+  Serial.print(stats.max_queued_jobs);
+  Serial.print(" | max busy: ");
+  Serial.println(stats.max_busy_workers);
 }
 
 void loop() {
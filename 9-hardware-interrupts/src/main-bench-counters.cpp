@@ -0,0 +1,311 @@
+/*
+    Counter benchmark: mutex and spinlock versus atomic and sharded counters
+
+    Efraim Manurung, 17th October 2026
+    Version 1.0
+
+    The same shared counter is incremented four ways:
+
+    - "mutex"    : xSemaphoreTake/xSemaphoreGive around counter++ (6-mutex), tasks only
+    - "spinlock" : portENTER_CRITICAL/portEXIT_CRITICAL around counter++
+                   (main-demo-isr-critical-section.cpp up to version 1.2)
+    - "atomic"   : AtomicCounter (lib/AtomicCounter), one compare-and-swap
+    - "sharded"  : ShardedCounter (lib/AtomicCounter), one counter per core, summed on read
+
+    Two measurements for each:
+
+    - "tasks" : one task per core increments num_increments times as fast as it can, the
+                time per increment with both cores hitting the counter
+    - "ISR"   : a hardware timer ISR increments every isr_period_us (20 kHz) on core 1
+                while a task on core 0 keeps incrementing the same counter, the CPU cycles
+                the ISR spends on one increment (average and worst)
+
+    Every run checks that no increment got lost. A mutex can't be taken in an ISR, so
+    there is no ISR run for it.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <AtomicCounter.h>
+
+// The ISR runs on core 1, the task that competes with it on core 0
+#if CONFIG_FREERTOS_UNICORE
+    static const BaseType_t app_cpu = 0;
+#else
+    static const BaseType_t app_cpu = 1;
+#endif
+static const BaseType_t other_cpu = 0;
+
+// Settings
+static const uint32_t num_increments = 100000;
+static const uint32_t isr_run_ms = 1000;
+static const uint64_t isr_period_us = 50;
+static const uint16_t timer_divider = 80;   // count at 1 MHz
+
+typedef enum CounterKind {
+    COUNTER_MUTEX,
+    COUNTER_SPINLOCK,
+    COUNTER_ATOMIC,
+    COUNTER_SHARDED
+} CounterKind;
+
+// Globals
+static hw_timer_t *timer = NULL;
+static volatile CounterKind counter_kind = COUNTER_MUTEX;
+static volatile bool start = false;
+static volatile bool running = false;
+static AtomicCounter num_done;
+
+static SemaphoreHandle_t mutex = NULL;
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t plain_counter = 0;
+static AtomicCounter atomic_counter;
+static ShardedCounter sharded_counter;
+
+// Results, each written by one task or the ISR only
+static uint32_t worker_us[portNUM_PROCESSORS];
+static uint32_t hammer_count = 0;
+static volatile uint32_t isr_hits = 0;
+static volatile uint32_t isr_cycles = 0;
+static volatile uint32_t isr_max_cycles = 0;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<4096> bench_task;
+static TaskStorage<2048> worker_tasks[portNUM_PROCESSORS];
+static TaskStorage<2048> hammer_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static MutexStorage mutex_storage;
+
+//*****************************************************************************
+// Counting, the only difference between the runs
+
+static void countFromTask() {
+    switch (counter_kind) {
+        case COUNTER_MUTEX:
+            xSemaphoreTake(mutex, portMAX_DELAY);
+            plain_counter++;
+            xSemaphoreGive(mutex);
+            break;
+        case COUNTER_SPINLOCK:
+            portENTER_CRITICAL(&spinlock);
+            plain_counter++;
+            portEXIT_CRITICAL(&spinlock);
+            break;
+        case COUNTER_ATOMIC:
+            atomic_counter.increment();
+            break;
+        case COUNTER_SHARDED:
+            sharded_counter.increment();
+            break;
+    }
+}
+
+static void IRAM_ATTR countFromISR() {
+    switch (counter_kind) {
+        case COUNTER_SPINLOCK:
+            portENTER_CRITICAL_ISR(&spinlock);
+            plain_counter++;
+            portEXIT_CRITICAL_ISR(&spinlock);
+            break;
+        case COUNTER_ATOMIC:
+            atomic_counter.increment();
+            break;
+        case COUNTER_SHARDED:
+            sharded_counter.increment();
+            break;
+        default:
+            break;
+    }
+}
+
+static uint32_t counterValue() {
+    switch (counter_kind) {
+        case COUNTER_ATOMIC:
+            return atomic_counter.load();
+        case COUNTER_SHARDED:
+            return sharded_counter.load();
+        default:
+            return plain_counter;
+    }
+}
+
+static void resetCounters() {
+    plain_counter = 0;
+    atomic_counter.store(0);
+    sharded_counter.exchangeZero();
+    num_done.store(0);
+}
+
+//*****************************************************************************
+// Interrupt Service Routines (ISRs)
+
+void IRAM_ATTR onTimer() {
+    uint32_t begin = ESP.getCycleCount();
+    countFromISR();
+    uint32_t cycles = ESP.getCycleCount() - begin;
+
+    isr_hits++;
+    isr_cycles += cycles;
+    if (cycles > isr_max_cycles) {
+        isr_max_cycles = cycles;
+    }
+}
+
+//*****************************************************************************
+// Tasks
+
+// Task: increment num_increments times, note how long it took
+void worker(void *parameters) {
+    int index = (int)(intptr_t)parameters;
+
+    while (!start) {
+        vTaskDelay(1);
+    }
+
+    int64_t begin = esp_timer_get_time();
+    for (uint32_t i = 0; i < num_increments; i++) {
+        countFromTask();
+    }
+    worker_us[index] = (uint32_t)(esp_timer_get_time() - begin);
+
+    num_done.increment();
+    vTaskDelete(NULL);
+}
+
+// Task: keep incrementing the counter the ISR uses, from the other core
+void hammer(void *parameters) {
+    uint32_t count = 0;
+
+    while (running) {
+        countFromTask();
+        count++;
+    }
+
+    hammer_count = count;
+    num_done.increment();
+    vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Benchmarks
+
+static void runTasks(const char *label) {
+    resetCounters();
+    start = false;
+
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        worker_tasks[i].createPinnedToCore(worker, "Worker", (void *)(intptr_t)i, 1, i);
+    }
+    start = true;
+    while (num_done.load() < portNUM_PROCESSORS) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+
+    // Let the idle tasks finish deleting them before their storage is used again
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+
+    uint32_t slowest_us = 0;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        if (worker_us[i] > slowest_us) {
+            slowest_us = worker_us[i];
+        }
+    }
+    uint32_t expected = num_increments * portNUM_PROCESSORS;
+
+    Serial.printf("%-9s tasks %6u ns per increment   count %u of %u %s\n",
+                  label,
+                  (unsigned)((uint64_t)slowest_us * 1000 / num_increments),
+                  (unsigned)counterValue(),
+                  (unsigned)expected,
+                  counterValue() == expected ? "ok" : "LOST");
+}
+
+static void runISR(const char *label) {
+    resetCounters();
+    isr_hits = 0;
+    isr_cycles = 0;
+    isr_max_cycles = 0;
+    running = true;
+
+    hammer_task.createPinnedToCore(hammer, "Hammer", NULL, 1, other_cpu);
+    timerAlarmEnable(timer);
+    vTaskDelay(pdMS_TO_TICKS(isr_run_ms));
+    timerAlarmDisable(timer);
+
+    running = false;
+    while (num_done.load() < 1) {
+        vTaskDelay(10 / portTICK_PERIOD_MS);
+    }
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+
+    uint32_t expected = isr_hits + hammer_count;
+
+    Serial.printf("%-9s ISR   avg %4u max %5u cycles   count %u of %u %s\n",
+                  label,
+                  (unsigned)(isr_hits > 0 ? isr_cycles / isr_hits : 0),
+                  (unsigned)isr_max_cycles,
+                  (unsigned)counterValue(),
+                  (unsigned)expected,
+                  counterValue() == expected ? "ok" : "LOST");
+}
+
+// Task: the benchmark itself
+void runBench(void *parameters) {
+
+    counter_kind = COUNTER_MUTEX;
+    runTasks("mutex");
+    Serial.println("mutex     ISR   n/a (a mutex can't be taken in an ISR)");
+
+    counter_kind = COUNTER_SPINLOCK;
+    runTasks("spinlock");
+    runISR("spinlock");
+
+    counter_kind = COUNTER_ATOMIC;
+    runTasks("atomic");
+    runISR("atomic");
+
+    counter_kind = COUNTER_SHARDED;
+    runTasks("sharded");
+    runISR("sharded");
+
+    Serial.printf("RAM per counter: mutex %u B, spinlock %u B, AtomicCounter %u B, "
+                  "ShardedCounter %u B\n",
+                  (unsigned)(sizeof(StaticSemaphore_t) + sizeof(uint32_t)),
+                  (unsigned)(sizeof(portMUX_TYPE) + sizeof(uint32_t)),
+                  (unsigned)sizeof(AtomicCounter),
+                  (unsigned)sizeof(ShardedCounter));
+    Serial.println("Done");
+    vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+    // Configure Serial
+    Serial.begin(115200);
+
+    // Wait a moment to start (so we don't miss Serial output)
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    Serial.println();
+    Serial.println("---Mutex vs spinlock vs atomic counter benchmark---");
+
+    mutex = mutex_storage.create();
+
+    // Timer is attached here (ISR on core 1) but only enabled during the ISR runs
+    timer = timerBegin(0, timer_divider, true);
+    timerAttachInterrupt(timer, &onTimer, true);
+    timerAlarmWrite(timer, isr_period_us, true);
+
+    // Above the workers, so it gets to print while they run on its core
+    bench_task.createPinnedToCore(runBench, "Bench", NULL, 2, app_cpu);
+
+    // Delete "setup and loop" task
+    vTaskDelete(NULL);
+}
+
+void loop() {
+    // Execution should never get here
+}
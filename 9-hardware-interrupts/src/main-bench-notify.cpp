@@ -0,0 +1,229 @@
+/*
+    Signal benchmark: binary semaphores versus task notifications
+
+    Efraim Manurung, 17th October 2026
+    Version 1.0
+
+    Measures the two hand-offs of the repo with a binary semaphore and with NotifySignal
+    (lib/NotifySignal):
+
+    - "give + take"  : give and take in the same task, the API cost without any switch
+    - "ping-pong"    : two tasks signal each other back and forth, one round trip is two
+                       gives, two takes and two context switches (the hand-off of
+                       7-semaphore-binary, done num_round_trips times)
+    - "ISR -> task"  : a hardware timer ISR signals a waiting task every isr_period_us,
+                       the task measures the time from the ISR to itself running (the
+                       hand-off of main-demo-isr-semaphore.cpp)
+
+    All tasks run on core 1. It also prints the RAM of one signal of each kind.
+*/
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <NotifySignal.h>
+
+// Use only core 1 for demo purposes
+#if CONFIG_FREERTOS_UNICORE
+    static const BaseType_t app_cpu = 0;
+#else
+    static const BaseType_t app_cpu = 1;
+#endif
+
+// Settings
+static const int num_give_take = 10000;
+static const int num_round_trips = 2000;
+static const int num_isr_samples = 1000;
+static const uint64_t isr_period_us = 1000;
+static const uint16_t timer_divider = 80;   // count at 1 MHz
+
+// Globals
+static volatile bool use_notify = false;
+static volatile int64_t isr_stamp = 0;
+static hw_timer_t *timer = NULL;
+
+static SemaphoreHandle_t ping_sem = NULL;
+static SemaphoreHandle_t pong_sem = NULL;
+static SemaphoreHandle_t isr_sem = NULL;
+static NotifySignal ping_signal;
+static NotifySignal pong_signal;
+static NotifySignal isr_signal;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<4096> bench_task;
+static TaskStorage<2048> echo_task;
+
+// Kernel object storage (static in USE_STATIC_ALLOCATION builds)
+static BinarySemaphoreStorage ping_sem_storage;
+static BinarySemaphoreStorage pong_sem_storage;
+static BinarySemaphoreStorage isr_sem_storage;
+
+//*****************************************************************************
+// Interrupt Service Routines (ISRs)
+
+void IRAM_ATTR onTimer() {
+    BaseType_t task_woken = pdFALSE;
+
+    isr_stamp = esp_timer_get_time();
+    if (use_notify) {
+        isr_signal.giveFromISR(&task_woken);
+    } else {
+        xSemaphoreGiveFromISR(isr_sem, &task_woken);
+    }
+
+    if (task_woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+//*****************************************************************************
+// Tasks
+
+// Task: answer every ping with a pong (same priority as the benchmark task)
+void echo(void *parameters) {
+    while (1) {
+        if (use_notify) {
+            ping_signal.take(portMAX_DELAY);
+            pong_signal.give();
+        } else {
+            xSemaphoreTake(ping_sem, portMAX_DELAY);
+            xSemaphoreGive(pong_sem);
+        }
+    }
+}
+
+//*****************************************************************************
+// Benchmarks (return nanoseconds per operation)
+
+static uint32_t giveTake() {
+    int64_t start = esp_timer_get_time();
+
+    for (int i = 0; i < num_give_take; i++) {
+        if (use_notify) {
+            isr_signal.give();
+            isr_signal.take(0);
+        } else {
+            xSemaphoreGive(isr_sem);
+            xSemaphoreTake(isr_sem, 0);
+        }
+    }
+    return (uint32_t)((esp_timer_get_time() - start) * 1000 / num_give_take);
+}
+
+static uint32_t pingPong() {
+    int64_t start = esp_timer_get_time();
+
+    for (int i = 0; i < num_round_trips; i++) {
+        if (use_notify) {
+            ping_signal.give();
+            pong_signal.take(portMAX_DELAY);
+        } else {
+            xSemaphoreGive(ping_sem);
+            xSemaphoreTake(pong_sem, portMAX_DELAY);
+        }
+    }
+    return (uint32_t)((esp_timer_get_time() - start) * 1000 / num_round_trips);
+}
+
+static void isrToTask(uint32_t *avg_ns, uint32_t *max_ns) {
+    int64_t total = 0;
+    int64_t worst = 0;
+
+    timerAlarmEnable(timer);
+    for (int i = 0; i < num_isr_samples; i++) {
+        if (use_notify) {
+            isr_signal.take(portMAX_DELAY);
+        } else {
+            xSemaphoreTake(isr_sem, portMAX_DELAY);
+        }
+        int64_t latency = esp_timer_get_time() - isr_stamp;
+        total += latency;
+        if (latency > worst) {
+            worst = latency;
+        }
+    }
+    timerAlarmDisable(timer);
+
+    // Drop a give that may have come in after the last sample
+    vTaskDelay(pdMS_TO_TICKS(5));
+    if (use_notify) {
+        isr_signal.take(0);
+    } else {
+        xSemaphoreTake(isr_sem, 0);
+    }
+
+    *avg_ns = (uint32_t)(total * 1000 / num_isr_samples);
+    *max_ns = (uint32_t)(worst * 1000);
+}
+
+static void runAll(const char *label) {
+    uint32_t give_take_ns = giveTake();
+    uint32_t round_trip_ns = pingPong();
+    uint32_t isr_avg_ns;
+    uint32_t isr_max_ns;
+    isrToTask(&isr_avg_ns, &isr_max_ns);
+
+    Serial.printf("%-10s give + take %6u ns   ping-pong %6u ns   ISR -> task avg %6u ns "
+                  "max %6u ns\n",
+                  label,
+                  (unsigned)give_take_ns,
+                  (unsigned)round_trip_ns,
+                  (unsigned)isr_avg_ns,
+                  (unsigned)isr_max_ns);
+}
+
+// Task: the benchmark itself
+void runBench(void *parameters) {
+
+    // Both kinds are waited for by this task, except the pings
+    ping_signal.bind(echo_task.createPinnedToCore(echo, "Echo", NULL, 1, app_cpu));
+    pong_signal.bind();
+    isr_signal.bind();
+
+    use_notify = false;
+    runAll("semaphore");
+
+    // The echo task is blocked on the semaphore, one last ping moves it over
+    use_notify = true;
+    xSemaphoreGive(ping_sem);
+    vTaskDelay(pdMS_TO_TICKS(5));
+    xSemaphoreTake(pong_sem, 0);
+    runAll("notify");
+
+    Serial.printf("RAM per signal: semaphore %u B, NotifySignal %u B\n",
+                  (unsigned)sizeof(StaticSemaphore_t),
+                  (unsigned)sizeof(NotifySignal));
+    Serial.println("Done");
+    vTaskDelete(NULL);
+}
+
+//*****************************************************************************
+// Main (runs as its own task with priority 1 on core 1)
+
+void setup() {
+
+    // Configure Serial
+    Serial.begin(115200);
+
+    // Wait a moment to start (so we don't miss Serial output)
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    Serial.println();
+    Serial.println("---Semaphore vs task notification benchmark---");
+
+    ping_sem = ping_sem_storage.create();
+    pong_sem = pong_sem_storage.create();
+    isr_sem = isr_sem_storage.create();
+
+    // Timer is attached here but only enabled during the ISR measurement
+    timer = timerBegin(0, timer_divider, true);
+    timerAttachInterrupt(timer, &onTimer, true);
+    timerAlarmWrite(timer, isr_period_us, true);
+
+    bench_task.createPinnedToCore(runBench, "Bench", NULL, 1, app_cpu);
+
+    // Delete "setup and loop" task
+    vTaskDelete(NULL);
+}
+
+void loop() {
+    // Execution should never get here
+}
@@ -4,6 +4,19 @@
 
     Efraim Manurung, 12th August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Task stacks and control blocks are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : printValues() wakes up on absolute release times (lib/PeriodicTask)
+                  instead of 2 seconds after it finished printing
+
+    Efraim Manurung, 17th October 2026
+    Version 1.3 : isr_counter is an AtomicCounter (lib/AtomicCounter). The ISR and the
+                  task change it with one atomic read-modify-write each, so the spinlock
+                  and the critical sections (interrupts off) are gone.
     
     Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-9-hardware-interrupts/3ae7a68462584e1eb408e1638002e9ed
 
@@ -11,10 +24,14 @@
 
     ESP32 ISR Critical Section Demo
 
-    Increment global variable in ISR.
+    Increment global variable in ISR. Compare the mutex and spinlock versions with the
+    atomic counters in main-bench-counters.cpp.
 */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <PeriodicTask.h>
+#include <AtomicCounter.h>
 
 // USe only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -30,18 +47,19 @@ static const TickType_t task_delay = 2000 / portTICK_PERIOD_MS;
 
 // Globals
 static hw_timer_t *timer = NULL;
-static volatile int isr_counter;
-static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+static AtomicCounter isr_counter;
+static PeriodicTask print_period;
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> print_values_task;
 
 //*****************************************************************************
 // Interrupt Service Routines (ISRs)
 
 void IRAM_ATTR onTimer() {
 
-    // ESP-IDF version of a critical sectioni (in an ISR)
-    portENTER_CRITICAL_ISR(&spinlock);
-    isr_counter++;
-    portEXIT_CRITICAL_ISR(&spinlock);
+    // One atomic increment, no critical section needed (interrupts stay on)
+    isr_counter.increment();
 }
 
 //*****************************************************************************
@@ -50,23 +68,23 @@ void IRAM_ATTR onTimer() {
 // Wait for semaphore and print out ADC value when received 
 void printValues(void *parameters) {
 
+    print_period.begin(task_delay);
+
     // Loop forever
     while (1) {
 
         // Count down and print out counter value
-        while (isr_counter > 0) {
+        while (isr_counter.load() > 0) {
 
         // Print value of counter
-        Serial.println(isr_counter);
+        Serial.println(isr_counter.load());
 
-        // ESP-IDF version of a critical section (in a task)
-        portENTER_CRITICAL(&spinlock);
-        isr_counter--;
-        portEXIT_CRITICAL(&spinlock);
+        // Atomic decrement, an increment from the ISR in between is not lost
+        isr_counter.decrement();
         }
 
-        // Wait 2 seconds while ISR increments counter a few times
-        vTaskDelay(task_delay);
+        // Wait until 2 seconds after the last wake-up while ISR increments counter a few times
+        print_period.wait();
     }
 }
 
@@ -83,13 +101,11 @@ void setup() {
     Serial.println();
     Serial.println("---FreeRTOS ISR Critical Section Demo---");
 
-    xTaskCreatePinnedToCore(printValues,
-                            "Print values",
-                            1024,
-                            NULL,
-                            1,
-                            NULL,
-                            app_cpu);
+    print_values_task.createPinnedToCore(printValues,
+                                         "Print values",
+                                         NULL,
+                                         1,
+                                         app_cpu);
     
     // Create and start timer (num, divider, countUp)
     timer = timerBegin(0, timer_divider, true);
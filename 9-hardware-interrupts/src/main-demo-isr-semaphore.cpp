@@ -4,6 +4,14 @@
 
     Efraim Manurung, 13th August 2024
     Version 1.0
+
+    Efraim Manurung, 17th October 2026
+    Version 1.1 : Task stacks and kernel objects are declared at compile time when
+                  built with USE_STATIC_ALLOCATION=1 (lib/StaticAlloc)
+
+    Efraim Manurung, 17th October 2026
+    Version 1.2 : The ISR wakes the task with a task notification (lib/NotifySignal)
+                  instead of a binary semaphore, see main-bench-notify.cpp for the difference
     
     Concepts from URL: https://www.digikey.nl/en/maker/projects/introduction-to-rtos-solution-to-part-9-hardware-interrupts/3ae7a68462584e1eb408e1638002e9ed
 
@@ -47,6 +55,8 @@
 */
 
 #include<Arduino.h>
+#include <StaticAlloc.h>
+#include <NotifySignal.h>
 
 // Use only core 1 for demo purposes
 #if CONFIG_FREERTOS_UNICORE
@@ -65,7 +75,10 @@ static const int adc_pin = A0;
 // Globals
 static hw_timer_t *timer = NULL;
 static volatile uint16_t val;
-static SemaphoreHandle_t bin_sem = NULL;
+static NotifySignal value_ready;   // Given by the ISR, taken by printValues()
+
+// Task storage (stack size in bytes, static in USE_STATIC_ALLOCATION builds)
+static TaskStorage<1024> print_values_task;
 
 //*****************************************************************************
 // Interrupt Service Routines (ISRs)
@@ -78,8 +91,8 @@ void IRAM_ATTR onTimer() {
     // Perform action (read from ADC)
     val = analogRead(adc_pin);
 
-    // Give semaphore to tell task that new value is ready
-    xSemaphoreGiveFromISR(bin_sem, &task_woken);
+    // Notify the task that a new value is ready
+    value_ready.giveFromISR(&task_woken);
 
     // Exit from ISR (ESP-IDF)
     if (task_woken) {
@@ -90,12 +103,12 @@ void IRAM_ATTR onTimer() {
 //*****************************************************************************
 // Tasks
 
-// Wait for semaphore and print out ADC value when received
+// Wait for the notification and print out ADC value when received
 void printValues(void *parameters) {
 
-    // Loop forever, wait for semaphore, and print value
+    // Loop forever, wait for notification, and print value
     while (1) {
-        xSemaphoreTake(bin_sem, portMAX_DELAY);
+        value_ready.take(portMAX_DELAY);
         Serial.println(val);
     }
 }
@@ -113,23 +126,12 @@ void setup() {
   Serial.println();
   Serial.println("---FreeRTOS ISR Buffer Demo---");
 
-  // Create semaphore before it is used (in task or ISR)
-  bin_sem = xSemaphoreCreateBinary();
-
-  // Force reboot if we can't create the semaphore
-  if (bin_sem == NULL) {
-    Serial.println("Could not create semaphore");
-    ESP.restart();
-  }
-
-  // Start task to print out results (higher priority!)
-  xTaskCreatePinnedToCore(printValues,
-                          "Print values",
-                          1024,
-                          NULL,
-                          2,
-                          NULL,
-                          app_cpu);
+  // Start task to print out results (higher priority!), the ISR notifies it
+  value_ready.bind(print_values_task.createPinnedToCore(printValues,
+                                                        "Print values",
+                                                        NULL,
+                                                        2,
+                                                        app_cpu));
 
   // Create and start timer (num, divider, countUp)
   timer = timerBegin(0, timer_divider, true);
@@ -0,0 +1,514 @@
+/*
+  Simulation of tasks sharing mutexes on one core
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "LockSim.h"
+
+#include <set>
+#include <stdio.h>
+
+#include <TaskSet.h>
+
+static const int lock_max_mutexes = 64;
+static const uint64_t no_release = UINT64_MAX;
+
+// Run-time state of one task
+typedef struct SimLockTask {
+  bool active;                // A job has been released and not finished
+  uint64_t release_us;
+  uint64_t next_release_us;
+  size_t step;                // Index into the script
+  uint64_t remaining_us;      // Of the current compute step
+  bool sleeping;
+  uint64_t wake_us;
+  int waiting_for;            // Mutex whose holder this job waits for, -1 if none
+  std::vector<int> held;      // Mutexes in the order they were taken
+  long section;               // Id of the outermost critical section held, -1 if none
+  long job;                   // Id of the current job
+  uint64_t blocked_us;
+  std::set<long> blockers;    // Sections (>= 0) or jobs (< 0) that blocked this job
+} SimLockTask;
+
+// Everything one simulation run works on
+typedef struct LockSimState {
+  const std::vector<LockTask> *tasks;
+  LockProtocol protocol;
+  std::vector<SimLockTask> state;
+  std::vector<int> owner;     // Per mutex, -1 if free
+  std::vector<int> ceiling;
+  long next_section;
+  long next_job;
+  uint64_t now;
+  LockSimResult *result;
+} LockSimState;
+
+//*****************************************************************************
+// Scenario file
+
+static bool parseScript(const std::string &text, std::vector<LockStep> &script) {
+  size_t start = 0;
+
+  while (start < text.size()) {
+    size_t end = text.find(' ', start);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    std::string token = text.substr(start, end - start);
+    start = end + 1;
+    if (token.empty()) {
+      continue;
+    }
+
+    LockStep step = {LOCK_STEP_COMPUTE, 0, 0};
+    std::string value = token.substr(1);
+    bool ok;
+    switch (token[0]) {
+      case 'c':
+        ok = tableParseMs(value, &step.us);
+        break;
+      case 's':
+        step.type = LOCK_STEP_SLEEP;
+        ok = tableParseMs(value, &step.us);
+        break;
+      case 'l':
+        step.type = LOCK_STEP_TAKE;
+        ok = tableParseInt(value, &step.mutex);
+        break;
+      case 'u':
+        step.type = LOCK_STEP_GIVE;
+        ok = tableParseInt(value, &step.mutex);
+        break;
+      default:
+        ok = false;
+        break;
+    }
+    if (!ok || step.mutex < 0 || step.mutex >= lock_max_mutexes) {
+      return false;
+    }
+    script.push_back(step);
+  }
+  return true;
+}
+
+// Every give matches a take of this script, nothing is held at the end, and a loop
+// script takes some time
+static bool checkScript(const LockTask &task) {
+  std::set<int> held;
+  uint64_t total_us = 0;
+
+  for (size_t i = 0; i < task.script.size(); i++) {
+    const LockStep &step = task.script[i];
+    if (step.type == LOCK_STEP_TAKE && !held.insert(step.mutex).second) {
+      return false;
+    }
+    if (step.type == LOCK_STEP_GIVE && held.erase(step.mutex) == 0) {
+      return false;
+    }
+    total_us += step.us;
+  }
+  return held.empty() && (task.period_us > 0 || total_us > 0);
+}
+
+//*****************************************************************************
+// Helpers
+
+static int effectivePriority(const LockSimState &sim, int t, int depth) {
+  const SimLockTask &task = sim.state[t];
+  int priority = (*sim.tasks)[t].priority;
+
+  if (sim.protocol == LOCK_CEILING) {
+    for (size_t i = 0; i < task.held.size(); i++) {
+      if (sim.ceiling[task.held[i]] > priority) {
+        priority = sim.ceiling[task.held[i]];
+      }
+    }
+  }
+
+  // Waiters lend their priority to the holder (and on down a chain of holders)
+  if (sim.protocol != LOCK_PLAIN && depth < (int)sim.state.size()) {
+    for (size_t w = 0; w < sim.state.size(); w++) {
+      int mutex = sim.state[w].waiting_for;
+      if (mutex >= 0 && sim.owner[mutex] == t) {
+        int lent = effectivePriority(sim, (int)w, depth + 1);
+        if (lent > priority) {
+          priority = lent;
+        }
+      }
+    }
+  }
+  return priority;
+}
+
+// Ready task with the highest priority, the running one keeps the core on a tie
+static int pickTask(const LockSimState &sim, int running) {
+  int best = -1;
+  int best_priority = 0;
+
+  for (size_t t = 0; t < sim.state.size(); t++) {
+    const SimLockTask &task = sim.state[t];
+    if (!task.active || task.sleeping || task.waiting_for >= 0) {
+      continue;
+    }
+    int priority = effectivePriority(sim, (int)t, 0);
+    if (best < 0 || priority > best_priority ||
+        (priority == best_priority && (int)t == running)) {
+      best = (int)t;
+      best_priority = priority;
+    }
+  }
+  return best;
+}
+
+// Move to `step` of the script, a compute step gets its full time
+static void enterStep(LockSimState &sim, int t, size_t step) {
+  SimLockTask &task = sim.state[t];
+  const std::vector<LockStep> &script = (*sim.tasks)[t].script;
+
+  task.step = step;
+  task.remaining_us = (step < script.size() && script[step].type == LOCK_STEP_COMPUTE)
+                    ? script[step].us : 0;
+}
+
+static void startJob(LockSimState &sim, int t, uint64_t release_us) {
+  SimLockTask &task = sim.state[t];
+
+  task.active = true;
+  task.release_us = release_us;
+  task.job = sim.next_job++;
+  task.blocked_us = 0;
+  task.blockers.clear();
+  enterStep(sim, t, 0);
+  sim.result->tasks[t].jobs++;
+}
+
+static void noteBlocking(LockSimState &sim, int t) {
+  SimLockTask &task = sim.state[t];
+  LockTaskStats &stats = sim.result->tasks[t];
+
+  if (task.blocked_us > stats.max_blocked_us) {
+    stats.max_blocked_us = task.blocked_us;
+  }
+  if (task.blockers.size() > stats.max_blocking_sections) {
+    stats.max_blocking_sections = (uint32_t)task.blockers.size();
+  }
+}
+
+static void finishJob(LockSimState &sim, int t) {
+  SimLockTask &task = sim.state[t];
+  LockTaskStats &stats = sim.result->tasks[t];
+  uint64_t response = sim.now - task.release_us;
+
+  stats.completed++;
+  if (response > stats.max_response_us) {
+    stats.max_response_us = response;
+  }
+  noteBlocking(sim, t);
+  task.active = false;
+
+  // A loop starts over right away
+  if ((*sim.tasks)[t].period_us == 0) {
+    startJob(sim, t, sim.now);
+  }
+}
+
+// Report a wait-for cycle that goes through task t
+static void checkDeadlock(LockSimState &sim, int t) {
+  std::vector<int> chain;
+  int current = t;
+
+  for (size_t hops = 0; hops <= sim.state.size(); hops++) {
+    chain.push_back(current);
+    int mutex = sim.state[current].waiting_for;
+    if (mutex < 0 || sim.owner[mutex] < 0) {
+      return;
+    }
+    current = sim.owner[mutex];
+    if (current == t) {
+      break;
+    }
+  }
+  if (current != t || sim.result->deadlock) {
+    return;
+  }
+
+  sim.result->deadlock = true;
+  sim.result->deadlock_us = sim.now;
+  sim.result->deadlock_tasks = chain;
+}
+
+static bool tryTake(LockSimState &sim, int t, int mutex) {
+  SimLockTask &task = sim.state[t];
+  int wait_on = (sim.owner[mutex] >= 0) ? mutex : -1;
+
+  // Ceiling: nobody else may hold a mutex with a ceiling at our priority or above
+  if (sim.protocol == LOCK_CEILING) {
+    int priority = effectivePriority(sim, t, 0);
+    for (size_t m = 0; m < sim.owner.size(); m++) {
+      if (sim.owner[m] >= 0 && sim.owner[m] != t && sim.ceiling[m] >= priority &&
+          (wait_on < 0 || sim.ceiling[m] > sim.ceiling[wait_on])) {
+        wait_on = (int)m;
+      }
+    }
+  }
+
+  if (wait_on >= 0) {
+    task.waiting_for = wait_on;
+    checkDeadlock(sim, t);
+    return false;
+  }
+
+  sim.owner[mutex] = t;
+  task.held.push_back(mutex);
+  if (task.held.size() == 1) {
+    task.section = sim.next_section++;
+  }
+  return true;
+}
+
+static void give(LockSimState &sim, int t, int mutex) {
+  SimLockTask &task = sim.state[t];
+
+  sim.owner[mutex] = -1;
+  for (size_t i = 0; i < task.held.size(); i++) {
+    if (task.held[i] == mutex) {
+      task.held.erase(task.held.begin() + i);
+      break;
+    }
+  }
+  if (task.held.empty()) {
+    task.section = -1;
+  }
+
+  // Everybody who waited for it tries again
+  for (size_t w = 0; w < sim.state.size(); w++) {
+    if (sim.state[w].waiting_for == mutex) {
+      sim.state[w].waiting_for = -1;
+    }
+  }
+}
+
+// Run the zero-time step of task t (take, give, sleep, end of job). Returns false if it
+// is at a compute step with time left.
+static bool runInstantStep(LockSimState &sim, int t) {
+  SimLockTask &task = sim.state[t];
+  const std::vector<LockStep> &script = (*sim.tasks)[t].script;
+
+  if (task.step >= script.size()) {
+    finishJob(sim, t);
+    return true;
+  }
+
+  const LockStep &step = script[task.step];
+  switch (step.type) {
+    case LOCK_STEP_COMPUTE:
+      if (task.remaining_us > 0) {
+        return false;
+      }
+      break;
+    case LOCK_STEP_SLEEP:
+      if (step.us > 0) {
+        task.sleeping = true;
+        task.wake_us = sim.now + step.us;
+        return true;
+      }
+      break;
+    case LOCK_STEP_TAKE:
+      if (!tryTake(sim, t, step.mutex)) {
+        return true;
+      }
+      break;
+    case LOCK_STEP_GIVE:
+      give(sim, t, step.mutex);
+      break;
+  }
+  enterStep(sim, t, task.step + 1);
+  return true;
+}
+
+// Blocking seen by every job except the running one during dt
+static void addBlocking(LockSimState &sim, int running, uint64_t dt) {
+  const std::vector<LockTask> &tasks = *sim.tasks;
+
+  for (size_t j = 0; j < sim.state.size(); j++) {
+    SimLockTask &task = sim.state[j];
+    if (!task.active || task.sleeping || (int)j == running) {
+      continue;
+    }
+
+    bool blocked = false;
+    long blocker = 0;
+    if (task.waiting_for >= 0) {
+      int holder = sim.owner[task.waiting_for];
+      if (holder >= 0 && tasks[holder].priority < tasks[j].priority) {
+        blocked = true;
+        blocker = sim.state[holder].section;
+      }
+    } else if (running >= 0 && tasks[running].priority < tasks[j].priority) {
+      blocked = true;
+      blocker = (sim.state[running].section >= 0) ? sim.state[running].section
+                                                  : -(sim.state[running].job + 1);
+    }
+
+    if (blocked) {
+      task.blocked_us += dt;
+      task.blockers.insert(blocker);
+    }
+  }
+}
+
+//*****************************************************************************
+// Public API
+
+bool loadLockScenario(const char *path, std::vector<LockTask> &tasks, std::string &error) {
+  std::vector<TableRow> rows;
+  if (!readTable(path, rows, error)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < rows.size(); i++) {
+    const std::vector<std::string> &fields = rows[i].fields;
+    LockTask task;
+
+    bool ok = fields.size() == 5;
+    if (ok) {
+      task.name = fields[0];
+      ok = tableParseInt(fields[1], &task.priority) &&
+           tableParseMs(fields[2], &task.period_us) &&
+           tableParseMs(fields[3], &task.offset_us) &&
+           parseScript(fields[4], task.script) &&
+           checkScript(task);
+    }
+    if (!ok) {
+      char msg[64];
+      snprintf(msg, sizeof(msg), "%s:%d: bad task line", path, rows[i].line);
+      error = msg;
+      return false;
+    }
+    tasks.push_back(task);
+  }
+  return true;
+}
+
+void simulateLocks(const std::vector<LockTask> &tasks, LockProtocol protocol,
+                   uint64_t horizon_us, LockSimResult *result) {
+  LockSimState sim;
+  int num_mutexes = 1;
+  int running = -1;
+
+  // Mutex ceilings from the scripts
+  for (size_t t = 0; t < tasks.size(); t++) {
+    for (size_t i = 0; i < tasks[t].script.size(); i++) {
+      if (tasks[t].script[i].mutex >= num_mutexes) {
+        num_mutexes = tasks[t].script[i].mutex + 1;
+      }
+    }
+  }
+  sim.ceiling.assign(num_mutexes, 0);
+  for (size_t t = 0; t < tasks.size(); t++) {
+    for (size_t i = 0; i < tasks[t].script.size(); i++) {
+      const LockStep &step = tasks[t].script[i];
+      if (step.type == LOCK_STEP_TAKE && tasks[t].priority > sim.ceiling[step.mutex]) {
+        sim.ceiling[step.mutex] = tasks[t].priority;
+      }
+    }
+  }
+
+  sim.tasks = &tasks;
+  sim.protocol = protocol;
+  sim.owner.assign(num_mutexes, -1);
+  sim.next_section = 0;
+  sim.next_job = 0;
+  sim.now = 0;
+  sim.result = result;
+  sim.state.assign(tasks.size(), SimLockTask());
+  for (size_t t = 0; t < tasks.size(); t++) {
+    sim.state[t].active = false;
+    sim.state[t].next_release_us = tasks[t].offset_us;
+    sim.state[t].sleeping = false;
+    sim.state[t].waiting_for = -1;
+    sim.state[t].section = -1;
+  }
+
+  result->tasks.assign(tasks.size(), LockTaskStats());
+  result->ceilings = sim.ceiling;
+  result->horizon_us = horizon_us;
+  result->deadlock = false;
+  result->deadlock_us = 0;
+  result->deadlock_tasks.clear();
+
+  while (sim.now < horizon_us) {
+
+    // Releases that are due (a loop is released once, then restarts itself)
+    for (size_t t = 0; t < tasks.size(); t++) {
+      SimLockTask &task = sim.state[t];
+      while (task.next_release_us <= sim.now) {
+        if (task.active) {
+          result->tasks[t].jobs++;
+          result->tasks[t].overruns++;
+        } else {
+          startJob(sim, (int)t, task.next_release_us);
+        }
+        task.next_release_us = (tasks[t].period_us > 0)
+                             ? task.next_release_us + tasks[t].period_us : no_release;
+      }
+    }
+
+    // Sleeps that are over
+    for (size_t t = 0; t < tasks.size(); t++) {
+      SimLockTask &task = sim.state[t];
+      if (task.sleeping && task.wake_us <= sim.now) {
+        task.sleeping = false;
+        enterStep(sim, (int)t, task.step + 1);
+      }
+    }
+
+    // Zero-time steps, the highest priority task first, until one has to compute
+    running = pickTask(sim, running);
+    while (running >= 0 && runInstantStep(sim, running)) {
+      running = pickTask(sim, running);
+    }
+
+    // Run (or idle) until the step ends or something is released or wakes up
+    uint64_t until = horizon_us;
+    for (size_t t = 0; t < tasks.size(); t++) {
+      if (sim.state[t].next_release_us < until) {
+        until = sim.state[t].next_release_us;
+      }
+      if (sim.state[t].sleeping && sim.state[t].wake_us < until) {
+        until = sim.state[t].wake_us;
+      }
+    }
+    if (running >= 0 && sim.now + sim.state[running].remaining_us < until) {
+      until = sim.now + sim.state[running].remaining_us;
+    }
+
+    uint64_t dt = until - sim.now;
+    addBlocking(sim, running, dt);
+    if (running >= 0) {
+      sim.state[running].remaining_us -= dt;
+    }
+    sim.now = until;
+  }
+
+  // Jobs still open at the end (e.g. stuck in a deadlock) count with what they have
+  for (size_t t = 0; t < tasks.size(); t++) {
+    if (sim.state[t].active) {
+      noteBlocking(sim, (int)t);
+    }
+  }
+}
+
+const char *lockProtocolName(LockProtocol protocol) {
+  switch (protocol) {
+    case LOCK_PLAIN:
+      return "plain";
+    case LOCK_INHERIT:
+      return "inherit";
+    case LOCK_CEILING:
+      return "ceiling";
+  }
+  return "?";
+}
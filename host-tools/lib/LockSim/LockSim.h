@@ -0,0 +1,96 @@
+/*
+  Simulation of tasks sharing mutexes on one core
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  lib/SchedSim treats every job as one block of execution time. Here a job is a script of
+  steps, so critical sections, sleeps inside them and the order in which mutexes are taken
+  can be played forward with three mutex protocols:
+
+  - plain   : the waiter just waits, nobody's priority changes
+  - inherit : the holder runs at the highest priority of the tasks waiting for it (a
+              FreeRTOS mutex, xSemaphoreCreateMutex())
+  - ceiling : immediate priority ceiling with the system-ceiling check of lib/CeilingMutex.
+              The ceiling of a mutex is the highest priority of the tasks whose scripts
+              take it.
+
+  A scenario is a CSV file (read with lib/TaskSet), times in milliseconds:
+
+    # name,  priority, period, offset, script
+    Task A,  2,        0,      0,      l1 c0.1 s1 l2 c0.1 s500 u2 u1 c0.1 s50
+
+  Script steps are separated by spaces: c<ms> computes, s<ms> sleeps (vTaskDelay), l<n>
+  takes mutex n and u<n> gives it back. A period of 0 runs the script in a loop, like a
+  task's while (1); otherwise a job is released every period from the offset on, and a
+  release that finds the previous job still running is counted as an overrun and skipped.
+
+  For every job the simulator records how long it was blocked by lower priority tasks (a
+  lower priority task ran while it was ready, or it waited for a mutex held by one) and
+  by how many different lower priority critical sections (or, without a mutex, jobs). A
+  wait-for cycle between mutex holders is reported as a deadlock; the tasks in it stop.
+*/
+
+#ifndef LOCK_SIM_H
+#define LOCK_SIM_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+typedef enum LockStepType {
+  LOCK_STEP_COMPUTE,
+  LOCK_STEP_SLEEP,
+  LOCK_STEP_TAKE,
+  LOCK_STEP_GIVE
+} LockStepType;
+
+typedef struct LockStep {
+  LockStepType type;
+  uint64_t us;              // Compute and sleep
+  int mutex;                // Take and give
+} LockStep;
+
+typedef struct LockTask {
+  std::string name;
+  int priority;
+  uint64_t period_us;       // 0 = loop
+  uint64_t offset_us;
+  std::vector<LockStep> script;
+} LockTask;
+
+typedef enum LockProtocol {
+  LOCK_PLAIN,
+  LOCK_INHERIT,
+  LOCK_CEILING
+} LockProtocol;
+
+// Per task results, in the order of the scenario
+typedef struct LockTaskStats {
+  uint32_t jobs;                  // Jobs released
+  uint32_t completed;
+  uint32_t overruns;              // Releases skipped because the last job was still running
+  uint64_t max_response_us;
+  uint64_t max_blocked_us;        // Longest total blocking of one job
+  uint32_t max_blocking_sections; // Most lower priority sections that blocked one job
+} LockTaskStats;
+
+typedef struct LockSimResult {
+  std::vector<LockTaskStats> tasks;
+  std::vector<int> ceilings;      // Per mutex number (0 for numbers not used)
+  uint64_t horizon_us;
+  bool deadlock;
+  uint64_t deadlock_us;           // When the first cycle closed
+  std::vector<int> deadlock_tasks;
+} LockSimResult;
+
+// Read a scenario, returns false with a message in `error` on a bad line
+bool loadLockScenario(const char *path, std::vector<LockTask> &tasks, std::string &error);
+
+// Play the scenario for horizon_us with `protocol`
+void simulateLocks(const std::vector<LockTask> &tasks, LockProtocol protocol,
+                   uint64_t horizon_us, LockSimResult *result);
+
+const char *lockProtocolName(LockProtocol protocol);
+
+#endif
@@ -0,0 +1,147 @@
+/*
+  Discrete-event simulation of one core running a task table
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "SchedSim.h"
+
+#include <deque>
+
+// One released, unfinished job
+typedef struct SimJob {
+  uint64_t release_us;
+  uint64_t deadline_us;       // Absolute
+  uint64_t remaining_us;
+} SimJob;
+
+//*****************************************************************************
+// Helpers
+
+static uint64_t gcd(uint64_t a, uint64_t b) {
+  while (b != 0) {
+    uint64_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// Should the head job of task a run before the head job of task b?
+static bool runsBefore(const TaskSpec &a, const SimJob &job_a,
+                       const TaskSpec &b, const SimJob &job_b) {
+  if (a.priority != b.priority) {
+    return a.priority > b.priority;
+  }
+  if (a.edf && b.edf) {
+    return job_a.deadline_us < job_b.deadline_us;
+  }
+  return job_a.release_us < job_b.release_us;
+}
+
+//*****************************************************************************
+// Public API
+
+uint64_t simHyperperiod(const std::vector<TaskSpec> &tasks, int core) {
+  uint64_t hyperperiod = 1;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i].core != core) {
+      continue;
+    }
+    hyperperiod = hyperperiod / gcd(hyperperiod, tasks[i].period_us) * tasks[i].period_us;
+    if (hyperperiod >= sim_max_horizon_us) {
+      return sim_max_horizon_us;
+    }
+  }
+  return hyperperiod;
+}
+
+void simulateCore(const std::vector<TaskSpec> &tasks, int core, uint64_t horizon_us,
+                  SimResult *result) {
+  std::vector<std::deque<SimJob>> pending(tasks.size());
+  std::vector<uint64_t> next_release(tasks.size(), 0);
+  int running = -1;
+
+  result->tasks.assign(tasks.size(), SimTaskStats());
+  result->horizon_us = (horizon_us != 0) ? horizon_us : simHyperperiod(tasks, core);
+  result->busy_us = 0;
+  result->misses = 0;
+  result->preemptions = 0;
+
+  uint64_t now = 0;
+  while (now < result->horizon_us) {
+
+    // Release every job that is due
+    for (size_t i = 0; i < tasks.size(); i++) {
+      if (tasks[i].core != core) {
+        continue;
+      }
+      while (next_release[i] <= now) {
+        SimJob job = {next_release[i], next_release[i] + tasks[i].deadline_us, tasks[i].wcet_us};
+        pending[i].push_back(job);
+        result->tasks[i].jobs++;
+        next_release[i] += tasks[i].period_us;
+      }
+    }
+
+    // Pick the job to run
+    int next = -1;
+    for (size_t i = 0; i < tasks.size(); i++) {
+      if (pending[i].empty()) {
+        continue;
+      }
+      if (next < 0 || runsBefore(tasks[i], pending[i].front(), tasks[next], pending[next].front())) {
+        next = (int)i;
+      }
+    }
+    if (running >= 0 && next != running && !pending[running].empty()) {
+      result->preemptions++;
+    }
+    running = next;
+
+    // Run it until it finishes, the next release or the horizon, whatever comes first
+    uint64_t until = result->horizon_us;
+    for (size_t i = 0; i < tasks.size(); i++) {
+      if (tasks[i].core == core && next_release[i] < until) {
+        until = next_release[i];
+      }
+    }
+    if (running < 0) {
+      now = until;
+      continue;
+    }
+
+    SimJob &job = pending[running].front();
+    if (now + job.remaining_us < until) {
+      until = now + job.remaining_us;
+    }
+    job.remaining_us -= until - now;
+    result->busy_us += until - now;
+    now = until;
+
+    if (job.remaining_us == 0) {
+      SimTaskStats &stats = result->tasks[running];
+      uint64_t response = now - job.release_us;
+      stats.completed++;
+      if (response > stats.max_response_us) {
+        stats.max_response_us = response;
+      }
+      if (now > job.deadline_us) {
+        stats.misses++;
+        result->misses++;
+      }
+      pending[running].pop_front();
+    }
+  }
+
+  // Jobs still running at the end count as misses if their deadline has passed already
+  for (size_t i = 0; i < tasks.size(); i++) {
+    for (size_t j = 0; j < pending[i].size(); j++) {
+      if (pending[i][j].deadline_us <= now) {
+        result->tasks[i].misses++;
+        result->misses++;
+      }
+    }
+  }
+}
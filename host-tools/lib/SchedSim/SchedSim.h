@@ -0,0 +1,59 @@
+/*
+  Discrete-event simulation of one core running a task table
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Plays a task set (lib/TaskSet) forward in time on one core with preemptive scheduling:
+
+  - the ready job with the highest priority runs
+  - among EDF tasks of the same priority the job with the earliest absolute deadline runs
+    (what lib/EdfScheduler does on the ESP32), other ties go to the earliest release
+
+  Every task releases its first job at time 0 (the critical instant for fixed priorities)
+  and then every period; each job needs exactly its WCET. A job that misses its deadline
+  is counted and still runs to completion. Blocking and jitter are not simulated, use
+  src/rta.cpp for those.
+
+  The default horizon is the hyperperiod (least common multiple of the periods), capped
+  at sim_max_horizon_us. Over a full hyperperiod the result is exact for these task sets.
+
+    SimResult result;
+    simulateCore(tasks, 1, 0, &result);
+    if (result.misses == 0) { ... }
+*/
+
+#ifndef SCHED_SIM_H
+#define SCHED_SIM_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <TaskSet.h>
+
+static const uint64_t sim_max_horizon_us = 60ULL * 1000 * 1000;
+
+// Per task results, in the order of the task table (tasks on other cores stay zero)
+typedef struct SimTaskStats {
+  uint32_t jobs;              // Jobs released
+  uint32_t completed;         // Jobs finished within the horizon
+  uint32_t misses;            // Jobs finished (or still running) after their deadline
+  uint64_t max_response_us;   // Longest release-to-finish time
+} SimTaskStats;
+
+typedef struct SimResult {
+  std::vector<SimTaskStats> tasks;
+  uint64_t horizon_us;
+  uint64_t busy_us;           // Time any job was running
+  uint32_t misses;            // Sum over all tasks
+  uint32_t preemptions;       // Switches away from a job that wasn't finished
+} SimResult;
+
+// Least common multiple of the periods on `core`, capped at sim_max_horizon_us
+uint64_t simHyperperiod(const std::vector<TaskSpec> &tasks, int core);
+
+// Simulate `core` for horizon_us (0 = hyperperiod)
+void simulateCore(const std::vector<TaskSpec> &tasks, int core, uint64_t horizon_us,
+                  SimResult *result);
+
+#endif
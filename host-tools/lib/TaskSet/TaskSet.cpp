@@ -0,0 +1,195 @@
+/*
+  Task tables for the host-side scheduling tools
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2
+*/
+
+#include "TaskSet.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//*****************************************************************************
+// Helpers
+
+static std::string trim(const std::string &text) {
+  size_t start = text.find_first_not_of(" \t\r\n");
+  if (start == std::string::npos) {
+    return "";
+  }
+  size_t end = text.find_last_not_of(" \t\r\n");
+  return text.substr(start, end - start + 1);
+}
+
+// Split one line on commas, drops a trailing comment
+static std::vector<std::string> splitLine(const std::string &line) {
+  std::vector<std::string> fields;
+  std::string text = line.substr(0, line.find('#'));
+
+  if (trim(text).empty()) {
+    return fields;
+  }
+
+  size_t start = 0;
+  while (1) {
+    size_t comma = text.find(',', start);
+    fields.push_back(trim(text.substr(start, comma - start)));
+    if (comma == std::string::npos) {
+      break;
+    }
+    start = comma + 1;
+  }
+  return fields;
+}
+
+static bool parsePolicy(const std::string &text, bool *edf) {
+  if (text == "fp" || text == "edf") {
+    *edf = (text == "edf");
+    return true;
+  }
+  return false;
+}
+
+static bool readLines(const char *path, std::vector<std::string> &lines, std::string &error) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    error = std::string("cannot open ") + path;
+    return false;
+  }
+
+  char buf[512];
+  while (fgets(buf, sizeof(buf), file) != NULL) {
+    lines.push_back(buf);
+  }
+  fclose(file);
+  return true;
+}
+
+//*****************************************************************************
+// Public API
+
+bool readTable(const char *path, std::vector<TableRow> &rows, std::string &error) {
+  std::vector<std::string> lines;
+  if (!readLines(path, lines, error)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    TableRow row;
+    row.line = (int)(i + 1);
+    row.fields = splitLine(lines[i]);
+    if (!row.fields.empty()) {
+      rows.push_back(row);
+    }
+  }
+  return true;
+}
+
+bool tableParseMs(const std::string &text, uint64_t *us) {
+  char *end;
+  double ms = strtod(text.c_str(), &end);
+  if (text.empty() || *end != '\0' || ms < 0) {
+    return false;
+  }
+  *us = (uint64_t)ceil(ms * 1000.0 - 1e-6);
+  return true;
+}
+
+bool tableParseInt(const std::string &text, int *value) {
+  char *end;
+  long number = strtol(text.c_str(), &end, 10);
+  if (text.empty() || *end != '\0') {
+    return false;
+  }
+  *value = (int)number;
+  return true;
+}
+
+bool loadTaskSet(const char *path, std::vector<TaskSpec> &tasks, std::string &error) {
+  std::vector<std::string> lines;
+  if (!readLines(path, lines, error)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    std::vector<std::string> fields = splitLine(lines[i]);
+    if (fields.empty()) {
+      continue;
+    }
+
+    TaskSpec task;
+    bool ok = fields.size() >= 5 && fields.size() <= 9;
+    if (ok) {
+      task.name = fields[0];
+      task.deadline_us = 0;
+      task.blocking_us = 0;
+      task.jitter_us = 0;
+      task.edf = false;
+      ok = tableParseInt(fields[1], &task.core) &&
+           tableParseInt(fields[2], &task.priority) &&
+           tableParseMs(fields[3], &task.period_us) &&
+           tableParseMs(fields[4], &task.wcet_us) &&
+           (fields.size() < 6 || tableParseMs(fields[5], &task.deadline_us)) &&
+           (fields.size() < 7 || tableParseMs(fields[6], &task.blocking_us)) &&
+           (fields.size() < 8 || tableParseMs(fields[7], &task.jitter_us)) &&
+           (fields.size() < 9 || parsePolicy(fields[8], &task.edf)) &&
+           task.period_us > 0;
+    }
+    if (!ok) {
+      char msg[64];
+      snprintf(msg, sizeof(msg), "%s:%u: bad task line", path, (unsigned)(i + 1));
+      error = msg;
+      return false;
+    }
+
+    if (task.deadline_us == 0) {
+      task.deadline_us = task.period_us;
+    }
+    tasks.push_back(task);
+  }
+  return true;
+}
+
+int applyTrace(const char *path, double margin, std::vector<TaskSpec> &tasks,
+               std::string &error) {
+  std::vector<std::string> lines;
+  std::vector<uint64_t> max_us(tasks.size(), 0);
+
+  if (!readLines(path, lines, error)) {
+    return -1;
+  }
+
+  for (size_t i = 0; i < lines.size(); i++) {
+    std::vector<std::string> fields = splitLine(lines[i]);
+    if (fields.empty()) {
+      continue;
+    }
+
+    char *end;
+    unsigned long long sample = (fields.size() == 2) ? strtoull(fields[1].c_str(), &end, 10) : 0;
+    if (fields.size() != 2 || *end != '\0') {
+      char msg[64];
+      snprintf(msg, sizeof(msg), "%s:%u: expected name,exec_us", path, (unsigned)(i + 1));
+      error = msg;
+      return -1;
+    }
+
+    for (size_t t = 0; t < tasks.size(); t++) {
+      if (tasks[t].name == fields[0] && sample > max_us[t]) {
+        max_us[t] = sample;
+      }
+    }
+  }
+
+  int changed = 0;
+  for (size_t t = 0; t < tasks.size(); t++) {
+    uint64_t wcet = (uint64_t)ceil(max_us[t] * margin);
+    if (wcet > tasks[t].wcet_us) {
+      tasks[t].wcet_us = wcet;
+      changed++;
+    }
+  }
+  return changed;
+}
@@ -0,0 +1,73 @@
+/*
+  Task tables for the host-side scheduling tools
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Optional policy column, "edf" puts a task in the earliest-deadline-first
+                band at its priority (see lib/EdfScheduler and src/sched-sim.cpp)
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : The CSV reader is public (readTable(), tableParseMs(), tableParseInt()) for
+                the other table formats of the host tools
+
+  A task set is a CSV file with one periodic task per line. Times are in milliseconds and
+  may have decimals, '#' starts a comment:
+
+    # name,        core, priority, period, wcet, deadline, blocking, jitter, policy
+    Toggle LED,    1,    1,        500,    0.05
+    Task 2,        1,    2,        100,    0.2,  100,      0.1
+    Control,       1,    3,        20,     4,    20,       0,        0,      edf
+
+  deadline defaults to the period, blocking (longest time the task can wait for a mutex
+  held by a lower priority task) and release jitter default to 0. Higher priority numbers
+  win, as in FreeRTOS. policy is "fp" (fixed priority, the default) or "edf": all EDF tasks
+  of one priority form a band in which the earliest absolute deadline runs first.
+
+  WCETs can also be taken from measurements: a trace file has lines "name,exec_us" (one
+  observed execution time each, e.g. PeriodicStats::max_response_us or logged
+  esp_timer_get_time() differences). applyTrace() sets the WCET of every task in the trace
+  to the largest sample times a safety margin, if that is more than the table says.
+*/
+
+#ifndef TASK_SET_H
+#define TASK_SET_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+typedef struct TaskSpec {
+  std::string name;
+  int core;
+  int priority;
+  uint64_t period_us;
+  uint64_t wcet_us;
+  uint64_t deadline_us;
+  uint64_t blocking_us;
+  uint64_t jitter_us;
+  bool edf;                 // Earliest-deadline-first within its priority
+} TaskSpec;
+
+// One non-empty line of a CSV table, comment removed and fields trimmed
+typedef struct TableRow {
+  int line;                 // Line number, for messages
+  std::vector<std::string> fields;
+} TableRow;
+
+// Read every non-empty line of `path`, returns false with a message in `error`
+bool readTable(const char *path, std::vector<TableRow> &rows, std::string &error);
+
+// Milliseconds with decimals to microseconds (rounded up), and plain integers
+bool tableParseMs(const std::string &text, uint64_t *us);
+bool tableParseInt(const std::string &text, int *value);
+
+// Read a task table, returns false with a message in `error` on a bad line
+bool loadTaskSet(const char *path, std::vector<TaskSpec> &tasks, std::string &error);
+
+// Raise WCETs to max(trace sample) * margin, returns the number of tasks changed
+int applyTrace(const char *path, double margin, std::vector<TaskSpec> &tasks,
+               std::string &error);
+
+#endif
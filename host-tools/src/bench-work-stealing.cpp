@@ -0,0 +1,245 @@
+/*
+   Work-stealing benchmark: per-worker deques versus one shared FIFO
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Replays bursty per-message work (like the jobs of 7-semaphore-counting) on the host:
+   every burst of burst_len jobs is submitted from one producer thread, then the producer
+   waits gap_us before the next one. Most jobs are short, some are long. Three schedulers
+   run the same job list:
+
+   - "pinned" : the work-stealing runtime with one worker, i.e. everything on app_cpu
+   - "fifo"   : N workers taking jobs from one mutex-protected FIFO, bounded to
+                WS_DEQUE_CAPACITY jobs like the deque the bursts land on
+   - "steal"  : the work-stealing runtime with N workers; bursts land on worker 0's deque
+                and the others steal half of it at a time
+
+   For each it prints throughput and the latency from the release of the job's burst to
+   the job's finish (p50/p99/p99.9/max), so time the producer spends waiting for room in a
+   full queue counts as well.
+
+   Usage: bench-work-stealing [workers (2)] [bursts (2000)]
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include <WorkStealing.h>
+
+typedef std::chrono::steady_clock Clock;
+
+// Settings
+static const int burst_len = 48;
+static const int64_t gap_us = 400;
+static const int64_t short_job_us = 5;
+static const int64_t long_job_us = 40;
+static const int long_job_percent = 20;
+
+// One job of the trace
+typedef struct BenchJob {
+  int64_t cost_us;
+  Clock::time_point released;     // When its burst was due
+  Clock::time_point finished;
+  JobGroup *group;
+} BenchJob;
+
+// Globals
+static std::vector<BenchJob> jobs;
+
+//*****************************************************************************
+// Job
+
+// Spin instead of sleeping, a job occupies its worker like real work would
+static void spinFor(int64_t us) {
+  Clock::time_point end = Clock::now() + std::chrono::microseconds(us);
+  while (Clock::now() < end) {
+  }
+}
+
+static void benchJob(void *arg) {
+  BenchJob *job = (BenchJob *)arg;
+  spinFor(job->cost_us);
+  job->finished = Clock::now();
+  job->group->done();
+}
+
+//*****************************************************************************
+// Shared FIFO baseline
+
+class SharedFifo {
+public:
+  void begin(int num_workers) {
+    stopping = false;
+    for (int i = 0; i < num_workers; i++) {
+      threads.push_back(std::thread(&SharedFifo::workerLoop, this));
+    }
+  }
+
+  void end() {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stopping = true;
+    }
+    cond.notify_all();
+    for (size_t i = 0; i < threads.size(); i++) {
+      threads[i].join();
+    }
+    threads.clear();
+  }
+
+  // Returns false if the FIFO is full
+  bool submit(WsJobFunction function, void *arg) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (queue.size() >= WS_DEQUE_CAPACITY) {
+        return false;
+      }
+      queue.push_back(WsJob{function, arg});
+    }
+    cond.notify_one();
+    return true;
+  }
+
+private:
+  void workerLoop() {
+    while (1) {
+      WsJob job;
+      {
+        std::unique_lock<std::mutex> guard(mutex);
+        cond.wait(guard, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+          return;
+        }
+        job = queue.front();
+        queue.pop_front();
+      }
+      job.function(job.arg);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::deque<WsJob> queue;
+  std::vector<std::thread> threads;
+  bool stopping = false;
+};
+
+//*****************************************************************************
+// Trace and replay
+
+static void makeTrace(int bursts) {
+  srand(1);
+  jobs.assign((size_t)bursts * burst_len, BenchJob());
+  for (size_t i = 0; i < jobs.size(); i++) {
+    jobs[i].cost_us = (rand() % 100 < long_job_percent) ? long_job_us : short_job_us;
+  }
+}
+
+// `submit` queues one job and returns false if it has to be retried
+template <typename SubmitFunc>
+static double replay(SubmitFunc submit) {
+  JobGroup group;
+  Clock::time_point start = Clock::now();
+  Clock::time_point next_burst = start;
+
+  group.add(jobs.size());
+  for (size_t i = 0; i < jobs.size(); i += burst_len) {
+    while (Clock::now() < next_burst) {
+    }
+    for (size_t j = i; j < i + burst_len; j++) {
+      jobs[j].group = &group;
+      jobs[j].released = next_burst;
+      while (!submit(&jobs[j])) {
+        std::this_thread::yield();
+      }
+    }
+    next_burst += std::chrono::microseconds(gap_us);
+  }
+  group.wait();
+
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static void printResult(const char *name, int num_workers, double seconds) {
+  std::vector<int64_t> latency(jobs.size());
+  for (size_t i = 0; i < jobs.size(); i++) {
+    latency[i] = std::chrono::duration_cast<std::chrono::microseconds>(
+                   jobs[i].finished - jobs[i].released).count();
+  }
+  std::sort(latency.begin(), latency.end());
+
+  size_t n = latency.size();
+  printf("%-8s %7d %10.0f %8lld %8lld %8lld %8lld\n",
+         name,
+         num_workers,
+         n / seconds,
+         (long long)latency[n / 2],
+         (long long)latency[n * 99 / 100],
+         (long long)latency[n * 999 / 1000],
+         (long long)latency[n - 1]);
+}
+
+static void runStealing(const char *name, int num_workers) {
+  WorkStealingRuntime runtime;
+
+  runtime.begin(num_workers);
+  double seconds = replay([&runtime](BenchJob *job) {
+    return runtime.submit(benchJob, job);
+  });
+  runtime.end();
+  printResult(name, num_workers, seconds);
+
+  for (int i = 0; i < num_workers; i++) {
+    WsWorkerStats stats;
+    runtime.getStats(i, &stats);
+    printf("           worker %d: executed %u, steals %u (%u jobs), sleeps %u, max depth %u\n",
+           i,
+           (unsigned)stats.executed,
+           (unsigned)stats.steals,
+           (unsigned)stats.stolen_jobs,
+           (unsigned)stats.sleeps,
+           (unsigned)stats.max_depth);
+  }
+}
+
+static void runFifo(int num_workers) {
+  SharedFifo fifo;
+
+  fifo.begin(num_workers);
+  double seconds = replay([&fifo](BenchJob *job) {
+    return fifo.submit(benchJob, job);
+  });
+  fifo.end();
+  printResult("fifo", num_workers, seconds);
+}
+
+int main(int argc, char **argv) {
+  int num_workers = (argc > 1) ? atoi(argv[1]) : 2;
+  int bursts = (argc > 2) ? atoi(argv[2]) : 2000;
+
+  if (num_workers < 1 || num_workers > WS_MAX_WORKERS || bursts < 1) {
+    fprintf(stderr, "usage: %s [workers 1..%d] [bursts]\n", argv[0], WS_MAX_WORKERS);
+    return 1;
+  }
+
+  makeTrace(bursts);
+  printf("%d bursts of %d jobs every %lld us, %lld/%lld us jobs (%d%% long)\n\n",
+         bursts, burst_len, (long long)gap_us, (long long)short_job_us,
+         (long long)long_job_us, long_job_percent);
+  printf("%-8s %7s %10s %8s %8s %8s %8s\n",
+         "sched", "workers", "jobs/s", "p50 us", "p99 us", "p99.9 us", "max us");
+
+  runStealing("pinned", 1);
+  runFifo(num_workers);
+  runStealing("steal", num_workers);
+  return 0;
+}
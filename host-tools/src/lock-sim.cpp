@@ -0,0 +1,101 @@
+/*
+   Mutex protocol simulator: plain, priority inheritance and priority ceiling
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Runs a scenario (lib/LockSim, the *-locks.csv files in tasksets) once per mutex
+   protocol and prints per task the jobs, overruns, the longest response time, the longest
+   blocking by lower priority tasks and from how many of their critical sections that
+   blocking came. A deadlock is reported with the tasks in the cycle.
+
+   It checks what lib/CeilingMutex promises: with the ceiling protocol there is no
+   deadlock and no job is blocked by more than one lower priority critical section.
+
+   Usage: lock-sim [scenario.csv (tasksets/10-deadlock-locks.csv)] [--horizon ms]
+   Exit code 0 if the ceiling protocol keeps that promise, 1 if not, 2 on bad input.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <LockSim.h>
+
+// Settings
+static const uint64_t default_horizon_us = 5ULL * 1000 * 1000;
+
+//*****************************************************************************
+// Report
+
+// Returns true if there was no deadlock and every job was blocked by one section at most
+static bool printRun(const std::vector<LockTask> &tasks, LockProtocol protocol,
+                     uint64_t horizon_us) {
+  LockSimResult result;
+  bool bounded = true;
+
+  simulateLocks(tasks, protocol, horizon_us, &result);
+
+  printf("  %s\n", lockProtocolName(protocol));
+  for (size_t i = 0; i < tasks.size(); i++) {
+    const LockTaskStats &stats = result.tasks[i];
+    printf("    %-12s %3d %6u jobs %4u overruns   max R %9.3f ms   blocked %9.3f ms by %u\n",
+           tasks[i].name.c_str(), tasks[i].priority, (unsigned)stats.jobs,
+           (unsigned)stats.overruns, stats.max_response_us / 1000.0,
+           stats.max_blocked_us / 1000.0, (unsigned)stats.max_blocking_sections);
+    bounded &= stats.max_blocking_sections <= 1;
+  }
+
+  if (result.deadlock) {
+    printf("    DEADLOCK at %.3f ms:", result.deadlock_us / 1000.0);
+    for (size_t i = 0; i < result.deadlock_tasks.size(); i++) {
+      printf(" %s ->", tasks[result.deadlock_tasks[i]].name.c_str());
+    }
+    printf(" %s\n", tasks[result.deadlock_tasks[0]].name.c_str());
+  }
+  return bounded && !result.deadlock;
+}
+
+int main(int argc, char **argv) {
+  const char *scenario_path = "tasksets/10-deadlock-locks.csv";
+  uint64_t horizon_us = default_horizon_us;
+  std::vector<LockTask> tasks;
+  std::string error;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc) {
+      horizon_us = (uint64_t)(atof(argv[++i]) * 1000);
+    } else if (argv[i][0] != '-') {
+      scenario_path = argv[i];
+    } else {
+      fprintf(stderr, "usage: %s [scenario.csv] [--horizon ms]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (!loadLockScenario(scenario_path, tasks, error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 2;
+  }
+
+  // Ceilings are the same for every protocol
+  LockSimResult result;
+  simulateLocks(tasks, LOCK_PLAIN, 0, &result);
+  printf("%s, %.0f ms\n  ceilings:", scenario_path, horizon_us / 1000.0);
+  for (size_t m = 0; m < result.ceilings.size(); m++) {
+    if (result.ceilings[m] > 0) {
+      printf(" mutex %u = %d", (unsigned)m, result.ceilings[m]);
+    }
+  }
+  printf("\n");
+
+  printRun(tasks, LOCK_PLAIN, horizon_us);
+  printRun(tasks, LOCK_INHERIT, horizon_us);
+  bool ok = printRun(tasks, LOCK_CEILING, horizon_us);
+
+  printf("\nceiling protocol: %s\n",
+         ok ? "no deadlock, blocking bounded by one critical section" : "NOT BOUNDED");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+/*
+   Response-time analysis of fixed-priority task sets
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Reads a task table (see lib/TaskSet/TaskSet.h for the format), optionally raises the WCETs
+   to what a trace measured, and checks per core whether every task meets its deadline
+   under preemptive fixed-priority scheduling. The worst-case response time of task i is
+   the smallest fixed point of
+
+     R = C_i + B_i + sum over j in hep(i) of ceil((R + J_j) / T_j) * C_j
+
+   where hep(i) are the other tasks on the same core with a priority >= i's (tasks of equal
+   priority share the core round-robin in FreeRTOS, so they are counted as interference),
+   B_i is the blocking time and J the release jitter. A task is schedulable if R + J_i <= D_i.
+   EDF tasks (policy "edf") are analysed as plain tasks of their band priority, which is
+   safe but pessimistic, src/sched-sim.cpp simulates the band itself.
+
+   Per task it prints R and the slack D - (R + J). Per core it prints the utilization,
+   the rate-monotonic (Liu & Layland) bound and the headroom: how much all WCETs on that
+   core could grow before the first task misses its deadline.
+
+   Usage: rta [taskset.csv (tasksets/3-task-scheduling.csv)] [--trace trace.csv] [--margin 1.2]
+   Exit code 0 if every task is schedulable, 1 if not, 2 on bad input.
+*/
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <TaskSet.h>
+
+// Settings
+static const double default_margin = 1.2;   // Trace WCET = largest sample * margin
+
+//*****************************************************************************
+// Analysis
+
+// Worst-case response time of tasks[index] with all WCETs scaled by `scale` in *result.
+// Returns false if it grows past the deadline (not schedulable).
+static bool responseTime(const std::vector<TaskSpec> &tasks, size_t index, double scale,
+                         uint64_t *result) {
+  const TaskSpec &task = tasks[index];
+  uint64_t wcet = (uint64_t)ceil(task.wcet_us * scale);
+  uint64_t limit = task.deadline_us > task.jitter_us ? task.deadline_us - task.jitter_us : 0;
+  uint64_t response = wcet + task.blocking_us;
+
+  while (response <= limit) {
+    uint64_t next = wcet + task.blocking_us;
+    for (size_t j = 0; j < tasks.size(); j++) {
+      const TaskSpec &other = tasks[j];
+      if (j == index || other.core != task.core || other.priority < task.priority) {
+        continue;
+      }
+      uint64_t releases = (response + other.jitter_us + other.period_us - 1) / other.period_us;
+      next += releases * (uint64_t)ceil(other.wcet_us * scale);
+    }
+    if (next == response) {
+      *result = response;
+      return true;
+    }
+    response = next;
+  }
+  return false;
+}
+
+static bool coreSchedulable(const std::vector<TaskSpec> &tasks, int core, double scale) {
+  uint64_t response;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i].core == core && !responseTime(tasks, i, scale, &response)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Largest factor all WCETs on `core` can be multiplied with (binary search)
+static double coreHeadroom(const std::vector<TaskSpec> &tasks, int core) {
+  double low = 0.0;
+  double high = 1.0;
+
+  // Bracket the answer: [0, 1] if the set doesn't fit as it is, else [2^k, 2^(k+1)]
+  if (coreSchedulable(tasks, core, 1.0)) {
+    while (high < 1e6 && coreSchedulable(tasks, core, high * 2)) {
+      high *= 2;
+    }
+    low = high;
+    high *= 2;
+  }
+
+  for (int i = 0; i < 40; i++) {
+    double mid = (low + high) / 2;
+    if (coreSchedulable(tasks, core, mid)) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+static double coreUtilization(const std::vector<TaskSpec> &tasks, int core, int *count) {
+  double utilization = 0;
+  *count = 0;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i].core == core) {
+      utilization += (double)tasks[i].wcet_us / tasks[i].period_us;
+      (*count)++;
+    }
+  }
+  return utilization;
+}
+
+//*****************************************************************************
+// Report
+
+static void printCore(const std::vector<TaskSpec> &tasks, int core, bool *all_ok) {
+  int count;
+  double utilization = coreUtilization(tasks, core, &count);
+  double rm_bound = count * (pow(2.0, 1.0 / count) - 1);
+  double headroom = coreHeadroom(tasks, core);
+
+  printf("Core %d: %d task(s), U = %.1f %%, RM bound %.1f %%", core, count,
+         utilization * 100, rm_bound * 100);
+  if (headroom >= 1.0) {
+    printf(", WCETs fit up to x%.2f (U = %.1f %%)\n", headroom, utilization * headroom * 100);
+  } else {
+    printf(", WCETs must shrink to x%.2f to fit\n", headroom);
+  }
+
+  printf("  %-20s %4s %10s %10s %10s %10s %10s %10s  %s\n",
+         "task", "prio", "period ms", "wcet ms", "block ms", "R ms", "D ms", "slack ms", "");
+
+  // Highest priority first
+  std::vector<size_t> order;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i].core == core) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&tasks](size_t a, size_t b) {
+    return tasks[a].priority > tasks[b].priority;
+  });
+
+  for (size_t k = 0; k < order.size(); k++) {
+    const TaskSpec &task = tasks[order[k]];
+    uint64_t response;
+    bool schedulable = responseTime(tasks, order[k], 1.0, &response);
+
+    printf("  %-20s %4d %10.3f %10.3f %10.3f ", task.name.c_str(), task.priority,
+           task.period_us / 1000.0, task.wcet_us / 1000.0, task.blocking_us / 1000.0);
+    if (!schedulable) {
+      printf("%10s %10.3f %10s  MISS\n", "> D", task.deadline_us / 1000.0, "-");
+      *all_ok = false;
+    } else {
+      uint64_t finish = response + task.jitter_us;
+      printf("%10.3f %10.3f %10.3f  ok\n", response / 1000.0, task.deadline_us / 1000.0,
+             (task.deadline_us - finish) / 1000.0);
+    }
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv) {
+  const char *taskset_path = "tasksets/3-task-scheduling.csv";
+  const char *trace_path = NULL;
+  double margin = default_margin;
+  std::vector<TaskSpec> tasks;
+  std::string error;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_path = argv[++i];
+    } else if (strcmp(argv[i], "--margin") == 0 && i + 1 < argc) {
+      margin = atof(argv[++i]);
+    } else if (argv[i][0] != '-') {
+      taskset_path = argv[i];
+    } else {
+      fprintf(stderr, "usage: %s [taskset.csv] [--trace trace.csv] [--margin factor]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  if (!loadTaskSet(taskset_path, tasks, error)) {
+    fprintf(stderr, "%s\n", error.c_str());
+    return 2;
+  }
+  if (trace_path != NULL) {
+    int changed = applyTrace(trace_path, margin, tasks, error);
+    if (changed < 0) {
+      fprintf(stderr, "%s\n", error.c_str());
+      return 2;
+    }
+    printf("%d WCET(s) raised from %s (margin %.2f)\n\n", changed, trace_path, margin);
+  }
+
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i].deadline_us > tasks[i].period_us) {
+      fprintf(stderr, "%s: deadline > period is not supported, using the period\n",
+              tasks[i].name.c_str());
+      tasks[i].deadline_us = tasks[i].period_us;
+    }
+  }
+
+  // Cores in ascending order
+  std::vector<int> cores;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (std::find(cores.begin(), cores.end(), tasks[i].core) == cores.end()) {
+      cores.push_back(tasks[i].core);
+    }
+  }
+  std::sort(cores.begin(), cores.end());
+
+  bool all_ok = true;
+  for (size_t c = 0; c < cores.size(); c++) {
+    printCore(tasks, cores[c], &all_ok);
+  }
+
+  printf("%s\n", all_ok ? "Schedulable" : "NOT schedulable");
+  return all_ok ? 0 : 1;
+}
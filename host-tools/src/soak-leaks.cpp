@@ -0,0 +1,168 @@
+/*
+   Leak soak test of the message path of 4-memory-management-challenge
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   Runs the string hand-off of main_efraim.cpp on the host, with the same block pool
+   (lib/BlockPool, 4 blocks of 255 bytes) and the leak tracker (lib/LeakTracker) enabled:
+
+   - the producer thread takes a block per message, records it with TRACK_ALLOC() and
+     hands it to the consumer through a one-slot mailbox (xTaskNotify() with
+     eSetValueWithoutOverwrite); if the consumer still has a message pending, the block
+     is dropped and given back right away
+   - the consumer thread reads the message, forgets it with TRACK_FREE() and gives the
+     block back to the pool
+
+   After `messages` messages every block must be back: the report of everything allocated
+   since the start must be empty. --leak-every N makes the consumer lose every Nth block,
+   to see what a leak looks like in the report.
+
+   Usage: soak-leaks [messages (1000000)] [--leak-every N]
+   Exit code 0 if nothing leaked, 1 if something did, 2 on bad input.
+*/
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+
+#include <BlockPool.h>
+#include <LeakTracker.h>
+
+#if !LEAK_TRACKER
+  #error "build with -DLEAK_TRACKER=1 (the soak-leaks environment)"
+#endif
+
+// Settings
+static const size_t string_len = 255;
+static const size_t string_pool_len = 4;
+
+// Globals
+static StaticBlockPool<string_len, string_pool_len> string_pool;
+static std::mutex mailbox_mutex;
+static std::condition_variable mailbox_cond;
+static char *mailbox = NULL;                 // Pending message, NULL if none
+static bool producer_done = false;
+static std::atomic<uint32_t> dropped{0};
+static std::atomic<uint32_t> received{0};
+
+//*****************************************************************************
+// Mailbox (the task notification of the sketch)
+
+// False if the consumer still has a message pending
+static bool notify(char *message) {
+  {
+    std::lock_guard<std::mutex> guard(mailbox_mutex);
+    if (mailbox != NULL) {
+      return false;
+    }
+    mailbox = message;
+  }
+  mailbox_cond.notify_one();
+  return true;
+}
+
+// NULL once the producer is done and nothing is pending
+static char *waitNotify() {
+  std::unique_lock<std::mutex> guard(mailbox_mutex);
+  mailbox_cond.wait(guard, [] { return mailbox != NULL || producer_done; });
+  char *message = mailbox;
+  mailbox = NULL;
+  return message;
+}
+
+//*****************************************************************************
+// Threads
+
+static void producer(long messages) {
+  char line[string_len];
+
+  for (long i = 0; i < messages; i++) {
+    int len = snprintf(line, sizeof(line), "message %ld", i);
+
+    char *string_send = (char *)string_pool.alloc();
+    if (string_send == NULL) {
+      dropped++;
+      std::this_thread::yield();
+      continue;
+    }
+    TRACK_ALLOC(string_send, string_len);
+    memcpy(string_send, line, len + 1);
+
+    if (!notify(string_send)) {
+      dropped++;
+      TRACK_FREE(string_send);
+      string_pool.free(string_send);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(mailbox_mutex);
+    producer_done = true;
+  }
+  mailbox_cond.notify_one();
+}
+
+static void consumer(long leak_every) {
+  char *received_string;
+
+  while ((received_string = waitNotify()) != NULL) {
+    uint32_t count = ++received;
+    if (strncmp(received_string, "message ", 8) != 0) {
+      fprintf(stderr, "corrupt message: %.20s\n", received_string);
+    }
+
+    // The leak to look for: this block is never given back
+    if (leak_every > 0 && count % leak_every == 0) {
+      continue;
+    }
+    TRACK_FREE(received_string);
+    string_pool.free(received_string);
+  }
+}
+
+int main(int argc, char **argv) {
+  long messages = 1000000;
+  long leak_every = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--leak-every") == 0 && i + 1 < argc) {
+      leak_every = atol(argv[++i]);
+    } else {
+      messages = atol(argv[i]);
+    }
+  }
+  if (messages < 1 || leak_every < 0) {
+    fprintf(stderr, "usage: %s [messages] [--leak-every N]\n", argv[0]);
+    return 2;
+  }
+
+  uint32_t checkpoint = leakTrackerCheckpoint();
+
+  std::thread consumer_thread(consumer, leak_every);
+  std::thread producer_thread(producer, messages);
+  producer_thread.join();
+  consumer_thread.join();
+
+  LeakTrackerOutput out(stdout);
+  LeakTrackerStats stats;
+  BlockPoolStats pool_stats;
+  leakTrackerGetStats(&stats);
+  string_pool.getStats(&pool_stats);
+
+  printf("%ld messages: %u received, %u dropped, pool %u of %u blocks free\n\n",
+         messages, (unsigned)received, (unsigned)dropped,
+         (unsigned)pool_stats.free_blocks, (unsigned)pool_stats.num_blocks);
+  leakTrackerReport(out, checkpoint);
+
+  if (stats.live_blocks != 0 || stats.dropped_count != 0 || stats.unknown_frees != 0) {
+    printf("\nLEAK: %u block(s) still alive\n", (unsigned)stats.live_blocks);
+    return 1;
+  }
+  printf("\nNo leaks\n");
+  return 0;
+}
@@ -0,0 +1,137 @@
+/*
+   Stress test of the sequence lock (lib/SeqLock)
+
+   Efraim Manurung, 17th October 2026
+   Version 1.0
+
+   One writer thread publishes `writes` versions of a 128-byte record as fast as it can,
+   every word of version v holds v. Reader threads copy it meanwhile, half of them with
+   read() (retries until the copy is clean) and half with tryRead() (one attempt, like an
+   ISR). A copy is torn if its words don't all hold the same version, or if the version
+   went backwards for that reader. Neither may ever happen.
+
+   Per reader it prints the copies made, the attempts that had to be repeated and the
+   newest version seen.
+
+   Usage: stress-seqlock [readers (2)] [writes (2000000)]
+   Exit code 0 if no copy was torn, 1 if one was, 2 on bad input.
+*/
+
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#include <SeqLock.h>
+
+// Settings
+static const int record_words = 32;
+static const int max_readers = 16;
+
+typedef struct Record {
+  uint32_t words[record_words];
+} Record;
+
+// Results of one reader thread, written by that thread only
+typedef struct ReaderResult {
+  uint64_t copies;
+  uint64_t failed;      // tryRead() attempts that gave up
+  uint32_t retries;     // read() attempts that were repeated
+  uint64_t torn;
+  uint32_t newest;
+} ReaderResult;
+
+// Globals
+static Snapshot<Record> record;
+static std::atomic<bool> running{true};
+
+//*****************************************************************************
+// Threads
+
+static void writer(uint32_t writes) {
+  Record next;
+
+  for (uint32_t version = 1; version <= writes; version++) {
+    for (int i = 0; i < record_words; i++) {
+      next.words[i] = version;
+    }
+    record.publish(next);
+  }
+  running = false;
+}
+
+static void reader(ReaderResult *result, bool try_only) {
+  Record copy;
+
+  while (running) {
+    if (try_only) {
+      if (!record.tryRead(&copy)) {
+        result->failed++;
+        continue;
+      }
+    } else {
+      copy = record.read(&result->retries);
+    }
+
+    bool torn = copy.words[0] < result->newest;
+    for (int i = 1; i < record_words && !torn; i++) {
+      torn = copy.words[i] != copy.words[0];
+    }
+    if (torn) {
+      result->torn++;
+    } else {
+      result->newest = copy.words[0];
+    }
+    result->copies++;
+  }
+}
+
+int main(int argc, char **argv) {
+  int num_readers = (argc > 1) ? atoi(argv[1]) : 2;
+  long writes = (argc > 2) ? atol(argv[2]) : 2000000;
+
+  if (num_readers < 1 || num_readers > max_readers || writes < 1) {
+    fprintf(stderr, "usage: %s [readers 1..%d] [writes]\n", argv[0], max_readers);
+    return 2;
+  }
+
+  std::vector<ReaderResult> results(num_readers, ReaderResult());
+  std::vector<std::thread> readers;
+  for (int i = 0; i < num_readers; i++) {
+    readers.push_back(std::thread(reader, &results[i], i % 2 == 1));
+  }
+  std::thread writer_thread(writer, (uint32_t)writes);
+
+  writer_thread.join();
+  for (size_t i = 0; i < readers.size(); i++) {
+    readers[i].join();
+  }
+
+  uint64_t torn = 0;
+  printf("%ld writes of %d bytes, %d reader(s)\n\n", writes, (int)sizeof(Record),
+         num_readers);
+  printf("%-8s %-8s %12s %12s %12s %10s\n",
+         "reader", "mode", "copies", "repeated", "newest", "torn");
+  for (int i = 0; i < num_readers; i++) {
+    const ReaderResult &result = results[i];
+    bool try_only = i % 2 == 1;
+    printf("%-8d %-8s %12llu %12llu %12u %10llu\n",
+           i,
+           try_only ? "tryRead" : "read",
+           (unsigned long long)result.copies,
+           (unsigned long long)(try_only ? result.failed : result.retries),
+           (unsigned)result.newest,
+           (unsigned long long)result.torn);
+    torn += result.torn;
+  }
+  printf("\nVersions published: %u\n", (unsigned)record.version());
+
+  if (torn != 0) {
+    printf("FAILED: %llu torn copies\n", (unsigned long long)torn);
+    return 1;
+  }
+  printf("No torn copies\n");
+  return 0;
+}
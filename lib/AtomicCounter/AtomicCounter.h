@@ -0,0 +1,179 @@
+/*
+  Lock-free counters for tasks and ISRs
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  "counter++" from two tasks, or from a task and an ISR, is a read-modify-write that can
+  lose updates. The lecture demos protect it with a mutex (6-mutex, can't be used from an
+  ISR and may block) or a portMUX spinlock (9-hardware-interrupts, turns interrupts off
+  on the core and spins against the other one). For one 32-bit value neither is needed:
+
+  - AtomicCounter        : a uint32_t changed with one atomic read-modify-write. On the
+                           ESP32 that is a compare-and-swap loop on the S32C1I
+                           instruction, on the host it is std::atomic as usual. Nothing
+                           waits and interrupts stay on.
+  - AtomicAccumulator<T> : the same for any 4-byte T (int32_t, float, ...), add() retries
+                           a compare-and-swap until it wins; also min and max tracking
+  - ShardedCounter       : one AtomicCounter per core, a core only ever touches its own,
+                           so ISRs and tasks on both cores never contend for it.
+                           Reading sums the shards (a consistent total once the
+                           increments have stopped, otherwise a value somewhere between
+                           the totals before and after the read).
+
+    static AtomicCounter isr_counter;
+
+    void IRAM_ATTR onTimer() {
+      isr_counter.increment();                // No critical section around it
+    }
+
+    uint32_t events = isr_counter.load();
+
+  The members are forced inline (like the std::atomic ones they call), so they end up in
+  the IRAM of the ISR that calls them. 64-bit atomics are not lock-free on the ESP32
+  (they take a lock inside libatomic), which is why everything here is 32 bits wide. The
+  same header builds for the host (host-tools/), where ShardedCounter spreads threads
+  over ATOMIC_COUNTER_SHARDS shards.
+*/
+
+#ifndef ATOMIC_COUNTER_H
+#define ATOMIC_COUNTER_H
+
+#include <atomic>
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+
+  #define ATOMIC_COUNTER_SHARDS portNUM_PROCESSORS
+  #define atomicCounterShard() ((unsigned)xPortGetCoreID())
+#else
+  #include <functional>
+  #include <thread>
+
+  #ifndef ATOMIC_COUNTER_SHARDS
+    #define ATOMIC_COUNTER_SHARDS 8
+  #endif
+  #define atomicCounterShard() \
+    ((unsigned)(std::hash<std::thread::id>()(std::this_thread::get_id()) \
+                % ATOMIC_COUNTER_SHARDS))
+#endif
+
+// Inline even without optimization, an ISR in IRAM must not call into flash
+#define ATOMIC_COUNTER_INLINE inline __attribute__((always_inline))
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "32-bit atomics must be lock-free");
+
+class AtomicCounter {
+public:
+
+  // All return the new value
+  ATOMIC_COUNTER_INLINE uint32_t add(uint32_t delta) {
+    return value.fetch_add(delta, std::memory_order_relaxed) + delta;
+  }
+  ATOMIC_COUNTER_INLINE uint32_t sub(uint32_t delta) {
+    return value.fetch_sub(delta, std::memory_order_relaxed) - delta;
+  }
+  ATOMIC_COUNTER_INLINE uint32_t increment() { return add(1); }
+  ATOMIC_COUNTER_INLINE uint32_t decrement() { return sub(1); }
+
+  ATOMIC_COUNTER_INLINE uint32_t load() const {
+    return value.load(std::memory_order_relaxed);
+  }
+  ATOMIC_COUNTER_INLINE void store(uint32_t new_value) {
+    value.store(new_value, std::memory_order_relaxed);
+  }
+
+  // Read and clear in one step (e.g. events since the last report)
+  ATOMIC_COUNTER_INLINE uint32_t exchange(uint32_t new_value) {
+    return value.exchange(new_value, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint32_t> value{0};
+};
+
+template <typename T>
+class AtomicAccumulator {
+public:
+
+  static_assert(sizeof(T) == 4, "only 4-byte values are lock-free on the ESP32");
+
+  // Returns the new sum
+  ATOMIC_COUNTER_INLINE T add(T delta) {
+    T current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, current + delta,
+                                        std::memory_order_relaxed)) {
+    }
+    return current + delta;
+  }
+
+  // Keep the smallest / largest value seen, return true if `sample` replaced it
+  ATOMIC_COUNTER_INLINE bool min(T sample) {
+    T current = value.load(std::memory_order_relaxed);
+    while (sample < current) {
+      if (value.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  ATOMIC_COUNTER_INLINE bool max(T sample) {
+    T current = value.load(std::memory_order_relaxed);
+    while (sample > current) {
+      if (value.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  ATOMIC_COUNTER_INLINE T load() const { return value.load(std::memory_order_relaxed); }
+  ATOMIC_COUNTER_INLINE void store(T new_value) {
+    value.store(new_value, std::memory_order_relaxed);
+  }
+  ATOMIC_COUNTER_INLINE T exchange(T new_value) {
+    return value.exchange(new_value, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<T> value{T()};
+};
+
+class ShardedCounter {
+public:
+
+  // Count on the caller's own shard
+  ATOMIC_COUNTER_INLINE void add(uint32_t delta) {
+    shards[atomicCounterShard()].add(delta);
+  }
+  ATOMIC_COUNTER_INLINE void sub(uint32_t delta) {
+    shards[atomicCounterShard()].sub(delta);
+  }
+  ATOMIC_COUNTER_INLINE void increment() { add(1); }
+  ATOMIC_COUNTER_INLINE void decrement() { sub(1); }
+
+  // Sum of all shards (wraps like a uint32_t)
+  ATOMIC_COUNTER_INLINE uint32_t load() const {
+    uint32_t sum = 0;
+    for (unsigned i = 0; i < ATOMIC_COUNTER_SHARDS; i++) {
+      sum += shards[i].load();
+    }
+    return sum;
+  }
+
+  // Read and clear every shard, the counts of all shards are kept exactly once
+  ATOMIC_COUNTER_INLINE uint32_t exchangeZero() {
+    uint32_t sum = 0;
+    for (unsigned i = 0; i < ATOMIC_COUNTER_SHARDS; i++) {
+      sum += shards[i].exchange(0);
+    }
+    return sum;
+  }
+
+private:
+  AtomicCounter shards[ATOMIC_COUNTER_SHARDS];
+};
+
+#endif
@@ -0,0 +1,139 @@
+/*
+  Fixed-size block pool allocator for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "BlockPool.h"
+
+#if !defined(ESP_PLATFORM) && !defined(ARDUINO_ARCH_ESP32)
+  // Host builds: the same critical sections on the pool's std::mutex, no ISRs
+  #include <assert.h>
+
+  #define portENTER_CRITICAL(mux) (mux)->lock()
+  #define portEXIT_CRITICAL(mux) (mux)->unlock()
+  #define portENTER_CRITICAL_ISR(mux) (mux)->lock()
+  #define portEXIT_CRITICAL_ISR(mux) (mux)->unlock()
+  #define configASSERT(x) assert(x)
+#endif
+
+BlockPool::BlockPool(void *storage, size_t block_size, size_t num_blocks)
+  : pool_start((uint8_t *)storage),
+    block_size(alignedBlockSize(block_size)),
+    num_blocks(num_blocks),
+    free_list(NULL),
+    free_blocks(0),
+    min_free_blocks(num_blocks),
+    alloc_count(0),
+    free_count(0),
+    fail_count(0) {
+
+  pool_end = pool_start + this->block_size * num_blocks;
+
+  // Link all blocks into the free list, lowest address first
+  for (size_t i = num_blocks; i > 0; i--) {
+    FreeBlock *block = (FreeBlock *)(pool_start + (i - 1) * this->block_size);
+    block->next = free_list;
+    free_list = block;
+  }
+  free_blocks = num_blocks;
+}
+
+//*****************************************************************************
+// Free list (must be called with the spinlock held)
+
+void *BlockPool::popBlock() {
+  FreeBlock *block = free_list;
+
+  if (block == NULL) {
+    fail_count++;
+    return NULL;
+  }
+
+  free_list = block->next;
+  free_blocks--;
+  alloc_count++;
+  if (free_blocks < min_free_blocks) {
+    min_free_blocks = free_blocks;
+  }
+  return block;
+}
+
+void BlockPool::pushBlock(void *ptr) {
+  FreeBlock *block = (FreeBlock *)ptr;
+
+  block->next = free_list;
+  free_list = block;
+  free_blocks++;
+  free_count++;
+}
+
+//*****************************************************************************
+// Task and ISR API
+
+void *BlockPool::alloc() {
+  void *block;
+
+  portENTER_CRITICAL(&spinlock);
+  block = popBlock();
+  portEXIT_CRITICAL(&spinlock);
+
+  return block;
+}
+
+void *BlockPool::allocFromISR() {
+  void *block;
+
+  portENTER_CRITICAL_ISR(&spinlock);
+  block = popBlock();
+  portEXIT_CRITICAL_ISR(&spinlock);
+
+  return block;
+}
+
+void BlockPool::free(void *block) {
+  if (block == NULL) {
+    return;
+  }
+
+  // Catch blocks from another pool (or from the heap) before they corrupt the list
+  configASSERT(owns(block));
+
+  portENTER_CRITICAL(&spinlock);
+  pushBlock(block);
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void BlockPool::freeFromISR(void *block) {
+  if (block == NULL) {
+    return;
+  }
+
+  configASSERT(owns(block));
+
+  portENTER_CRITICAL_ISR(&spinlock);
+  pushBlock(block);
+  portEXIT_CRITICAL_ISR(&spinlock);
+}
+
+bool BlockPool::owns(const void *ptr) const {
+  const uint8_t *p = (const uint8_t *)ptr;
+
+  if (p < pool_start || p >= pool_end) {
+    return false;
+  }
+  return ((size_t)(p - pool_start) % block_size) == 0;
+}
+
+void BlockPool::getStats(BlockPoolStats *stats) {
+  portENTER_CRITICAL(&spinlock);
+  stats->block_size = block_size;
+  stats->num_blocks = num_blocks;
+  stats->free_blocks = free_blocks;
+  stats->min_free_blocks = min_free_blocks;
+  stats->alloc_count = alloc_count;
+  stats->free_count = free_count;
+  stats->fail_count = fail_count;
+  portEXIT_CRITICAL(&spinlock);
+}
@@ -0,0 +1,120 @@
+/*
+  Fixed-size block pool allocator for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  pvPortMalloc() walks the heap to find a fitting free region, so its run time depends on
+  how fragmented the heap is, and freeing many differently sized buffers slowly chops the
+  heap into pieces. A block pool avoids both: all blocks have the same size and are carved
+  out of one buffer at start-up. Free blocks are kept in a singly linked list (the link is
+  stored inside the free block itself), so alloc() pops the head and free() pushes it back.
+  Both are O(1) and never touch the system heap.
+
+  Every pool has its own spinlock, so the same pool can be shared between tasks on both
+  cores and ISRs (use the *FromISR() variants inside an ISR). The same code builds for
+  host programs (host-tools/), where the spinlock is a std::mutex.
+
+  Example:
+    static StaticBlockPool<255, 4> msg_pool;   // 4 blocks of 255 bytes
+
+    char *buf = (char *)msg_pool.alloc();      // NULL if the pool is empty
+    ...
+    msg_pool.free(buf);
+*/
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  #include <Arduino.h>
+#else
+  #include <mutex>
+  #include <stddef.h>
+  #include <stdint.h>
+#endif
+
+// Per-pool statistics (see BlockPool::getStats())
+typedef struct BlockPoolStats {
+  size_t block_size;        // Usable bytes per block (rounded up to pointer alignment)
+  size_t num_blocks;        // Total number of blocks in the pool
+  size_t free_blocks;       // Blocks currently available
+  size_t min_free_blocks;   // Lowest number of free blocks ever seen (low-water mark)
+  uint32_t alloc_count;     // Successful allocations
+  uint32_t free_count;      // Blocks returned to the pool
+  uint32_t fail_count;      // Allocations that failed because the pool was empty
+} BlockPoolStats;
+
+class BlockPool {
+public:
+
+  // Carve `storage` into `num_blocks` blocks of `block_size` bytes. The storage must be at
+  // least BlockPool::storageSize(block_size, num_blocks) bytes and pointer aligned.
+  BlockPool(void *storage, size_t block_size, size_t num_blocks);
+
+  // Take a block from the pool, returns NULL if the pool is empty (never blocks)
+  void *alloc();
+  void *allocFromISR();
+
+  // Give a block back to the pool (NULL is ignored, like vPortFree())
+  void free(void *block);
+  void freeFromISR(void *block);
+
+  // True if `ptr` points to the start of one of this pool's blocks
+  bool owns(const void *ptr) const;
+
+  size_t blockSize() const { return block_size; }
+  size_t freeBlocks() const { return free_blocks; }
+  void getStats(BlockPoolStats *stats);
+
+  // Bytes of storage needed for a pool with the given geometry
+  static constexpr size_t alignedBlockSize(size_t size) {
+    return (size < sizeof(void *)) ? sizeof(void *)
+                                   : (size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+  }
+  static constexpr size_t storageSize(size_t block_size, size_t num_blocks) {
+    return alignedBlockSize(block_size) * num_blocks;
+  }
+
+private:
+
+  // A free block stores the link to the next free block in its first bytes
+  typedef struct FreeBlock {
+    struct FreeBlock *next;
+  } FreeBlock;
+
+  void *popBlock();
+  void pushBlock(void *block);
+
+  uint8_t *pool_start;
+  uint8_t *pool_end;
+  size_t block_size;
+  size_t num_blocks;
+  FreeBlock *free_list;
+  volatile size_t free_blocks;
+  size_t min_free_blocks;
+  uint32_t alloc_count;
+  uint32_t free_count;
+  uint32_t fail_count;
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+#else
+  std::mutex spinlock;
+#endif
+};
+
+// Storage holder, kept as a separate base so it exists before BlockPool links the blocks
+template <size_t BlockSize, size_t NumBlocks>
+struct BlockPoolStorage {
+  void *storage[BlockPool::storageSize(BlockSize, NumBlocks) / sizeof(void *)];
+};
+
+// Block pool with its storage declared at compile time (shows up in .bss at link time)
+template <size_t BlockSize, size_t NumBlocks>
+class StaticBlockPool : private BlockPoolStorage<BlockSize, NumBlocks>, public BlockPool {
+public:
+  StaticBlockPool()
+    : BlockPool(this->storage, BlockSize, NumBlocks) {}
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*
+  Immediate priority-ceiling mutex for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "CeilingMutex.h"
+
+#include <esp_timer.h>
+
+CeilingMutex *CeilingMutex::held_list = NULL;
+portMUX_TYPE CeilingMutex::list_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+//*****************************************************************************
+// Held list (call with list_spinlock taken)
+
+CeilingMutex *CeilingMutex::blockerFor(TaskHandle_t task, UBaseType_t priority) {
+  CeilingMutex *blocker = NULL;
+
+  for (CeilingMutex *m = held_list; m != NULL; m = m->next_held) {
+    if (m->owner_task != task && m->ceiling_priority >= priority &&
+        (blocker == NULL || m->ceiling_priority > blocker->ceiling_priority)) {
+      blocker = m;
+    }
+  }
+  return blocker;
+}
+
+bool CeilingMutex::highestHeld(TaskHandle_t task, UBaseType_t *ceiling,
+                               UBaseType_t *base_priority) {
+  bool found = false;
+
+  for (CeilingMutex *m = held_list; m != NULL; m = m->next_held) {
+    if (m->owner_task != task) {
+      continue;
+    }
+    if (!found || m->ceiling_priority > *ceiling) {
+      *ceiling = m->ceiling_priority;
+    }
+    *base_priority = m->owner_base_priority;
+    found = true;
+  }
+  return found;
+}
+
+//*****************************************************************************
+// Public API
+
+bool CeilingMutex::begin(UBaseType_t ceiling) {
+  configASSERT(ceiling < configMAX_PRIORITIES);
+
+  // Create the mutex on first use
+  if (mutex == NULL) {
+    mutex = mutex_storage.create();
+    if (mutex == NULL) {
+      return false;
+    }
+  }
+
+  ceiling_priority = ceiling;
+  portENTER_CRITICAL(&spinlock);
+  stats = {};
+  stats.ceiling = ceiling;
+  portEXIT_CRITICAL(&spinlock);
+  return true;
+}
+
+bool CeilingMutex::take(TickType_t timeout) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  TimeOut_t time_out;
+  int64_t start_us = 0;
+  bool waited = false;
+
+  configASSERT(mutex != NULL && owner_task != self);
+  vTaskSetTimeOutState(&time_out);
+
+  while (1) {
+    UBaseType_t priority = uxTaskPriorityGet(NULL);
+    UBaseType_t held_ceiling = 0;
+    UBaseType_t base_priority = priority;
+
+    portENTER_CRITICAL(&list_spinlock);
+    CeilingMutex *blocker = blockerFor(self, priority);
+    if (blocker == NULL) {
+
+      // Nobody else holds a ceiling at our priority or above, so this mutex is free too
+      highestHeld(self, &held_ceiling, &base_priority);
+      configASSERT(base_priority <= ceiling_priority);
+      owner_task = self;
+      owner_base_priority = base_priority;
+      next_held = held_list;
+      held_list = this;
+      portEXIT_CRITICAL(&list_spinlock);
+
+      xSemaphoreTake(mutex, portMAX_DELAY);
+      if (ceiling_priority > priority) {
+        vTaskPrioritySet(NULL, ceiling_priority);
+      }
+
+      portENTER_CRITICAL(&spinlock);
+      stats.takes++;
+      if (waited) {
+        uint32_t wait_us = (uint32_t)(esp_timer_get_time() - start_us);
+        stats.ceiling_waits++;
+        if (wait_us > stats.max_wait_us) {
+          stats.max_wait_us = wait_us;
+        }
+      }
+      portEXIT_CRITICAL(&spinlock);
+      return true;
+    }
+    SemaphoreHandle_t holder_mutex = blocker->mutex;
+    portEXIT_CRITICAL(&list_spinlock);
+
+    // Wait until the critical section that blocks us has ended, then look again
+    if (!waited) {
+      waited = true;
+      start_us = esp_timer_get_time();
+    }
+    if (xSemaphoreTake(holder_mutex, timeout) == pdTRUE) {
+      xSemaphoreGive(holder_mutex);
+    }
+    if (xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE) {
+      portENTER_CRITICAL(&spinlock);
+      stats.timeouts++;
+      portEXIT_CRITICAL(&spinlock);
+      return false;
+    }
+  }
+}
+
+void CeilingMutex::give() {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  UBaseType_t held_ceiling = 0;
+  UBaseType_t base_priority = 0;
+  UBaseType_t restore;
+
+  configASSERT(owner_task == self);
+
+  portENTER_CRITICAL(&list_spinlock);
+  for (CeilingMutex **link = &held_list; *link != NULL; link = &(*link)->next_held) {
+    if (*link == this) {
+      *link = next_held;
+      break;
+    }
+  }
+  next_held = NULL;
+  owner_task = NULL;
+
+  // Drop to the highest ceiling still held, or to the priority before the first one
+  restore = owner_base_priority;
+  if (highestHeld(self, &held_ceiling, &base_priority) && held_ceiling > restore) {
+    restore = held_ceiling;
+  }
+  portEXIT_CRITICAL(&list_spinlock);
+
+  xSemaphoreGive(mutex);
+  vTaskPrioritySet(NULL, restore);
+}
+
+void CeilingMutex::getStats(CeilingMutexStats *out) {
+  portENTER_CRITICAL(&spinlock);
+  *out = stats;
+  portEXIT_CRITICAL(&spinlock);
+}
@@ -0,0 +1,102 @@
+/*
+  Immediate priority-ceiling mutex for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A FreeRTOS mutex only has priority inheritance: the holder is raised once a higher
+  priority task is already waiting. That still allows chained blocking (a task that needs
+  two mutexes can wait for two lower priority critical sections in a row) and deadlock
+  when two tasks take the same mutexes in opposite order (10-deadlocks-and-starvation).
+
+  A CeilingMutex is declared with a ceiling, the highest priority of any task that will
+  ever take it. Taking it:
+
+  - waits while another task holds a ceiling mutex whose ceiling is not below the caller's
+    priority (the "system ceiling")
+  - then raises the caller to the ceiling right away, until it gives the mutex back
+
+  A task that has started can therefore be blocked by at most one lower priority
+  critical section, and two tasks can never each hold a mutex the other one needs, so
+  the mutex_1/mutex_2 deadlock cannot happen. This holds even when a task sleeps while
+  it holds the mutex, which a plain boost to the ceiling would not cover.
+
+    static CeilingMutex mutex_1;
+    static CeilingMutex mutex_2;
+
+    mutex_1.begin(2);                 // Task A (priority 2) and Task B (priority 1)
+    mutex_2.begin(2);
+
+    mutex_1.take(portMAX_DELAY);      // Runs at priority 2 from here
+    mutex_2.take(portMAX_DELAY);
+    ...
+    mutex_2.give();
+    mutex_1.give();                   // Back to the task's own priority
+
+  That makes the blocking column of a host-tools task table simply the longest critical
+  section of a lower priority task on a mutex whose ceiling reaches the task's priority.
+  host-tools/src/lock-sim.cpp replays the deadlock and chained blocking cases with plain,
+  inheriting and ceiling mutexes. Not recursive; a task must not call take() on a mutex
+  it holds or with a priority above the ceiling. Tasks on both cores share one system
+  ceiling. The underlying mutex comes from lib/StaticAlloc (static in
+  USE_STATIC_ALLOCATION builds).
+*/
+
+#ifndef CEILING_MUTEX_H
+#define CEILING_MUTEX_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+// Counters since begin()
+typedef struct CeilingMutexStats {
+  UBaseType_t ceiling;
+  uint32_t takes;             // Successful take() calls
+  uint32_t ceiling_waits;     // Takes that had to wait for another task's critical section
+  uint32_t timeouts;          // Takes that gave up
+  uint32_t max_wait_us;       // Longest time a take() waited
+} CeilingMutexStats;
+
+class CeilingMutex {
+public:
+
+  // Create the mutex with the highest priority of its users, returns false if it could
+  // not be created
+  bool begin(UBaseType_t ceiling);
+
+  // Take the mutex and run at the ceiling, returns false on timeout
+  bool take(TickType_t timeout);
+
+  // Give it back, the caller drops to the highest ceiling it still holds (or its own
+  // priority). Mutexes may be given in any order.
+  void give();
+
+  UBaseType_t ceiling() const { return ceiling_priority; }
+  TaskHandle_t owner() const { return owner_task; }
+
+  void getStats(CeilingMutexStats *stats);
+
+private:
+
+  // Highest-ceiling mutex held by a task other than `task` with a ceiling >= `priority`
+  static CeilingMutex *blockerFor(TaskHandle_t task, UBaseType_t priority);
+
+  // Highest ceiling `task` holds and its priority before the first of them, returns false
+  // if it holds none
+  static bool highestHeld(TaskHandle_t task, UBaseType_t *ceiling,
+                          UBaseType_t *base_priority);
+
+  static CeilingMutex *held_list;       // Mutexes held right now, linked by next_held
+  static portMUX_TYPE list_spinlock;
+
+  MutexStorage mutex_storage;
+  SemaphoreHandle_t mutex = NULL;
+  UBaseType_t ceiling_priority = 0;
+  TaskHandle_t owner_task = NULL;
+  UBaseType_t owner_base_priority = 0;
+  CeilingMutex *next_held = NULL;
+  CeilingMutexStats stats = {};
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif
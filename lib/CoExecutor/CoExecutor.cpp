@@ -0,0 +1,177 @@
+/*
+  C++20 coroutines on one FreeRTOS task with frames from a block pool
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "CoExecutor.h"
+
+CoExecutor *CoExecutor::executor = NULL;
+
+// Tick comparison that survives the tick counter wrapping around
+static inline bool tickReached(TickType_t now, TickType_t when) {
+  return (int32_t)(now - when) >= 0;
+}
+
+//*****************************************************************************
+// Frames
+
+void *CoTask::promise_type::operator new(size_t size) noexcept {
+  CoExecutor *ex = CoExecutor::executor;
+  configASSERT(ex != NULL);
+
+  if (size > ex->stats.max_frame_request) {
+    ex->stats.max_frame_request = size;
+  }
+  void *frame = (size <= ex->frame_pool->blockSize()) ? ex->frame_pool->alloc() : NULL;
+  if (frame == NULL) {
+    ex->stats.failed_spawns++;
+  }
+  return frame;
+}
+
+void CoTask::promise_type::operator delete(void *frame) {
+  CoExecutor::executor->frame_pool->free(frame);
+}
+
+//*****************************************************************************
+// Executor
+
+void CoExecutor::attach(BlockPool *pool) {
+  configASSERT(executor == NULL);
+
+  frame_pool = pool;
+  stats.frame_size = pool->blockSize();
+  executor = this;
+}
+
+bool CoExecutor::spawn(CoTask &&task) {
+  if (!task.valid()) {
+    return false;
+  }
+
+  ready(&task.release().promise());
+  stats.spawn_count++;
+  stats.live_coroutines++;
+  if (stats.live_coroutines > stats.max_live_coroutines) {
+    stats.max_live_coroutines = stats.live_coroutines;
+  }
+  return true;
+}
+
+void CoExecutor::ready(CoTask::promise_type *promise) {
+  promise->next = nullptr;
+  if (ready_tail == nullptr) {
+    ready_head = promise;
+  } else {
+    ready_tail->next = promise;
+  }
+  ready_tail = promise;
+}
+
+void CoExecutor::sleepUntil(CoTask::promise_type *promise, TickType_t wake_tick) {
+  TickType_t now = xTaskGetTickCount();
+  promise->wake_tick = wake_tick;
+
+  // Keep the list sorted, equal wake ticks in the order they came in
+  CoTask::promise_type **link = &timers;
+  while (*link != nullptr && (int32_t)((*link)->wake_tick - now) <= (int32_t)(wake_tick - now)) {
+    link = &(*link)->next;
+  }
+  promise->next = *link;
+  *link = promise;
+}
+
+void CoExecutor::pollUntil(CoTask::promise_type *promise, CoPollFunction poll, void *arg) {
+  promise->poll = poll;
+  promise->poll_arg = arg;
+  promise->next = pollers;
+  pollers = promise;
+}
+
+void CoExecutor::resume(CoTask::promise_type *promise) {
+  CoTask::Handle handle = CoTask::Handle::from_promise(*promise);
+
+  stats.resume_count++;
+  handle.resume();
+  if (handle.done()) {
+    handle.destroy();
+    stats.live_coroutines--;
+  }
+}
+
+void CoExecutor::checkPollers() {
+  CoTask::promise_type **link = &pollers;
+
+  while (*link != nullptr) {
+    CoTask::promise_type *promise = *link;
+    if (promise->poll(promise->poll_arg)) {
+      *link = promise->next;
+      ready(promise);
+    } else {
+      link = &promise->next;
+    }
+  }
+}
+
+void CoExecutor::run() {
+  task = xTaskGetCurrentTaskHandle();
+
+  while (1) {
+
+    // Expired timers, then satisfied polls become ready
+    TickType_t now = xTaskGetTickCount();
+    while (timers != nullptr && tickReached(now, timers->wake_tick)) {
+      CoTask::promise_type *promise = timers;
+      timers = promise->next;
+      ready(promise);
+    }
+    checkPollers();
+
+    // Run what is ready now; coroutines readied meanwhile go in the next round, after
+    // timers and polls had another look
+    CoTask::promise_type *batch = ready_head;
+    ready_head = ready_tail = nullptr;
+    while (batch != nullptr) {
+      CoTask::promise_type *promise = batch;
+      batch = promise->next;
+      resume(promise);
+    }
+    if (ready_head != nullptr) {
+      continue;
+    }
+
+    // Sleep until the next timer, one tick while somebody polls, or a wake()
+    TickType_t timeout = portMAX_DELAY;
+    if (timers != nullptr) {
+      now = xTaskGetTickCount();
+      timeout = tickReached(now, timers->wake_tick) ? 0 : timers->wake_tick - now;
+    }
+    if (pollers != nullptr && timeout > 1) {
+      timeout = 1;
+    }
+    if (timeout > 0) {
+      ulTaskNotifyTake(pdTRUE, timeout);
+      stats.wake_count++;
+    }
+  }
+}
+
+void CoExecutor::wake() {
+  if (task != NULL) {
+    xTaskNotifyGive(task);
+  }
+}
+
+void CoExecutor::wakeFromISR(BaseType_t *higher_priority_task_woken) {
+  if (task != NULL) {
+    vTaskNotifyGiveFromISR(task, higher_priority_task_woken);
+  }
+}
+
+void CoExecutor::getStats(CoExecutorStats *out) {
+
+  // Only the executor task writes the counters, a torn read is off by one at most
+  *out = stats;
+}
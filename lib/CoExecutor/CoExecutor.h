@@ -0,0 +1,366 @@
+/*
+  C++20 coroutines on one FreeRTOS task with frames from a block pool
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Small state machines like a blinking LED or a serial command reader spend nearly all
+  their time waiting, yet each one gets its own task with a 1-2 KB stack. Written as C++20
+  coroutines they can all share one task: a coroutine keeps only the variables that live
+  across a co_await in a heap-like frame (typically a few dozen bytes), and the executor
+  resumes whichever coroutine's wait is over.
+
+  Example:
+    static StaticCoExecutor<192, 8> executor;   // Up to 8 frames of 192 bytes
+
+    CoTask blink() {
+      while (1) {
+        digitalWrite(led_pin, !digitalRead(led_pin));
+        co_await coDelay(500ms);
+      }
+    }
+
+    void coroutineTask(void *parameters) {
+      executor.spawn(blink());
+      executor.run();                           // Never returns
+    }
+
+  Things a coroutine can wait for:
+
+  - coDelay(ticks) or coDelay(500ms)  : time, on the FreeRTOS tick
+  - coYield()                          : let the other ready coroutines run first
+  - queue.receive() / queue.send(item) : a CoQueue shared between coroutines
+  - coReceive(queue_handle, &item)     : a FreeRTOS queue filled by a normal task or ISR
+  - coUntil(function, arg)             : any condition, e.g. Serial.available() > 0
+
+  The last two are polled once per tick while somebody waits for them, so the executor
+  task then wakes every tick; wake() from another task or ISR makes it look right away.
+
+  Frames come from the executor's block pool, never from the heap. A coroutine whose frame
+  is larger than the block size, or that finds the pool empty, is not started: spawn()
+  returns false and CoExecutorStats::failed_spawns counts it. There is one executor per
+  program, and coroutines (including CoQueue) may only be used from its task.
+
+  Needs C++20 (GCC 10 or newer with -std=gnu++20), see the -coroutines environment of
+  5-queue-challenge.
+*/
+
+#ifndef CO_EXECUTOR_H
+#define CO_EXECUTOR_H
+
+#if __cplusplus < 202002L
+  #error "CoExecutor needs C++20 coroutines (-std=gnu++20, GCC 10 or newer)"
+#endif
+
+#include <Arduino.h>
+#include <BlockPool.h>
+#include <PreciseDelay.h>
+
+#include <chrono>
+#include <coroutine>
+
+// Executor statistics (see CoExecutor::getStats())
+typedef struct CoExecutorStats {
+  size_t frame_size;          // Bytes per frame block
+  size_t live_coroutines;     // Spawned and not finished
+  size_t max_live_coroutines;
+  size_t max_frame_request;   // Largest frame the compiler asked for
+  uint32_t spawn_count;
+  uint32_t failed_spawns;     // Frame too large or pool empty
+  uint32_t resume_count;      // Coroutine resumptions
+  uint32_t wake_count;        // Times the executor task woke up
+} CoExecutorStats;
+
+// Condition for coUntil(), called from the executor task
+typedef bool (*CoPollFunction)(void *arg);
+
+//*****************************************************************************
+// Coroutine type
+
+class CoTask {
+public:
+
+  struct promise_type {
+    CoTask get_return_object() {
+      return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    static CoTask get_return_object_on_allocation_failure() { return CoTask(); }
+
+    // Created suspended, started by spawn(); the executor frees the frame at the end
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { abort(); }
+
+    static void *operator new(size_t size) noexcept;
+    static void operator delete(void *frame);
+
+    // Scheduling state, owned by the executor
+    promise_type *next = nullptr;
+    TickType_t wake_tick = 0;
+    CoPollFunction poll = nullptr;
+    void *poll_arg = nullptr;
+  };
+
+  typedef std::coroutine_handle<promise_type> Handle;
+
+  CoTask() = default;
+  CoTask(CoTask &&other) : handle(other.handle) { other.handle = nullptr; }
+  CoTask(const CoTask &) = delete;
+  CoTask &operator=(const CoTask &) = delete;
+  ~CoTask() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  // False if the frame could not be allocated
+  bool valid() const { return (bool)handle; }
+
+private:
+  friend class CoExecutor;
+
+  explicit CoTask(Handle h) : handle(h) {}
+  Handle release() {
+    Handle h = handle;
+    handle = nullptr;
+    return h;
+  }
+
+  Handle handle = nullptr;
+};
+
+//*****************************************************************************
+// Executor
+
+class CoExecutor {
+public:
+
+  // Start a coroutine (it runs once run() gets to it), false if it has no frame
+  bool spawn(CoTask &&task);
+
+  // Run the coroutines in the calling task, never returns
+  void run();
+
+  // Make the executor check its polled waits now (from another task or an ISR)
+  void wake();
+  void wakeFromISR(BaseType_t *higher_priority_task_woken);
+
+  void getStats(CoExecutorStats *stats);
+
+  // The executor of this program (NULL before one is constructed)
+  static CoExecutor *instance() { return executor; }
+
+  // Used by the awaitables below
+  void ready(CoTask::promise_type *promise);
+  void sleepUntil(CoTask::promise_type *promise, TickType_t wake_tick);
+  void pollUntil(CoTask::promise_type *promise, CoPollFunction poll, void *arg);
+
+protected:
+  CoExecutor() = default;
+
+  // Called by StaticCoExecutor once its pool exists
+  void attach(BlockPool *pool);
+
+private:
+  friend struct CoTask::promise_type;
+
+  void resume(CoTask::promise_type *promise);
+  void checkPollers();
+
+  static CoExecutor *executor;
+
+  BlockPool *frame_pool = NULL;
+  TaskHandle_t task = NULL;
+  CoTask::promise_type *ready_head = nullptr;   // FIFO
+  CoTask::promise_type *ready_tail = nullptr;
+  CoTask::promise_type *timers = nullptr;       // Sorted by wake_tick
+  CoTask::promise_type *pollers = nullptr;
+  CoExecutorStats stats = {};
+};
+
+// Executor with its frame pool declared at compile time
+template <size_t FrameSize, size_t NumFrames>
+class StaticCoExecutor : public CoExecutor {
+public:
+  StaticCoExecutor() { attach(&pool); }
+
+private:
+  StaticBlockPool<FrameSize, NumFrames> pool;
+};
+
+//*****************************************************************************
+// Awaitables
+
+struct CoDelayAwaiter {
+  TickType_t ticks;
+
+  bool await_ready() const { return false; }
+  void await_suspend(CoTask::Handle h) {
+    CoExecutor::instance()->sleepUntil(&h.promise(), xTaskGetTickCount() + ticks);
+  }
+  void await_resume() {}
+};
+
+struct CoPollAwaiter {
+  CoPollFunction poll;
+  void *arg;
+
+  bool await_ready() { return poll(arg); }
+  void await_suspend(CoTask::Handle h) {
+    CoExecutor::instance()->pollUntil(&h.promise(), poll, arg);
+  }
+  void await_resume() {}
+};
+
+struct CoYieldAwaiter {
+  bool await_ready() const { return false; }
+  void await_suspend(CoTask::Handle h) { CoExecutor::instance()->ready(&h.promise()); }
+  void await_resume() {}
+};
+
+// Sleep for at least `ticks` (0 still lets the other coroutines run)
+inline CoDelayAwaiter coDelay(TickType_t ticks) {
+  return CoDelayAwaiter{ticks};
+}
+
+// Sleep for at least `duration`, e.g. coDelay(500ms), rounded up to whole ticks
+template <typename Rep, typename Period>
+inline CoDelayAwaiter coDelay(std::chrono::duration<Rep, Period> duration) {
+  uint32_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  return CoDelayAwaiter{usToTicksCeil(us)};
+}
+
+inline CoYieldAwaiter coYield() {
+  return CoYieldAwaiter{};
+}
+
+// Wait until poll(arg) returns true
+inline CoPollAwaiter coUntil(CoPollFunction poll, void *arg = NULL) {
+  return CoPollAwaiter{poll, arg};
+}
+
+// Wait for an item on a FreeRTOS queue filled by a task or ISR, copied to `item`
+struct CoQueueReceive {
+  QueueHandle_t queue;
+  void *item;
+};
+
+inline bool coQueueHasItem(void *arg) {
+  CoQueueReceive *receive = (CoQueueReceive *)arg;
+  return xQueueReceive(receive->queue, receive->item, 0) == pdTRUE;
+}
+
+struct CoReceiveAwaiter {
+  CoQueueReceive receive;
+
+  bool await_ready() { return coQueueHasItem(&receive); }
+  void await_suspend(CoTask::Handle h) {
+    CoExecutor::instance()->pollUntil(&h.promise(), coQueueHasItem, &receive);
+  }
+  void await_resume() {}
+};
+
+inline CoReceiveAwaiter coReceive(QueueHandle_t queue, void *item) {
+  return CoReceiveAwaiter{{queue, item}};
+}
+
+//*****************************************************************************
+// Queue between coroutines of the executor (no locks, no kernel object)
+
+template <typename T, size_t Length>
+class CoQueue {
+public:
+
+  // Put `item` in the queue (or straight into a waiting receiver), false if it is full
+  bool trySend(const T &item) {
+    if (receivers != nullptr) {
+      Waiter *waiter = receivers;
+      receivers = waiter->next;
+      waiter->item = item;
+      CoExecutor::instance()->ready(waiter->promise);
+      return true;
+    }
+    if (count == Length) {
+      return false;
+    }
+    items[(head + count) % Length] = item;
+    count++;
+    return true;
+  }
+
+  bool tryReceive(T *item) {
+    if (count == 0) {
+      return false;
+    }
+    *item = items[head];
+    head = (head + 1) % Length;
+    count--;
+
+    // A sender waiting for room can put its item in now
+    if (senders != nullptr) {
+      Waiter *waiter = senders;
+      senders = waiter->next;
+      items[(head + count) % Length] = waiter->item;
+      count++;
+      CoExecutor::instance()->ready(waiter->promise);
+    }
+    return true;
+  }
+
+  size_t size() const { return count; }
+
+  struct Waiter {
+    CoTask::promise_type *promise;
+    Waiter *next;
+    T item;
+  };
+
+  // co_await queue.receive() gives the next item, waiting until there is one
+  struct ReceiveAwaiter {
+    CoQueue *queue;
+    Waiter waiter;
+
+    bool await_ready() { return queue->tryReceive(&waiter.item); }
+    void await_suspend(CoTask::Handle h) {
+      waiter.promise = &h.promise();
+      queue->append(&queue->receivers, &waiter);
+    }
+    T await_resume() { return waiter.item; }
+  };
+
+  // co_await queue.send(item) waits until there is room
+  struct SendAwaiter {
+    CoQueue *queue;
+    Waiter waiter;
+
+    bool await_ready() { return queue->trySend(waiter.item); }
+    void await_suspend(CoTask::Handle h) {
+      waiter.promise = &h.promise();
+      queue->append(&queue->senders, &waiter);
+    }
+    void await_resume() {}
+  };
+
+  ReceiveAwaiter receive() { return ReceiveAwaiter{this, {nullptr, nullptr, T()}}; }
+  SendAwaiter send(const T &item) { return SendAwaiter{this, {nullptr, nullptr, item}}; }
+
+private:
+
+  // Waiters are served in the order they arrived
+  static void append(Waiter **list, Waiter *waiter) {
+    waiter->next = nullptr;
+    while (*list != nullptr) {
+      list = &(*list)->next;
+    }
+    *list = waiter;
+  }
+
+  T items[Length];
+  size_t head = 0;
+  size_t count = 0;
+  Waiter *receivers = nullptr;
+  Waiter *senders = nullptr;
+};
+
+#endif
@@ -0,0 +1,300 @@
+/*
+  Wait-for graph deadlock detector for FreeRTOS mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1
+*/
+
+#include "DeadlockDetector.h"
+
+// __FILE__ holds the full build path, only the file name is interesting
+static const char *baseName(const char *path) {
+  const char *name = path;
+  for (const char *p = path; *p != '\0'; p++) {
+    if (*p == '/' || *p == '\\') {
+      name = p + 1;
+    }
+  }
+  return name;
+}
+
+void deadlockDetectorPrint(Print &out, const DeadlockReport &report) {
+  out.printf("Deadlock: %u task(s)\n", (unsigned)report.length);
+
+  for (uint8_t i = 0; i < report.length; i++) {
+    const DeadlockEdge &edge = report.edges[i];
+    const DeadlockEdge &holder = report.edges[(i + 1) % report.length];
+
+    out.printf("  %s waits for ", pcTaskGetName(edge.task));
+    if (edge.mutex_name != NULL) {
+      out.print(edge.mutex_name);
+    } else {
+      out.printf("mutex %p", (void *)edge.mutex);
+    }
+    out.printf(" at %s:%d, held by %s since %s:%d\n",
+               baseName(edge.wait_file), edge.wait_line,
+               pcTaskGetName(holder.task),
+               baseName(edge.take_file), edge.take_line);
+  }
+}
+
+void deadlockDetectorPrintSerial(const DeadlockReport &report) {
+  deadlockDetectorPrint(Serial, report);
+}
+
+#if DEADLOCK_DETECTOR
+
+// A mutex and its holder
+typedef struct MutexRecord {
+  SemaphoreHandle_t mutex;          // NULL if the slot is unused
+  const char *name;
+  TaskHandle_t owner;               // NULL if free
+  const char *take_file;
+  int take_line;
+} MutexRecord;
+
+// A task blocked in TRACKED_TAKE()
+typedef struct WaitRecord {
+  TaskHandle_t task;                // NULL if the slot is unused
+  MutexRecord *mutex;
+  const char *file;
+  int line;
+} WaitRecord;
+
+// Globals
+static MutexRecord mutexes[DEADLOCK_DETECTOR_MAX_MUTEXES];
+static WaitRecord waiters[DEADLOCK_DETECTOR_MAX_WAITERS];
+static DeadlockStats detector_stats;
+static DeadlockPolicy detector_policy = DEADLOCK_LOG;
+static DeadlockHandler detector_handler = deadlockDetectorPrintSerial;
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+//*****************************************************************************
+// Helpers (call with spinlock taken)
+
+// Record of `mutex`, a new one if it has none yet, NULL if the table is full
+static MutexRecord *findMutex(SemaphoreHandle_t mutex) {
+  MutexRecord *unused = NULL;
+
+  for (int i = 0; i < DEADLOCK_DETECTOR_MAX_MUTEXES; i++) {
+    if (mutexes[i].mutex == mutex) {
+      return &mutexes[i];
+    }
+    if (mutexes[i].mutex == NULL && unused == NULL) {
+      unused = &mutexes[i];
+    }
+  }
+
+  if (unused != NULL) {
+    unused->mutex = mutex;
+    unused->name = NULL;
+    unused->owner = NULL;
+  }
+  return unused;
+}
+
+static WaitRecord *findWait(TaskHandle_t task) {
+  for (int i = 0; i < DEADLOCK_DETECTOR_MAX_WAITERS; i++) {
+    if (waiters[i].task == task) {
+      return &waiters[i];
+    }
+  }
+  return NULL;
+}
+
+// Follow the holders from `wait` on, fill `report` and return true if they lead back
+static bool findCycle(const WaitRecord *wait, DeadlockReport *report) {
+  const WaitRecord *current = wait;
+
+  report->length = 0;
+  while (report->length < DEADLOCK_MAX_CYCLE) {
+    const MutexRecord *mutex = current->mutex;
+    if (mutex->owner == NULL) {
+      return false;
+    }
+
+    DeadlockEdge &edge = report->edges[report->length++];
+    edge.task = current->task;
+    edge.mutex = mutex->mutex;
+    edge.mutex_name = mutex->name;
+    edge.wait_file = current->file;
+    edge.wait_line = current->line;
+    edge.take_file = mutex->take_file;
+    edge.take_line = mutex->take_line;
+
+    if (mutex->owner == wait->task) {
+      return true;
+    }
+    current = findWait(mutex->owner);
+    if (current == NULL) {
+      return false;
+    }
+  }
+  return false;
+}
+
+static void noteOwner(SemaphoreHandle_t mutex, const char *file, int line) {
+  portENTER_CRITICAL(&spinlock);
+  MutexRecord *record = findMutex(mutex);
+  if (record != NULL) {
+    record->owner = xTaskGetCurrentTaskHandle();
+    record->take_file = file;
+    record->take_line = line;
+  }
+  portEXIT_CRITICAL(&spinlock);
+}
+
+//*****************************************************************************
+// Public API
+
+bool deadlockDetectorTake(SemaphoreHandle_t mutex, TickType_t timeout, const char *file,
+                          int line) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  DeadlockReport report;
+  bool cycle = false;
+
+  portENTER_CRITICAL(&spinlock);
+  detector_stats.takes++;
+  portEXIT_CRITICAL(&spinlock);
+
+  // Free (or not willing to wait): nothing can close a cycle
+  if (xSemaphoreTake(mutex, 0) == pdTRUE) {
+    noteOwner(mutex, file, line);
+    return true;
+  }
+  if (timeout == 0) {
+    return false;
+  }
+
+  // About to block: add the edge and look for a cycle through it
+  portENTER_CRITICAL(&spinlock);
+  detector_stats.waits++;
+  MutexRecord *record = findMutex(mutex);
+  WaitRecord *wait = (record != NULL) ? findWait(NULL) : NULL;
+  if (wait != NULL) {
+    wait->task = self;
+    wait->mutex = record;
+    wait->file = file;
+    wait->line = line;
+    cycle = findCycle(wait, &report);
+    if (cycle) {
+      detector_stats.cycles++;
+      if (detector_policy == DEADLOCK_BREAK) {
+        detector_stats.broken++;
+        wait->task = NULL;
+      }
+    }
+  } else {
+    detector_stats.untracked++;
+  }
+  DeadlockPolicy policy = detector_policy;
+  DeadlockHandler handler = detector_handler;
+  portEXIT_CRITICAL(&spinlock);
+
+  if (cycle) {
+    handler(report);
+    configASSERT(policy != DEADLOCK_ASSERT);
+    if (policy == DEADLOCK_BREAK) {
+      return false;
+    }
+  }
+
+  bool taken = (xSemaphoreTake(mutex, timeout) == pdTRUE);
+
+  portENTER_CRITICAL(&spinlock);
+  if (wait != NULL) {
+    wait->task = NULL;
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  if (taken) {
+    noteOwner(mutex, file, line);
+  }
+  return taken;
+}
+
+void deadlockDetectorGive(SemaphoreHandle_t mutex) {
+  portENTER_CRITICAL(&spinlock);
+  for (int i = 0; i < DEADLOCK_DETECTOR_MAX_MUTEXES; i++) {
+    if (mutexes[i].mutex == mutex) {
+      mutexes[i].owner = NULL;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  xSemaphoreGive(mutex);
+}
+
+void deadlockDetectorName(SemaphoreHandle_t mutex, const char *name) {
+  portENTER_CRITICAL(&spinlock);
+  MutexRecord *record = findMutex(mutex);
+  if (record != NULL) {
+    record->name = name;
+  }
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void deadlockDetectorSetPolicy(DeadlockPolicy policy, DeadlockHandler handler) {
+  portENTER_CRITICAL(&spinlock);
+  detector_policy = policy;
+  detector_handler = (handler != NULL) ? handler : deadlockDetectorPrintSerial;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void deadlockDetectorGetStats(DeadlockStats *stats) {
+  portENTER_CRITICAL(&spinlock);
+  *stats = detector_stats;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+#endif
+
+#if DEADLOCK_DETECTOR || LOCKDEP
+
+//*****************************************************************************
+// Mutex macros
+
+bool trackedTake(SemaphoreHandle_t mutex, TickType_t timeout, const char *file, int line) {
+#if LOCKDEP
+  // The order is checked before blocking, a report can't be lost to a deadlock
+  lockdepAcquire(xTaskGetCurrentTaskHandle(), pcTaskGetName(NULL), mutex, file, line);
+#endif
+
+#if DEADLOCK_DETECTOR
+  bool taken = deadlockDetectorTake(mutex, timeout, file, line);
+#else
+  bool taken = (xSemaphoreTake(mutex, timeout) == pdTRUE);
+#endif
+
+#if LOCKDEP
+  if (!taken) {
+    lockdepRelease(xTaskGetCurrentTaskHandle(), mutex);
+  }
+#endif
+  return taken;
+}
+
+void trackedGive(SemaphoreHandle_t mutex) {
+#if LOCKDEP
+  lockdepRelease(xTaskGetCurrentTaskHandle(), mutex);
+#endif
+
+#if DEADLOCK_DETECTOR
+  deadlockDetectorGive(mutex);
+#else
+  xSemaphoreGive(mutex);
+#endif
+}
+
+void trackedName(SemaphoreHandle_t mutex, const char *name) {
+#if LOCKDEP
+  lockdepRegister(mutex, name);
+#endif
+
+#if DEADLOCK_DETECTOR
+  deadlockDetectorName(mutex, name);
+#endif
+}
+
+#endif
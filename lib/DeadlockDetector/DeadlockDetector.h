@@ -0,0 +1,140 @@
+/*
+  Wait-for graph deadlock detector for FreeRTOS mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : With LOCKDEP=1 the macros also feed the lock ordering validator of
+                lib/Lockdep, which reports an inversion of the usual order even when it
+                doesn't deadlock. Either check works without the other.
+
+  Two tasks that take the same two mutexes in opposite order can end up each holding one
+  and waiting forever for the other. Nothing crashes and nothing is printed, the tasks
+  just stop. With DEADLOCK_DETECTOR=1 every take and give made through the macros below
+  keeps a small wait-for graph: which task holds which mutex (and where it took it) and
+  which mutex each blocked task is waiting for (and where). Before a task blocks, the
+  chain of holders is followed from the mutex it wants; if the chain comes back to the
+  task itself, the wait would close a cycle and the detector reports it right then,
+  before anything hangs:
+
+    Deadlock: 2 task(s)
+      Task B waits for mutex 1 at main.cpp:93, held by Task A since main.cpp:58
+      Task A waits for mutex 2 at main.cpp:63, held by Task B since main.cpp:88
+
+  What happens next is the policy (deadlockDetectorSetPolicy()):
+
+  - DEADLOCK_LOG    : report and block anyway (the default)
+  - DEADLOCK_ASSERT : report and stop in configASSERT()
+  - DEADLOCK_BREAK  : report and return false from TRACKED_TAKE() without blocking, so
+                      the task that closed the cycle can give back what it holds
+
+  The report goes to a handler, deadlockDetectorPrintSerial() unless another is set
+  (e.g. one that stores it for the next boot). Use TRACKED_TAKE()/TRACKED_GIVE() instead
+  of xSemaphoreTake()/xSemaphoreGive() on mutexes, and TRACKED_NAME() to give a mutex a
+  name for the report. Without DEADLOCK_DETECTOR (or LOCKDEP) the macros compile to the
+  plain calls.
+
+  FreeRTOS is linked in precompiled with arduino-esp32, so its trace hooks can't be set
+  from a sketch; the macros are where the check hooks in instead. Only mutexes taken
+  through them are part of the graph. The tables hold DEADLOCK_DETECTOR_MAX_MUTEXES
+  mutexes and DEADLOCK_DETECTOR_MAX_WAITERS blocked tasks (default 16 each); mutexes
+  beyond that are taken without checks and counted in DeadlockStats::untracked.
+*/
+
+#ifndef DEADLOCK_DETECTOR_H
+#define DEADLOCK_DETECTOR_H
+
+#include <Arduino.h>
+#include <Lockdep.h>
+
+#ifndef DEADLOCK_DETECTOR
+  #define DEADLOCK_DETECTOR 0
+#endif
+
+#ifndef DEADLOCK_DETECTOR_MAX_MUTEXES
+  #define DEADLOCK_DETECTOR_MAX_MUTEXES 16
+#endif
+
+#ifndef DEADLOCK_DETECTOR_MAX_WAITERS
+  #define DEADLOCK_DETECTOR_MAX_WAITERS 16
+#endif
+
+// Longest cycle a report can hold
+#define DEADLOCK_MAX_CYCLE 8
+
+typedef enum DeadlockPolicy {
+  DEADLOCK_LOG,
+  DEADLOCK_ASSERT,
+  DEADLOCK_BREAK
+} DeadlockPolicy;
+
+// One edge of a cycle: `task` waits for `mutex`, which the task of the next edge holds
+typedef struct DeadlockEdge {
+  TaskHandle_t task;
+  SemaphoreHandle_t mutex;
+  const char *mutex_name;     // NULL if it has none
+  const char *wait_file;      // Where `task` waits
+  int wait_line;
+  const char *take_file;      // Where the holder took `mutex`
+  int take_line;
+} DeadlockEdge;
+
+typedef struct DeadlockReport {
+  uint8_t length;             // Tasks in the cycle
+  DeadlockEdge edges[DEADLOCK_MAX_CYCLE];
+} DeadlockReport;
+
+// Detector counters (see deadlockDetectorGetStats())
+typedef struct DeadlockStats {
+  uint32_t takes;             // Takes through TRACKED_TAKE()
+  uint32_t waits;             // Takes that had to block
+  uint32_t cycles;            // Cycles found
+  uint32_t broken;            // Takes refused by DEADLOCK_BREAK
+  uint32_t untracked;         // Takes not checked because a table was full
+} DeadlockStats;
+
+typedef void (*DeadlockHandler)(const DeadlockReport &report);
+
+// Print a report, and the default handler that prints it to Serial
+void deadlockDetectorPrint(Print &out, const DeadlockReport &report);
+void deadlockDetectorPrintSerial(const DeadlockReport &report);
+
+#if DEADLOCK_DETECTOR
+
+bool deadlockDetectorTake(SemaphoreHandle_t mutex, TickType_t timeout, const char *file,
+                          int line);
+void deadlockDetectorGive(SemaphoreHandle_t mutex);
+void deadlockDetectorName(SemaphoreHandle_t mutex, const char *name);
+
+// What to do when a cycle is found, and who gets the report (NULL for Serial)
+void deadlockDetectorSetPolicy(DeadlockPolicy policy, DeadlockHandler handler = NULL);
+
+void deadlockDetectorGetStats(DeadlockStats *stats);
+
+#endif
+
+#if DEADLOCK_DETECTOR || LOCKDEP
+
+// Whichever checks are enabled around xSemaphoreTake()/xSemaphoreGive()
+bool trackedTake(SemaphoreHandle_t mutex, TickType_t timeout, const char *file, int line);
+void trackedGive(SemaphoreHandle_t mutex);
+void trackedName(SemaphoreHandle_t mutex, const char *name);
+
+  #define TRACKED_TAKE(mutex, timeout) trackedTake((mutex), (timeout), __FILE__, __LINE__)
+  #define TRACKED_GIVE(mutex) trackedGive(mutex)
+  #define TRACKED_NAME(mutex, name) trackedName((mutex), (name))
+
+#else
+
+static inline bool plainTake(SemaphoreHandle_t mutex, TickType_t timeout) {
+  return xSemaphoreTake(mutex, timeout) == pdTRUE;
+}
+
+  #define TRACKED_TAKE(mutex, timeout) plainTake((mutex), (timeout))
+  #define TRACKED_GIVE(mutex) xSemaphoreGive(mutex)
+  #define TRACKED_NAME(mutex, name) ((void)(mutex), (void)(name))
+
+#endif
+
+#endif
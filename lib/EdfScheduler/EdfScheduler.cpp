@@ -0,0 +1,199 @@
+/*
+  Earliest-deadline-first band on top of FreeRTOS fixed priorities
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "EdfScheduler.h"
+
+// Tick comparisons that survive the tick counter wrapping around
+static inline bool tickReached(TickType_t now, TickType_t when) {
+  return (int32_t)(now - when) >= 0;
+}
+
+static inline bool tickBefore(TickType_t a, TickType_t b) {
+  return (int32_t)(a - b) < 0;
+}
+
+//*****************************************************************************
+// EdfBand
+
+void EdfBand::begin(UBaseType_t base_priority, BaseType_t core_id) {
+  configASSERT(dispatcher == NULL);
+  configASSERT(base_priority + 2 < configMAX_PRIORITIES);
+
+  low_priority = base_priority;
+  high_priority = base_priority + 1;
+  dispatcher = dispatcher_task.createPinnedToCore(dispatcherTask,
+                                                  "EDF dispatch",
+                                                  this,
+                                                  base_priority + 2,
+                                                  core_id);
+}
+
+void EdfBand::attach(EdfTask *task) {
+  configASSERT(dispatcher != NULL);
+
+  portENTER_CRITICAL(&spinlock);
+  configASSERT(num_tasks < EDF_MAX_TASKS);
+  tasks[num_tasks++] = task;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void EdfBand::wakeDispatcher() {
+  xTaskNotifyGive(dispatcher);
+}
+
+void EdfBand::dispatcherTask(void *parameters) {
+  EdfBand *band = (EdfBand *)parameters;
+  band->dispatch();
+}
+
+void EdfBand::dispatch() {
+  TickType_t timeout = portMAX_DELAY;
+
+  while (1) {
+
+    // Woken by a finished or new job, or by the next release time
+    ulTaskNotifyTake(pdTRUE, timeout);
+
+    TickType_t now = xTaskGetTickCount();
+    TaskHandle_t released[EDF_MAX_TASKS];
+    int num_released = 0;
+    EdfTask *earliest = NULL;
+    timeout = portMAX_DELAY;
+
+    portENTER_CRITICAL(&spinlock);
+    for (int i = 0; i < num_tasks; i++) {
+      EdfTask *task = tasks[i];
+
+      if (!task->ready && tickReached(now, task->next_release)) {
+
+        // Releases that passed completely while the last job was running get no job
+        uint32_t missed = (now - task->next_release) / task->period_ticks;
+        task->next_release += missed * task->period_ticks;
+        task->abs_deadline = task->next_release + task->deadline_ticks;
+        task->next_release += task->period_ticks;
+        task->release_us = micros();
+        task->ready = true;
+        task->stats.releases++;
+        task->stats.skipped_releases += missed;
+        released[num_released++] = task->handle;
+      }
+
+      if (!task->ready) {
+        TickType_t until = task->next_release - now;
+        if (timeout == portMAX_DELAY || until < timeout) {
+          timeout = until;
+        }
+      } else if (earliest == NULL || tickBefore(task->abs_deadline, earliest->abs_deadline)) {
+        earliest = task;
+      }
+    }
+    portEXIT_CRITICAL(&spinlock);
+
+    for (int i = 0; i < num_released; i++) {
+      xTaskNotifyGive(released[i]);
+    }
+
+    // Only the earliest deadline gets the high priority of the band
+    if (earliest != top) {
+      if (top != NULL) {
+        vTaskPrioritySet(top->handle, low_priority);
+      }
+      if (earliest != NULL) {
+        vTaskPrioritySet(earliest->handle, high_priority);
+      }
+      top = earliest;
+    }
+  }
+}
+
+//*****************************************************************************
+// EdfTask
+
+void EdfTask::begin(EdfBand &edf_band, TickType_t period, TickType_t deadline) {
+  band = &edf_band;
+  handle = xTaskGetCurrentTaskHandle();
+  period_ticks = (period > 0) ? period : 1;
+  deadline_ticks = (deadline > 0) ? deadline : period_ticks;
+  resetStats();
+
+  // The first job starts now, the dispatcher decides when it may run
+  vTaskPrioritySet(NULL, band->low_priority);
+  TickType_t now = xTaskGetTickCount();
+  abs_deadline = now + deadline_ticks;
+  next_release = now + period_ticks;
+  release_us = micros();
+  ready = true;
+  stats.releases = 1;
+
+  band->attach(this);
+  band->wakeDispatcher();
+}
+
+bool EdfTask::wait() {
+  configASSERT(band != NULL);
+
+  TickType_t now = xTaskGetTickCount();
+
+  portENTER_CRITICAL(&band->spinlock);
+  uint32_t response_us = micros() - release_us;
+  bool met = !tickBefore(abs_deadline, now);
+  ready = false;
+  if (!met) {
+    stats.deadline_misses++;
+  }
+  if (response_us > stats.max_response_us) {
+    stats.max_response_us = response_us;
+  }
+  portEXIT_CRITICAL(&band->spinlock);
+
+  // Let the dispatcher hand the CPU to the next deadline, then wait for our release
+  band->wakeDispatcher();
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+  return met;
+}
+
+void EdfTask::getStats(EdfStats *out) {
+  if (band == NULL) {
+    *out = stats;
+    return;
+  }
+
+  portENTER_CRITICAL(&band->spinlock);
+  *out = stats;
+  portEXIT_CRITICAL(&band->spinlock);
+}
+
+void EdfTask::resetStats() {
+  EdfStats fresh = {};
+  fresh.period = period_ticks;
+  fresh.deadline = deadline_ticks;
+
+  if (band == NULL) {
+    stats = fresh;
+    return;
+  }
+
+  portENTER_CRITICAL(&band->spinlock);
+  stats = fresh;
+  portEXIT_CRITICAL(&band->spinlock);
+}
+
+void EdfTask::printStats(Print &out, const char *name) {
+  EdfStats snapshot;
+  getStats(&snapshot);
+
+  out.printf("%s: period %u ms, deadline %u ms, %u releases, %u deadline misses, "
+             "%u skipped, max response %u us\n",
+             name,
+             (unsigned)(snapshot.period * portTICK_PERIOD_MS),
+             (unsigned)(snapshot.deadline * portTICK_PERIOD_MS),
+             (unsigned)snapshot.releases,
+             (unsigned)snapshot.deadline_misses,
+             (unsigned)snapshot.skipped_releases,
+             (unsigned)snapshot.max_response_us);
+}
@@ -0,0 +1,122 @@
+/*
+  Earliest-deadline-first band on top of FreeRTOS fixed priorities
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  FreeRTOS always runs the ready task with the highest priority. With fixed priorities a
+  set of periodic tasks is only guaranteed to meet its deadlines up to about 69-78 %
+  CPU load (rate-monotonic bound); above that a lower priority task can miss even though
+  the CPU would have had the time. Earliest deadline first (EDF) runs the job whose
+  absolute deadline comes first and meets every deadline up to 100 % load.
+
+  An EdfBand takes three consecutive priorities on one core:
+
+    base + 2 : the dispatcher task
+    base + 1 : the one EDF task whose job has the earliest deadline
+    base     : all other EDF tasks
+
+  Every EDF task waits for its releases through the dispatcher. On each release and each
+  finished job the dispatcher moves the earliest-deadline task to base + 1, so that is
+  the one FreeRTOS runs. Fixed-priority tasks keep working as before: tasks above base + 2
+  preempt the whole band, tasks below base only run when no EDF job is ready.
+
+  Example (both EDF tasks pinned to the band's core):
+    static EdfBand band;
+    static EdfTask control_edf;
+
+    void control(void *parameters) {
+      control_edf.begin(band, pdMS_TO_TICKS(20));       // Deadline = period
+      while (1) {
+        ... work ...
+        control_edf.wait();                             // Sleep until the next release
+      }
+    }
+
+    band.begin(1, app_cpu);                             // Uses priorities 1, 2 and 3
+
+  Deadlines are checked in ticks. A job that is still running at its next release makes
+  that release late (it starts when the job is done), releases that passed completely are
+  skipped, like in lib/PeriodicTask. EDF tasks wait on their direct-to-task notification,
+  so they must not use it for anything else. host-tools/src/sched-sim.cpp simulates a
+  band before it goes on the hardware.
+*/
+
+#ifndef EDF_SCHEDULER_H
+#define EDF_SCHEDULER_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+#ifndef EDF_MAX_TASKS
+  #define EDF_MAX_TASKS 8
+#endif
+
+// Counters since begin() or resetStats()
+typedef struct EdfStats {
+  TickType_t period;          // In ticks
+  TickType_t deadline;        // Relative to the release, in ticks
+  uint32_t releases;          // Jobs started
+  uint32_t deadline_misses;   // Jobs that finished after their deadline
+  uint32_t skipped_releases;  // Releases that got no job because the previous one overran
+  uint32_t max_response_us;   // Longest time from release to the next wait()
+} EdfStats;
+
+class EdfTask;
+
+class EdfBand {
+public:
+
+  // Start the dispatcher at base_priority + 2 on core_id
+  void begin(UBaseType_t base_priority, BaseType_t core_id);
+
+private:
+  friend class EdfTask;
+
+  void attach(EdfTask *task);
+  void wakeDispatcher();
+  static void dispatcherTask(void *parameters);
+  void dispatch();
+
+  EdfTask *tasks[EDF_MAX_TASKS];
+  int num_tasks = 0;
+  EdfTask *top = NULL;            // Task running at high_priority
+  TaskHandle_t dispatcher = NULL;
+  UBaseType_t low_priority = 0;
+  UBaseType_t high_priority = 0;
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+  TaskStorage<2048> dispatcher_task;
+};
+
+class EdfTask {
+public:
+
+  // Join `band` with the calling task and release its first job now. deadline 0 means
+  // the same as the period.
+  void begin(EdfBand &band, TickType_t period, TickType_t deadline = 0);
+
+  // Finish the current job and sleep until the next release. Returns false if the job
+  // missed its deadline.
+  bool wait();
+
+  void getStats(EdfStats *stats);
+  void resetStats();
+
+  // One-line summary, e.g. "Control: period 20 ms, deadline 20 ms, 500 releases, ..."
+  void printStats(Print &out, const char *name);
+
+private:
+  friend class EdfBand;
+
+  EdfBand *band = NULL;
+  TaskHandle_t handle = NULL;
+  TickType_t period_ticks = 1;
+  TickType_t deadline_ticks = 1;
+  TickType_t next_release = 0;    // Of the job after the current one
+  TickType_t abs_deadline = 0;    // Of the current job
+  uint32_t release_us = 0;
+  bool ready = false;             // Current job released and not finished
+  EdfStats stats = {};
+};
+
+#endif
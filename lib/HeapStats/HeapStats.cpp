@@ -0,0 +1,141 @@
+/*
+  Heap fragmentation map: free-block histogram, largest free block and minimum ever free
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "HeapStats.h"
+
+#include <esp_heap_caps.h>
+#include <esp_idf_version.h>
+#include <TlsfHeap.h>
+
+#if !USE_TLSF_HEAP && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+  #define HEAP_STATS_IDF_WALK 1
+#else
+  #define HEAP_STATS_IDF_WALK 0
+#endif
+
+//*****************************************************************************
+// Helpers
+
+static int bucketOf(size_t size) {
+  int bucket = 0;
+  size_t limit = 32;
+  while (bucket < HEAP_STATS_BUCKETS - 1 && size >= limit) {
+    bucket++;
+    limit <<= 1;
+  }
+  return bucket;
+}
+
+static void addBlock(HeapReport *report, size_t size, bool used) {
+  if (used) {
+    report->used_blocks++;
+    return;
+  }
+  report->free_blocks++;
+  report->free_bytes += size;
+  if (size > report->largest_free_block) {
+    report->largest_free_block = size;
+  }
+  report->histogram[bucketOf(size)]++;
+}
+
+static void finishReport(HeapReport *report) {
+  if (report->free_bytes == 0) {
+    report->fragmentation = 0;
+  } else {
+    report->fragmentation =
+      100 - (uint8_t)((uint64_t)report->largest_free_block * 100 / report->free_bytes);
+  }
+}
+
+#if USE_TLSF_HEAP
+static void tlsfBlock(void *ptr, size_t size, bool used, void *user) {
+  addBlock((HeapReport *)user, size, used);
+}
+#elif HEAP_STATS_IDF_WALK
+static bool idfBlock(walker_heap_into_t heap_info, walker_block_info_t block_info, void *user) {
+  addBlock((HeapReport *)user, block_info.size, block_info.used);
+  return true;
+}
+#endif
+
+//*****************************************************************************
+// Public API
+
+void heapStatsCollect(HeapReport *report) {
+  memset(report, 0, sizeof(HeapReport));
+
+#if USE_TLSF_HEAP
+  TlsfHeap &heap = tlsfSystemHeap();
+  heap.walk(tlsfBlock, report);
+  report->min_free_bytes = heap.minFreeBytes();
+  report->has_histogram = true;
+#elif HEAP_STATS_IDF_WALK
+  heap_caps_walk(MALLOC_CAP_8BIT, idfBlock, report);
+  report->min_free_bytes = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  report->has_histogram = true;
+#else
+  // No block walker in this framework version, only the totals
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  report->free_bytes = info.total_free_bytes;
+  report->largest_free_block = info.largest_free_block;
+  report->min_free_bytes = info.minimum_free_bytes;
+  report->used_blocks = info.allocated_blocks;
+  report->free_blocks = info.free_blocks;
+  report->has_histogram = false;
+#endif
+
+  finishReport(report);
+}
+
+size_t heapStatsBucketSize(int bucket) {
+  return bucket == 0 ? 0 : (size_t)32 << (bucket - 1);
+}
+
+bool heapStatsCanAlloc(size_t size) {
+#if USE_TLSF_HEAP
+  TlsfHeapStats stats;
+  tlsfSystemHeap().getStats(&stats);
+  return stats.largest_free_block >= size;
+#else
+  return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT) >= size;
+#endif
+}
+
+void heapStatsPrintSummary(Print &out, const HeapReport *report) {
+  out.printf("Heap: free %u B in %u blocks, largest %u B, min ever %u B, frag %u %%\n",
+             (unsigned)report->free_bytes,
+             (unsigned)report->free_blocks,
+             (unsigned)report->largest_free_block,
+             (unsigned)report->min_free_bytes,
+             (unsigned)report->fragmentation);
+}
+
+void heapStatsPrint(Print &out, const HeapReport *report) {
+  heapStatsPrintSummary(out, report);
+  out.printf("  used blocks: %u\n", (unsigned)report->used_blocks);
+
+  if (!report->has_histogram) {
+    out.println("  free-block histogram not available on this heap");
+    return;
+  }
+
+  out.println("  free blocks by size:");
+  for (int i = 0; i < HEAP_STATS_BUCKETS; i++) {
+    size_t low = heapStatsBucketSize(i);
+    if (i == 0) {
+      out.printf("    %8s %5u\n", "< 32 B", (unsigned)report->histogram[i]);
+    } else if (i == HEAP_STATS_BUCKETS - 1) {
+      out.printf("    >=%4u K %5u\n", (unsigned)(low / 1024), (unsigned)report->histogram[i]);
+    } else if (low < 1024) {
+      out.printf("    %6u B %5u\n", (unsigned)low, (unsigned)report->histogram[i]);
+    } else {
+      out.printf("    %6u K %5u\n", (unsigned)(low / 1024), (unsigned)report->histogram[i]);
+    }
+  }
+}
@@ -0,0 +1,57 @@
+/*
+  Heap fragmentation map: free-block histogram, largest free block and minimum ever free
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  xPortGetFreeHeapSize() says how many bytes are free, not whether a 4 KB buffer can still
+  be allocated: 20 KB spread over 5 KB holes is fine, the same 20 KB in 64 byte holes is not.
+  heapStatsCollect() walks the heap behind pvPortMalloc() and fills a HeapReport with
+
+  - free bytes, the largest free block and the lowest free bytes ever seen
+  - the number of used and free blocks
+  - a histogram of the free blocks by size (powers of two, <32 B .. >=32 KB)
+  - the fragmentation index, 100 * (1 - largest free block / free bytes) in %
+
+  With USE_TLSF_HEAP the TLSF region is walked block by block. On the ESP-IDF heap the
+  blocks are walked with heap_caps_walk() where the framework has it (ESP-IDF 5.3 and
+  later); older frameworks only give the totals through heap_caps_get_info(), so the
+  histogram is left out (HeapReport::has_histogram is false).
+
+  heapStatsCanAlloc() is the cheap check to alarm on: it is true while a block of the
+  given size can still be allocated in one piece.
+*/
+
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <Arduino.h>
+
+// Free-block size classes: <32, 32, 64, .. 16K, >=32K bytes
+#define HEAP_STATS_BUCKETS 12
+
+typedef struct HeapReport {
+  size_t free_bytes;
+  size_t largest_free_block;
+  size_t min_free_bytes;      // Lowest free_bytes since boot
+  size_t used_blocks;
+  size_t free_blocks;
+  uint8_t fragmentation;      // 0..100 %
+  bool has_histogram;
+  uint32_t histogram[HEAP_STATS_BUCKETS];  // Free blocks per size class
+} HeapReport;
+
+// Walk the heap behind pvPortMalloc()
+void heapStatsCollect(HeapReport *report);
+
+// Full report with histogram, and a one-line version for periodic telemetry
+void heapStatsPrint(Print &out, const HeapReport *report);
+void heapStatsPrintSummary(Print &out, const HeapReport *report);
+
+// Lower bound of a histogram bucket in bytes (0 for the first one)
+size_t heapStatsBucketSize(int bucket);
+
+// True if `size` bytes can still be allocated in one block
+bool heapStatsCanAlloc(size_t size);
+
+#endif
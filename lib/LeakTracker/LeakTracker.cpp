@@ -0,0 +1,246 @@
+/*
+  Allocation-site leak tracker for pvPortMalloc()/vPortFree() and block pools
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "LeakTracker.h"
+
+#if LEAK_TRACKER
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+
+#define TASK_NAME_LEN configMAX_TASK_NAME_LEN
+
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+static inline void lockRecords() { portENTER_CRITICAL_SAFE(&spinlock); }
+static inline void unlockRecords() { portEXIT_CRITICAL_SAFE(&spinlock); }
+
+// NULL task means an ISR or the scheduler
+static const char *currentTaskName() {
+  return xPortInIsrContext() ? "(isr)" : pcTaskGetName(NULL);
+}
+
+static uint32_t nowMs() {
+  TickType_t tick = xPortInIsrContext() ? xTaskGetTickCountFromISR() : xTaskGetTickCount();
+  return tick * portTICK_PERIOD_MS;
+}
+
+#else
+
+#include <chrono>
+#include <mutex>
+#include <stdarg.h>
+
+#define TASK_NAME_LEN 16
+
+static std::mutex records_mutex;
+static inline void lockRecords() { records_mutex.lock(); }
+static inline void unlockRecords() { records_mutex.unlock(); }
+
+static const char *currentTaskName() { return "(thread)"; }
+
+static uint32_t nowMs() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+size_t LeakTrackerOutput::printf(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int written = vfprintf(stream, format, args);
+  va_end(args);
+  return (written > 0) ? (size_t)written : 0;
+}
+
+size_t LeakTrackerOutput::println(const char *line) {
+  return (size_t)fprintf(stream, "%s\n", line);
+}
+
+#endif
+
+// One live block
+typedef struct BlockRecord {
+  void *ptr;                          // NULL if the slot is unused
+  size_t size;
+  const char *file;
+  int line;
+  uint32_t ms;                        // When it was allocated
+  uint32_t seq;                       // Allocation sequence number
+  char task_name[TASK_NAME_LEN];
+} BlockRecord;
+
+// Globals
+static BlockRecord records[LEAK_TRACKER_MAX_BLOCKS];
+static LeakTrackerStats tracker_stats;
+static uint32_t next_seq = 1;
+
+//*****************************************************************************
+// Helpers
+
+// __FILE__ holds the full build path, only the file name is interesting
+static const char *baseName(const char *path) {
+  const char *name = path;
+  for (const char *p = path; *p != '\0'; p++) {
+    if (*p == '/' || *p == '\\') {
+      name = p + 1;
+    }
+  }
+  return name;
+}
+
+static void printRecord(LeakTrackerOutput &out, const BlockRecord *record, uint32_t now) {
+  out.printf("  #%-6u %p %5u B  age %7u ms  %-16s %s:%d\n",
+             (unsigned)record->seq,
+             record->ptr,
+             (unsigned)record->size,
+             (unsigned)(now - record->ms),
+             record->task_name,
+             baseName(record->file),
+             record->line);
+}
+
+static void printBlocks(LeakTrackerOutput &out, uint32_t checkpoint) {
+  uint32_t now = nowMs();
+  size_t count = 0;
+  size_t bytes = 0;
+
+  // Copy one record at a time so printing doesn't run inside the critical section
+  for (int i = 0; i < LEAK_TRACKER_MAX_BLOCKS; i++) {
+    BlockRecord record;
+
+    lockRecords();
+    record = records[i];
+    unlockRecords();
+
+    if (record.ptr != NULL && record.seq >= checkpoint) {
+      printRecord(out, &record, now);
+      count++;
+      bytes += record.size;
+    }
+  }
+
+  LeakTrackerStats stats;
+  leakTrackerGetStats(&stats);
+  out.printf("  %u block(s), %u byte(s)  [allocs %u, frees %u, dropped %u, unknown frees %u]\n",
+             (unsigned)count,
+             (unsigned)bytes,
+             (unsigned)stats.alloc_count,
+             (unsigned)stats.free_count,
+             (unsigned)stats.dropped_count,
+             (unsigned)stats.unknown_frees);
+}
+
+//*****************************************************************************
+// Public API
+
+void leakTrackerRecord(void *ptr, size_t size, const char *file, int line) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  // Task name and time are looked up outside the lock
+  const char *task_name = currentTaskName();
+  uint32_t now = nowMs();
+
+  lockRecords();
+
+  tracker_stats.alloc_count++;
+
+  BlockRecord *record = NULL;
+  for (int i = 0; i < LEAK_TRACKER_MAX_BLOCKS; i++) {
+    if (records[i].ptr == NULL) {
+      record = &records[i];
+      break;
+    }
+  }
+
+  if (record == NULL) {
+    tracker_stats.dropped_count++;
+  } else {
+    record->ptr = ptr;
+    record->size = size;
+    record->file = file;
+    record->line = line;
+    record->ms = now;
+    record->seq = next_seq;
+    strncpy(record->task_name, task_name, TASK_NAME_LEN - 1);
+    record->task_name[TASK_NAME_LEN - 1] = '\0';
+
+    tracker_stats.live_blocks++;
+    tracker_stats.live_bytes += size;
+    if (tracker_stats.live_blocks > tracker_stats.max_live_blocks) {
+      tracker_stats.max_live_blocks = tracker_stats.live_blocks;
+    }
+  }
+  next_seq++;
+
+  unlockRecords();
+}
+
+void leakTrackerForget(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  lockRecords();
+
+  tracker_stats.free_count++;
+
+  int i;
+  for (i = 0; i < LEAK_TRACKER_MAX_BLOCKS; i++) {
+    if (records[i].ptr == ptr) {
+      tracker_stats.live_blocks--;
+      tracker_stats.live_bytes -= records[i].size;
+      records[i].ptr = NULL;
+      break;
+    }
+  }
+  if (i == LEAK_TRACKER_MAX_BLOCKS) {
+    tracker_stats.unknown_frees++;
+  }
+
+  unlockRecords();
+}
+
+void *leakTrackerMalloc(size_t size, const char *file, int line) {
+  void *ptr = pvPortMalloc(size);
+  leakTrackerRecord(ptr, size, file, line);
+  return ptr;
+}
+
+void leakTrackerFree(void *ptr) {
+  leakTrackerForget(ptr);
+  vPortFree(ptr);
+}
+
+uint32_t leakTrackerCheckpoint() {
+  uint32_t seq;
+
+  lockRecords();
+  seq = next_seq;
+  unlockRecords();
+
+  return seq;
+}
+
+void leakTrackerDump(LeakTrackerOutput &out) {
+  out.println("Live blocks:");
+  printBlocks(out, 0);
+}
+
+void leakTrackerReport(LeakTrackerOutput &out, uint32_t checkpoint) {
+  out.printf("Blocks allocated since #%u and still alive:\n", (unsigned)checkpoint);
+  printBlocks(out, checkpoint);
+}
+
+void leakTrackerGetStats(LeakTrackerStats *stats) {
+  lockRecords();
+  *stats = tracker_stats;
+  unlockRecords();
+}
+
+#endif
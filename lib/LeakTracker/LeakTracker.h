@@ -0,0 +1,108 @@
+/*
+  Allocation-site leak tracker for pvPortMalloc()/vPortFree() and block pools
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A leak that loses one buffer per message takes days to run a unit out of memory, and by
+  then nothing points at the line that caused it. With LEAK_TRACKER=1 every allocation made
+  through the macros below is recorded together with its call site (file and line), the
+  task that made it and a timestamp. The table can be printed at any time, and a checkpoint
+  makes it easy to see what was allocated since and is still alive:
+
+    uint32_t mark = leakTrackerCheckpoint();
+    ... run the message path for a while ...
+    leakTrackerReport(Serial, mark);    // Everything allocated after `mark` and never freed
+
+  Use TRACKED_MALLOC()/TRACKED_FREE() instead of pvPortMalloc()/vPortFree(), or record
+  blocks from another allocator (e.g. lib/BlockPool) with TRACK_ALLOC()/TRACK_FREE().
+  Without LEAK_TRACKER the macros compile to the plain calls, so release builds pay nothing.
+
+  The table holds LEAK_TRACKER_MAX_BLOCKS live blocks (default 64). Blocks that don't fit
+  are still allocated, they are only counted in LeakTrackerStats::dropped_count.
+
+  The tracker also builds for host programs (host-tools/, see soak-leaks.cpp): there the
+  reports go to a LeakTrackerOutput on a stdio stream, the "task" is the thread, ages are
+  taken from the steady clock and TRACKED_MALLOC()/TRACKED_FREE() use malloc()/free().
+*/
+
+#ifndef LEAK_TRACKER_H
+#define LEAK_TRACKER_H
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  #include <Arduino.h>
+
+  // Reports are printed to any Print (Serial, ...)
+  typedef Print LeakTrackerOutput;
+#else
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <stdio.h>
+  #include <stdlib.h>
+
+  // Host builds: the part of Print the reports use, on a stdio stream
+  class LeakTrackerOutput {
+  public:
+    explicit LeakTrackerOutput(FILE *stream) : stream(stream) {}
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t println(const char *line);
+  private:
+    FILE *stream;
+  };
+
+  #define pvPortMalloc(size) malloc(size)
+  #define vPortFree(ptr) free(ptr)
+#endif
+
+#ifndef LEAK_TRACKER
+  #define LEAK_TRACKER 0
+#endif
+
+#ifndef LEAK_TRACKER_MAX_BLOCKS
+  #define LEAK_TRACKER_MAX_BLOCKS 64
+#endif
+
+// Tracker counters (see leakTrackerGetStats())
+typedef struct LeakTrackerStats {
+  size_t live_blocks;       // Blocks recorded and not yet freed
+  size_t live_bytes;
+  size_t max_live_blocks;   // High-water mark of live_blocks
+  uint32_t alloc_count;
+  uint32_t free_count;
+  uint32_t dropped_count;   // Allocations not recorded because the table was full
+  uint32_t unknown_frees;   // Frees of pointers the tracker never saw (or freed twice)
+} LeakTrackerStats;
+
+#if LEAK_TRACKER
+
+void *leakTrackerMalloc(size_t size, const char *file, int line);
+void leakTrackerFree(void *ptr);
+
+// Record/forget a block that came from somewhere else than pvPortMalloc()
+void leakTrackerRecord(void *ptr, size_t size, const char *file, int line);
+void leakTrackerForget(void *ptr);
+
+// Sequence number of the next allocation, pass it to leakTrackerReport() later
+uint32_t leakTrackerCheckpoint();
+
+// Print every live block, or only those allocated since `checkpoint`
+void leakTrackerDump(LeakTrackerOutput &out);
+void leakTrackerReport(LeakTrackerOutput &out, uint32_t checkpoint);
+
+void leakTrackerGetStats(LeakTrackerStats *stats);
+
+  #define TRACKED_MALLOC(size) leakTrackerMalloc((size), __FILE__, __LINE__)
+  #define TRACKED_FREE(ptr) leakTrackerFree(ptr)
+  #define TRACK_ALLOC(ptr, size) leakTrackerRecord((ptr), (size), __FILE__, __LINE__)
+  #define TRACK_FREE(ptr) leakTrackerForget(ptr)
+
+#else
+
+  #define TRACKED_MALLOC(size) pvPortMalloc(size)
+  #define TRACKED_FREE(ptr) vPortFree(ptr)
+  #define TRACK_ALLOC(ptr, size) ((void)(ptr), (void)(size))
+  #define TRACK_FREE(ptr) ((void)(ptr))
+
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+/*
+  LED/GPIO blink patterns driven by FreeRTOS software timers
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "LedPattern.h"
+
+// Timer periods must be at least one tick
+TickType_t LedPattern::toTicks(uint16_t ms) {
+  TickType_t ticks = pdMS_TO_TICKS(ms);
+  return (ticks > 0) ? ticks : 1;
+}
+
+// Out-of-range times (e.g. typed in the Serial Monitor) would wrap around in 16 bits
+uint16_t LedPattern::clampMs(long ms) {
+  if (ms < 0) {
+    return 0;
+  }
+  return (ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)ms;
+}
+
+bool LedPattern::begin(uint8_t led_pin, long on_ms, long off_ms) {
+  blink_steps[0] = clampMs(on_ms);
+  blink_steps[1] = clampMs(off_ms);
+  return begin(led_pin, blink_steps, 2);
+}
+
+bool LedPattern::begin(uint8_t led_pin, const uint16_t *pattern_steps, uint8_t count) {
+  configASSERT(pattern_steps != NULL && count >= 2 && count % 2 == 0);
+
+  // Create the timer on first use (one-shot, re-armed by every callback)
+  if (timer == NULL) {
+    timer = timer_storage.create("LED Pattern", toTicks(pattern_steps[0]), pdFALSE, this,
+                                 timerCallback);
+    if (timer == NULL) {
+      return false;
+    }
+  }
+
+  portENTER_CRITICAL(&pending_lock);
+  pending_pin = led_pin;
+  pending_steps = pattern_steps;
+  pending_num_steps = count;
+  portEXIT_CRITICAL(&pending_lock);
+
+  // The fields the callback uses are only changed in the timer service task
+  return xTimerPendFunctionCall(applyBegin, this, 0, portMAX_DELAY) == pdPASS;
+}
+
+void LedPattern::setTiming(long on_ms, long off_ms) {
+  blink_steps[0] = clampMs(on_ms);
+  blink_steps[1] = clampMs(off_ms);
+}
+
+void LedPattern::stop() {
+  if (timer != NULL) {
+    xTimerPendFunctionCall(applyStop, this, 0, portMAX_DELAY);
+  }
+}
+
+// Runs in the timer service task, so never at the same time as timerCallback()
+void LedPattern::applyBegin(void *parameter, uint32_t unused) {
+  LedPattern *pattern = (LedPattern *)parameter;
+
+  portENTER_CRITICAL(&pattern->pending_lock);
+  pattern->pin = pattern->pending_pin;
+  pattern->steps = pattern->pending_steps;
+  pattern->num_steps = pattern->pending_num_steps;
+  portEXIT_CRITICAL(&pattern->pending_lock);
+
+  pattern->step = 0;
+  pattern->running = true;
+
+  // First step is "on"
+  pinMode(pattern->pin, OUTPUT);
+  digitalWrite(pattern->pin, HIGH);
+  xTimerChangePeriod(pattern->timer, toTicks(pattern->steps[0]), 0);
+}
+
+void LedPattern::applyStop(void *parameter, uint32_t unused) {
+  LedPattern *pattern = (LedPattern *)parameter;
+
+  pattern->running = false;
+  xTimerStop(pattern->timer, 0);
+  digitalWrite(pattern->pin, LOW);
+}
+
+// Runs in the timer service task: next step, set the pin, re-arm for its duration
+void LedPattern::timerCallback(TimerHandle_t timer) {
+  LedPattern *pattern = (LedPattern *)pvTimerGetTimerID(timer);
+
+  if (!pattern->running) {
+    return;
+  }
+
+  pattern->step = (pattern->step + 1) % pattern->num_steps;
+  digitalWrite(pattern->pin, (pattern->step % 2 == 0) ? HIGH : LOW);
+
+  // Never block in a timer callback
+  xTimerChangePeriod(timer, toTicks(pattern->steps[pattern->step]), 0);
+}
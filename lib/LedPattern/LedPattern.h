@@ -0,0 +1,79 @@
+/*
+  LED/GPIO blink patterns driven by FreeRTOS software timers
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A task that only toggles a pin and sleeps still needs its own stack (1024 bytes or more)
+  and TCB. A LedPattern is a one-shot software timer instead: its callback sets the pin for
+  the current step and re-arms the timer with the length of the next one. All callbacks
+  run in the timer service task that FreeRTOS already has, so every extra indicator
+  channel costs a timer control block (about 50 bytes) and no stack.
+
+  Example:
+    static LedPattern status_led;
+    static LedPattern error_led;
+    static const uint16_t double_blink[] = {100, 100, 100, 700};  // on, off, on, off (ms)
+
+    status_led.begin(LED_BUILTIN, 500, 500);
+    error_led.begin(error_pin, double_blink, 4);
+
+  Steps alternate between on and off, starting with on, and repeat forever. A pattern can
+  be retimed with begin() or setTiming() and switched off with stop(). The timer is
+  created the first time begin() is called (statically in USE_STATIC_ALLOCATION builds,
+  see lib/StaticAlloc). begin() and stop() only queue the change, the timer service task
+  applies it between two callbacks (xTimerPendFunctionCall), so they return before the
+  pin changes. On and off times of a simple blink come from user input in some demos,
+  they are clamped to 0..65535 ms (0 is one tick). Callbacks must not block, so keep the
+  number of timer commands from other tasks below configTIMER_QUEUE_LENGTH per tick.
+*/
+
+#ifndef LED_PATTERN_H
+#define LED_PATTERN_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+class LedPattern {
+public:
+
+  // Blink `pin`: on for on_ms, off for off_ms (clamped to 0..65535)
+  bool begin(uint8_t pin, long on_ms, long off_ms);
+
+  // Play `steps` (ms, on/off alternating, even count) on `pin`. The array is not copied
+  // and must stay valid while the pattern runs.
+  bool begin(uint8_t pin, const uint16_t *steps, uint8_t num_steps);
+
+  // Change the on/off time of a simple blink, takes effect at the next step
+  void setTiming(long on_ms, long off_ms);
+
+  // Stop the pattern and switch the pin off
+  void stop();
+
+  bool isRunning() const { return running; }
+
+private:
+
+  static void timerCallback(TimerHandle_t timer);
+  static void applyBegin(void *pattern, uint32_t unused);
+  static void applyStop(void *pattern, uint32_t unused);
+  static TickType_t toTicks(uint16_t ms);
+  static uint16_t clampMs(long ms);
+
+  TimerStorage timer_storage;
+  TimerHandle_t timer = NULL;
+  const uint16_t *steps = NULL;
+  uint16_t blink_steps[2] = {0, 0};
+  uint8_t num_steps = 0;
+  uint8_t step = 0;
+  uint8_t pin = 0;
+  volatile bool running = false;
+
+  // Handed from begin() to applyBegin()
+  portMUX_TYPE pending_lock = portMUX_INITIALIZER_UNLOCKED;
+  const uint16_t *pending_steps = NULL;
+  uint8_t pending_num_steps = 0;
+  uint8_t pending_pin = 0;
+};
+
+#endif
@@ -0,0 +1,450 @@
+/*
+  Lock ordering validator (lockdep) for mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "Lockdep.h"
+
+#if LOCKDEP
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+
+#include <freertos/FreeRTOS.h>
+
+static portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+static inline void lockTables() { portENTER_CRITICAL(&spinlock); }
+static inline void unlockTables() { portEXIT_CRITICAL(&spinlock); }
+
+#else
+
+#include <mutex>
+
+static std::mutex tables_mutex;
+static inline void lockTables() { tables_mutex.lock(); }
+static inline void unlockTables() { tables_mutex.unlock(); }
+
+#endif
+
+#if LOCKDEP_MAX_CLASSES > 32
+  #error "LOCKDEP_MAX_CLASSES can be at most 32"
+#endif
+
+#define NO_CLASS 0xff
+
+// A lock and its class
+typedef struct LockRecord {
+  const void *lock;                 // NULL if the slot is unused
+  uint8_t lock_class;
+} LockRecord;
+
+// Locks a task holds right now, in the order it took them
+typedef struct TaskRecord {
+  const void *task;                 // NULL if the slot is unused
+  uint8_t depth;
+  uint8_t held[LOCKDEP_MAX_HELD];
+} TaskRecord;
+
+// Where an order was learned
+typedef struct EdgeRecord {
+  uint8_t from;
+  uint8_t to;
+  const char *task_name;
+  const char *file;
+  int line;
+} EdgeRecord;
+
+// Globals
+static const char *class_names[LOCKDEP_MAX_CLASSES];
+static char class_anonymous[LOCKDEP_MAX_CLASSES][12];   // Names for unregistered locks
+static uint32_t after[LOCKDEP_MAX_CLASSES];             // Bit b of after[a]: a -> b learned
+static uint32_t reported[LOCKDEP_MAX_CLASSES];          // Bit b of reported[a]: pair reported
+static LockRecord locks[LOCKDEP_MAX_LOCKS];
+static TaskRecord tasks[LOCKDEP_MAX_TASKS];
+static EdgeRecord edges[LOCKDEP_MAX_EDGES];
+static uint32_t class_slots = 0;                          // Slots of class_names ever used
+static LockdepStats lockdep_stats;
+static LockdepHandler lockdep_handler = lockdepPrint;
+
+//*****************************************************************************
+// Helpers (call with the tables locked)
+
+// __FILE__ holds the full build path, only the file name is interesting
+static const char *baseName(const char *path) {
+  const char *name = path;
+  for (const char *p = path; p != NULL && *p != '\0'; p++) {
+    if (*p == '/' || *p == '\\') {
+      name = p + 1;
+    }
+  }
+  return name;
+}
+
+// A free class slot named `name` (one freed by mergeClass() first), NO_CLASS if the
+// table is full
+static uint8_t allocClass(const char *name) {
+  uint32_t slot = 0;
+  while (slot < class_slots && class_names[slot] != NULL) {
+    slot++;
+  }
+  if (slot == LOCKDEP_MAX_CLASSES) {
+    return NO_CLASS;
+  }
+  if (slot == class_slots) {
+    class_slots++;
+  }
+  class_names[slot] = name;
+  lockdep_stats.classes++;
+  return (uint8_t)slot;
+}
+
+// Class called `name`, NO_CLASS if there is none
+static uint8_t lookupClass(const char *name) {
+  for (uint32_t i = 0; i < class_slots; i++) {
+    if (class_names[i] != NULL && strcmp(class_names[i], name) == 0) {
+      return (uint8_t)i;
+    }
+  }
+  return NO_CLASS;
+}
+
+// Class called `name`, a new one if there is none yet, NO_CLASS if the table is full
+static uint8_t findClass(const char *name) {
+  uint8_t lock_class = lookupClass(name);
+  return (lock_class != NO_CLASS) ? lock_class : allocClass(name);
+}
+
+// The class a lock got when it was taken before it was registered
+static bool isAnonymous(uint8_t lock_class) {
+  return class_names[lock_class] == class_anonymous[lock_class];
+}
+
+// Everything learned about class `from` moves to class `into`, then `from` is freed
+static void mergeClass(uint8_t from, uint8_t into) {
+  uint32_t from_bit = 1u << from;
+  uint32_t into_bit = 1u << into;
+
+  // Rename the edges, drop the ones that became a loop or a duplicate
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < lockdep_stats.edges; i++) {
+    EdgeRecord edge = edges[i];
+    edge.from = (edge.from == from) ? into : edge.from;
+    edge.to = (edge.to == from) ? into : edge.to;
+
+    bool drop = (edge.from == edge.to);
+    for (uint32_t k = 0; k < kept && !drop; k++) {
+      drop = (edges[k].from == edge.from && edges[k].to == edge.to);
+    }
+    if (!drop) {
+      edges[kept++] = edge;
+    }
+  }
+  lockdep_stats.edges = kept;
+
+  memset(after, 0, sizeof(after));
+  for (uint32_t i = 0; i < kept; i++) {
+    after[edges[i].from] |= 1u << edges[i].to;
+  }
+
+  reported[into] |= reported[from];
+  reported[from] = 0;
+  for (uint32_t i = 0; i < class_slots; i++) {
+    if (reported[i] & from_bit) {
+      reported[i] = (reported[i] & ~from_bit) | into_bit;
+    }
+  }
+
+  for (int i = 0; i < LOCKDEP_MAX_LOCKS; i++) {
+    if (locks[i].lock != NULL && locks[i].lock_class == from) {
+      locks[i].lock_class = into;
+    }
+  }
+  for (int i = 0; i < LOCKDEP_MAX_TASKS; i++) {
+    for (uint8_t k = 0; k < tasks[i].depth; k++) {
+      if (tasks[i].held[k] == from) {
+        tasks[i].held[k] = into;
+      }
+    }
+  }
+
+  class_names[from] = NULL;
+  lockdep_stats.classes--;
+}
+
+// Record of `lock`, a new one in `lock_class` if it has none yet (NO_CLASS: a class of its
+// own), NULL if a table is full
+static LockRecord *findLock(const void *lock, uint8_t lock_class) {
+  LockRecord *unused = NULL;
+
+  for (int i = 0; i < LOCKDEP_MAX_LOCKS; i++) {
+    if (locks[i].lock == lock) {
+      return &locks[i];
+    }
+    if (locks[i].lock == NULL && unused == NULL) {
+      unused = &locks[i];
+    }
+  }
+  if (unused == NULL) {
+    return NULL;
+  }
+
+  if (lock_class == NO_CLASS) {
+    lock_class = allocClass("");
+    if (lock_class == NO_CLASS) {
+      return NULL;
+    }
+    snprintf(class_anonymous[lock_class], sizeof(class_anonymous[lock_class]), "%p", lock);
+    class_names[lock_class] = class_anonymous[lock_class];
+  }
+
+  unused->lock = lock;
+  unused->lock_class = lock_class;
+  return unused;
+}
+
+static TaskRecord *findTask(const void *task, bool create) {
+  TaskRecord *unused = NULL;
+
+  for (int i = 0; i < LOCKDEP_MAX_TASKS; i++) {
+    if (tasks[i].task == task) {
+      return &tasks[i];
+    }
+    if (tasks[i].task == NULL && unused == NULL) {
+      unused = &tasks[i];
+    }
+  }
+  if (unused != NULL && create) {
+    unused->task = task;
+    unused->depth = 0;
+    return unused;
+  }
+  return NULL;
+}
+
+static const EdgeRecord *findEdge(uint8_t from, uint8_t to) {
+  for (uint32_t i = 0; i < lockdep_stats.edges; i++) {
+    if (edges[i].from == from && edges[i].to == to) {
+      return &edges[i];
+    }
+  }
+  return NULL;
+}
+
+// First step of a learned path from -> ... -> to, NULL if there is none
+static const EdgeRecord *findPath(uint8_t from, uint8_t to) {
+  uint32_t target = 1u << to;
+  uint32_t visited = 0;
+
+  for (uint32_t first = after[from]; first != 0; first &= first - 1) {
+    uint8_t step = (uint8_t)__builtin_ctz(first);
+    uint32_t frontier = 1u << step;
+
+    // Breadth first through everything reachable from this first step
+    while (frontier != 0) {
+      if (frontier & target) {
+        return findEdge(from, step);
+      }
+      visited |= frontier;
+      uint32_t next = 0;
+      for (uint32_t f = frontier; f != 0; f &= f - 1) {
+        next |= after[__builtin_ctz(f)];
+      }
+      frontier = next & ~visited;
+    }
+  }
+  return NULL;
+}
+
+//*****************************************************************************
+// Public API
+
+void lockdepRegister(const void *lock, const char *name) {
+  lockTables();
+  LockRecord *record = NULL;
+  for (int i = 0; i < LOCKDEP_MAX_LOCKS && record == NULL; i++) {
+    if (locks[i].lock == lock) {
+      record = &locks[i];
+    }
+  }
+
+  if (record != NULL && isAnonymous(record->lock_class)) {
+    // Taken before it got its name: the anonymous class becomes the named one, or is
+    // merged into it (with the orders learned so far) and freed
+    uint8_t named = lookupClass(name);
+    if (named == NO_CLASS) {
+      class_names[record->lock_class] = name;
+    } else {
+      mergeClass(record->lock_class, named);
+    }
+  } else {
+    uint8_t lock_class = findClass(name);
+    if (lock_class != NO_CLASS && record != NULL) {
+      record->lock_class = lock_class;
+    } else if (lock_class != NO_CLASS) {
+      findLock(lock, lock_class);
+    }
+  }
+  unlockTables();
+}
+
+void lockdepAcquire(const void *task, const char *task_name, const void *lock,
+                    const char *file, int line) {
+  LockdepViolation violation;
+  bool found = false;
+
+  lockTables();
+  lockdep_stats.acquires++;
+  LockRecord *record = findLock(lock, NO_CLASS);
+  TaskRecord *holder = (record != NULL) ? findTask(task, true) : NULL;
+  if (holder == NULL || holder->depth == LOCKDEP_MAX_HELD) {
+    lockdep_stats.untracked++;
+    unlockTables();
+    return;
+  }
+
+  uint8_t taken = record->lock_class;
+  for (uint8_t i = 0; i < holder->depth; i++) {
+    uint8_t held = holder->held[i];
+    const EdgeRecord *order = (held == taken) ? NULL : findPath(taken, held);
+
+    if (held == taken || order != NULL) {
+      // Inversion (or the same class twice): report it once, learn nothing from it
+      if (!found && !(reported[taken] & (1u << held))) {
+        reported[taken] |= 1u << held;
+        lockdep_stats.violations++;
+        found = true;
+        violation.same_class = (held == taken);
+        violation.task_name = task_name;
+        violation.taken_name = class_names[taken];
+        violation.held_name = class_names[held];
+        violation.file = file;
+        violation.line = line;
+        violation.order_next_name = (order != NULL) ? class_names[order->to] : NULL;
+        violation.order_task_name = (order != NULL) ? order->task_name : NULL;
+        violation.order_file = (order != NULL) ? order->file : NULL;
+        violation.order_line = (order != NULL) ? order->line : 0;
+      }
+    } else if (!(after[held] & (1u << taken))) {
+      // New order held -> taken
+      if (lockdep_stats.edges < LOCKDEP_MAX_EDGES) {
+        EdgeRecord &edge = edges[lockdep_stats.edges++];
+        edge.from = held;
+        edge.to = taken;
+        edge.task_name = task_name;
+        edge.file = file;
+        edge.line = line;
+        after[held] |= 1u << taken;
+      } else {
+        lockdep_stats.untracked++;
+      }
+    }
+  }
+  holder->held[holder->depth++] = taken;
+  LockdepHandler handler = lockdep_handler;
+  unlockTables();
+
+  if (found) {
+    handler(violation);
+  }
+}
+
+void lockdepRelease(const void *task, const void *lock) {
+  lockTables();
+  TaskRecord *holder = findTask(task, false);
+  uint8_t lock_class = NO_CLASS;
+  for (int i = 0; i < LOCKDEP_MAX_LOCKS; i++) {
+    if (locks[i].lock == lock) {
+      lock_class = locks[i].lock_class;
+      break;
+    }
+  }
+
+  if (holder != NULL && lock_class != NO_CLASS) {
+    // Usually the last one taken, but any order is allowed
+    for (int i = holder->depth - 1; i >= 0; i--) {
+      if (holder->held[i] == lock_class) {
+        memmove(&holder->held[i], &holder->held[i + 1], holder->depth - i - 1);
+        holder->depth--;
+        break;
+      }
+    }
+    if (holder->depth == 0) {
+      holder->task = NULL;
+    }
+  }
+  unlockTables();
+}
+
+void lockdepSetHandler(LockdepHandler handler) {
+  lockTables();
+  lockdep_handler = (handler != NULL) ? handler : lockdepPrint;
+  unlockTables();
+}
+
+void lockdepPrint(const LockdepViolation &violation) {
+  const char *task_name = (violation.task_name != NULL) ? violation.task_name : "?";
+
+  if (violation.same_class) {
+    printf("Lock order: %s takes a second %s at %s:%d\n",
+           task_name, violation.taken_name, baseName(violation.file), violation.line);
+    return;
+  }
+
+  printf("Lock order inversion: %s takes %s at %s:%d while holding %s\n",
+         task_name, violation.taken_name, baseName(violation.file), violation.line,
+         violation.held_name);
+  if (violation.order_file != NULL) {
+    printf("  %s -> %s was learned at %s:%d (%s)",
+           violation.taken_name, violation.order_next_name,
+           baseName(violation.order_file), violation.order_line,
+           (violation.order_task_name != NULL) ? violation.order_task_name : "?");
+    if (violation.order_next_name != violation.held_name) {
+      printf(", and %s comes before %s", violation.order_next_name, violation.held_name);
+    }
+    printf("\n");
+  }
+}
+
+void lockdepDumpOrder() {
+
+  // One edge at a time out of the tables, printf() must not run in a critical section
+  for (uint32_t i = 0; ; i++) {
+    lockTables();
+    if (i >= lockdep_stats.edges) {
+      unlockTables();
+      break;
+    }
+    const char *from = class_names[edges[i].from];
+    const char *to = class_names[edges[i].to];
+    const char *file = edges[i].file;
+    int line = edges[i].line;
+    unlockTables();
+
+    printf("  %s -> %s  (%s:%d)\n", from, to, baseName(file), line);
+  }
+}
+
+void lockdepGetStats(LockdepStats *stats) {
+  lockTables();
+  *stats = lockdep_stats;
+  unlockTables();
+}
+
+void lockdepReset() {
+  lockTables();
+  memset(after, 0, sizeof(after));
+  memset(reported, 0, sizeof(reported));
+  memset(locks, 0, sizeof(locks));
+  memset(tasks, 0, sizeof(tasks));
+  memset(edges, 0, sizeof(edges));
+  memset(class_names, 0, sizeof(class_names));
+  memset(&lockdep_stats, 0, sizeof(lockdep_stats));
+  class_slots = 0;
+  unlockTables();
+}
+
+#endif
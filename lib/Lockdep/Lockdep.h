@@ -0,0 +1,115 @@
+/*
+  Lock ordering validator (lockdep) for mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A lock hierarchy ("always take mutex_1 before mutex_2") is only a convention; code that
+  breaks it can run for months before two tasks happen to interleave the wrong way and
+  deadlock. With LOCKDEP=1 every lock belongs to a class (by name, so all instances of
+  one kind of lock share it) and the validator learns the order in which classes are
+  taken: taking B while holding A records A -> B. Taking A while holding B later is an
+  inversion, and it is reported the first time it happens, whether or not the other task
+  is anywhere near:
+
+    Lock order inversion: Task B takes mutex 1 at demo.cpp:93 while holding mutex 2
+      mutex 1 -> mutex 2 was learned at demo.cpp:62 (Task A)
+
+  Orders are transitive, so A -> B and B -> C also make C-while-holding-A fine and
+  A-while-holding-C an inversion. Taking a second lock of a class that is already held
+  is reported too. Each pair of classes is reported once.
+
+  On the ESP32 the mutex macros of lib/DeadlockDetector (TRACKED_TAKE(), TRACKED_GIVE(),
+  TRACKED_NAME()) feed the validator when it is enabled. The validator itself does not use
+  FreeRTOS, so host programs can call it directly (host-tools/src/lock-order.cpp plays the
+  scripts of a lock scenario through it). Without LOCKDEP none of it is compiled.
+
+  Limits: LOCKDEP_MAX_CLASSES classes (at most 32), LOCKDEP_MAX_LOCKS locks,
+  LOCKDEP_MAX_TASKS tasks holding locks at once, LOCKDEP_MAX_HELD locks per task and
+  LOCKDEP_MAX_EDGES learned orders. Whatever doesn't fit is counted in
+  LockdepStats::untracked and not checked.
+*/
+
+#ifndef LOCKDEP_H
+#define LOCKDEP_H
+
+#include <stdint.h>
+
+#ifndef LOCKDEP
+  #define LOCKDEP 0
+#endif
+
+#ifndef LOCKDEP_MAX_CLASSES
+  #define LOCKDEP_MAX_CLASSES 32
+#endif
+
+#ifndef LOCKDEP_MAX_LOCKS
+  #define LOCKDEP_MAX_LOCKS 32
+#endif
+
+#ifndef LOCKDEP_MAX_TASKS
+  #define LOCKDEP_MAX_TASKS 16
+#endif
+
+#ifndef LOCKDEP_MAX_HELD
+  #define LOCKDEP_MAX_HELD 8
+#endif
+
+#ifndef LOCKDEP_MAX_EDGES
+  #define LOCKDEP_MAX_EDGES 64
+#endif
+
+// One reported problem
+typedef struct LockdepViolation {
+  bool same_class;              // A second lock of a class that is already held
+  const char *task_name;        // Task that takes the lock
+  const char *taken_name;       // Class being taken
+  const char *held_name;        // Class held at that moment
+  const char *file;             // Where it is taken
+  int line;
+  const char *order_next_name;  // First step of the opposite order, taken_name -> this
+  const char *order_task_name;  // Where that step was learned
+  const char *order_file;
+  int order_line;
+} LockdepViolation;
+
+// Validator counters (see lockdepGetStats())
+typedef struct LockdepStats {
+  uint32_t classes;
+  uint32_t edges;               // Orders learned
+  uint32_t acquires;
+  uint32_t violations;          // Reported (each pair once)
+  uint32_t untracked;           // Acquires not checked because a table was full
+} LockdepStats;
+
+typedef void (*LockdepHandler)(const LockdepViolation &violation);
+
+#if LOCKDEP
+
+// Put `lock` (any pointer that identifies it, e.g. a SemaphoreHandle_t) in class `name`
+// (kept, not copied). A lock taken without this gets a class of its own, named after its
+// address; registering it later renames that class, or merges it (with the orders
+// learned on it) into an existing class `name` and frees it.
+void lockdepRegister(const void *lock, const char *name);
+
+// `task` is about to take `lock` (checks and records it as held), and has given it back
+// (also after a take that failed)
+void lockdepAcquire(const void *task, const char *task_name, const void *lock,
+                    const char *file, int line);
+void lockdepRelease(const void *task, const void *lock);
+
+// Who gets the reports (NULL: print them with printf())
+void lockdepSetHandler(LockdepHandler handler);
+void lockdepPrint(const LockdepViolation &violation);
+
+// Print every learned order, "a -> b  (file:line)"
+void lockdepDumpOrder();
+
+void lockdepGetStats(LockdepStats *stats);
+
+// Forget everything (between host test cases)
+void lockdepReset();
+
+#endif
+
+#endif
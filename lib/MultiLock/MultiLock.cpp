@@ -0,0 +1,139 @@
+/*
+  All-or-nothing take of several FreeRTOS mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "MultiLock.h"
+#include <esp_timer.h>
+
+//*****************************************************************************
+// Helpers
+
+// Canonical order: ascending handle (insertion sort, sets are small)
+static void sortMutexes(SemaphoreHandle_t *mutexes, size_t count) {
+  for (size_t i = 1; i < count; i++) {
+    SemaphoreHandle_t mutex = mutexes[i];
+    size_t j = i;
+    while (j > 0 && (uintptr_t)mutexes[j - 1] > (uintptr_t)mutex) {
+      mutexes[j] = mutexes[j - 1];
+      j--;
+    }
+    mutexes[j] = mutex;
+  }
+}
+
+// Ticks left of `timeout` counted from `start`, 0 once it has passed
+static TickType_t ticksLeft(TickType_t start, TickType_t timeout) {
+  TickType_t elapsed = xTaskGetTickCount() - start;
+  return (elapsed < timeout) ? timeout - elapsed : 0;
+}
+
+static void noteResult(TakeAllStats *stats, bool taken, uint32_t backoffs, int64_t start_us) {
+  if (stats == NULL) {
+    return;
+  }
+
+  uint32_t wait_us = (uint32_t)(esp_timer_get_time() - start_us);
+  stats->calls++;
+  if (taken) {
+    stats->taken++;
+  } else {
+    stats->timeouts++;
+  }
+  if (backoffs > 0) {
+    stats->contended++;
+    stats->backoffs += backoffs;
+  }
+  if (backoffs > stats->max_backoffs) {
+    stats->max_backoffs = backoffs;
+  }
+  if (wait_us > stats->max_wait_us) {
+    stats->max_wait_us = wait_us;
+  }
+}
+
+//*****************************************************************************
+// Public API
+
+bool takeAll(const SemaphoreHandle_t *mutexes, size_t count, TickType_t timeout,
+             TakeAllStats *stats) {
+  configASSERT(count > 0 && count <= TAKE_ALL_MAX_MUTEXES);
+
+  SemaphoreHandle_t sorted[TAKE_ALL_MAX_MUTEXES];
+  for (size_t i = 0; i < count; i++) {
+    sorted[i] = mutexes[i];
+  }
+  sortMutexes(sorted, count);
+
+  int64_t start_us = esp_timer_get_time();
+  TickType_t start = xTaskGetTickCount();
+  TickType_t window = TAKE_ALL_BACKOFF_MIN_TICKS;
+  uint32_t backoffs = 0;
+
+  while (1) {
+    TickType_t left = (timeout == portMAX_DELAY) ? portMAX_DELAY : ticksLeft(start, timeout);
+
+    // Wait for the first one only, nothing is held yet
+    if (xSemaphoreTake(sorted[0], left) == pdTRUE) {
+      size_t held = 1;
+      while (held < count && xSemaphoreTake(sorted[held], 0) == pdTRUE) {
+        held++;
+      }
+      if (held == count) {
+        noteResult(stats, true, backoffs, start_us);
+        return true;
+      }
+
+      // One is busy: give back the rest in reverse order
+      while (held > 0) {
+        xSemaphoreGive(sorted[--held]);
+      }
+    }
+
+    // Random back-off in a window that doubles up to the maximum
+    left = (timeout == portMAX_DELAY) ? portMAX_DELAY : ticksLeft(start, timeout);
+    if (left == 0) {
+      noteResult(stats, false, backoffs, start_us);
+      return false;
+    }
+    TickType_t delay = 1 + (TickType_t)(esp_random() % window);
+    vTaskDelay((delay < left) ? delay : left);
+    backoffs++;
+    if (window < TAKE_ALL_BACKOFF_MAX_TICKS) {
+      window = (window * 2 < TAKE_ALL_BACKOFF_MAX_TICKS) ? window * 2 : TAKE_ALL_BACKOFF_MAX_TICKS;
+    }
+  }
+}
+
+void giveAll(const SemaphoreHandle_t *mutexes, size_t count) {
+  configASSERT(count > 0 && count <= TAKE_ALL_MAX_MUTEXES);
+
+  SemaphoreHandle_t sorted[TAKE_ALL_MAX_MUTEXES];
+  for (size_t i = 0; i < count; i++) {
+    sorted[i] = mutexes[i];
+  }
+  sortMutexes(sorted, count);
+
+  for (size_t i = count; i > 0; i--) {
+    xSemaphoreGive(sorted[i - 1]);
+  }
+}
+
+bool takeAll(std::initializer_list<SemaphoreHandle_t> mutexes, TickType_t timeout,
+             TakeAllStats *stats) {
+  return takeAll(mutexes.begin(), mutexes.size(), timeout, stats);
+}
+
+void giveAll(std::initializer_list<SemaphoreHandle_t> mutexes) {
+  giveAll(mutexes.begin(), mutexes.size());
+}
+
+void takeAllPrintStats(Print &out, const TakeAllStats &stats) {
+  out.printf("calls %u, taken %u, timeouts %u, contended %u, backoffs %u (max %u), "
+             "max wait %u ms\n",
+             (unsigned)stats.calls, (unsigned)stats.taken, (unsigned)stats.timeouts,
+             (unsigned)stats.contended, (unsigned)stats.backoffs,
+             (unsigned)stats.max_backoffs, (unsigned)(stats.max_wait_us / 1000));
+}
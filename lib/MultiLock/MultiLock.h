@@ -0,0 +1,82 @@
+/*
+  All-or-nothing take of several FreeRTOS mutexes
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Taking mutexes one by one with a timeout (esp32-freertos-10-demo-deadlock-timeout.cpp)
+  avoids a permanent deadlock, but a task that times out on the second mutex still holds
+  the first, the code after the timeout has to remember which ones it really got, and two
+  tasks that time out together retry together and can keep getting in each other's way
+  (livelock).
+
+  takeAll() gets either every mutex of a set or none:
+
+    static TakeAllStats stats_a;
+
+    if (takeAll({mutex_1, mutex_2}, msToTicksCeil(1000), &stats_a)) {
+      ...                                   // Both held
+      giveAll({mutex_1, mutex_2});
+    } else {
+      ...                                   // Timed out, holds neither
+    }
+
+  The mutexes are taken in one canonical order (by handle), whatever order the caller
+  lists them in. Only the first one is waited for, while nothing is held yet; the others
+  are tried without waiting, and if one is busy everything taken so far is given back.
+  The task then sleeps a random time in a window that doubles with every failed attempt
+  (TAKE_ALL_BACKOFF_MIN_TICKS up to TAKE_ALL_BACKOFF_MAX_TICKS), so two tasks that collide
+  don't retry in lockstep. No task ever waits while holding one of the mutexes, so tasks
+  that only use takeAll() can't deadlock, and nobody queues up behind a task that is
+  itself waiting (no convoys).
+
+  The optional stats (one TakeAllStats per caller, e.g. per task, so no locking is
+  needed) count how often a take had to back off and how long takes took.
+  A set holds at most TAKE_ALL_MAX_MUTEXES mutexes, and none of them may be held already.
+*/
+
+#ifndef MULTI_LOCK_H
+#define MULTI_LOCK_H
+
+#include <Arduino.h>
+#include <initializer_list>
+
+#ifndef TAKE_ALL_MAX_MUTEXES
+  #define TAKE_ALL_MAX_MUTEXES 8
+#endif
+
+#ifndef TAKE_ALL_BACKOFF_MIN_TICKS
+  #define TAKE_ALL_BACKOFF_MIN_TICKS 1
+#endif
+
+#ifndef TAKE_ALL_BACKOFF_MAX_TICKS
+  #define TAKE_ALL_BACKOFF_MAX_TICKS 64
+#endif
+
+// Contention counters of the takeAll() calls that share it
+typedef struct TakeAllStats {
+  uint32_t calls;
+  uint32_t taken;             // Calls that got every mutex
+  uint32_t timeouts;          // Calls that gave up
+  uint32_t contended;         // Calls that had to back off at least once
+  uint32_t backoffs;          // Back-offs in all calls together
+  uint32_t max_backoffs;      // Most back-offs in one call
+  uint32_t max_wait_us;       // Longest call
+} TakeAllStats;
+
+// Take every mutex in `mutexes` or none, returns false on timeout (holding none)
+bool takeAll(std::initializer_list<SemaphoreHandle_t> mutexes, TickType_t timeout,
+             TakeAllStats *stats = NULL);
+
+// Give back a set taken with takeAll()
+void giveAll(std::initializer_list<SemaphoreHandle_t> mutexes);
+
+// The same for sets that are only known at run time
+bool takeAll(const SemaphoreHandle_t *mutexes, size_t count, TickType_t timeout,
+             TakeAllStats *stats = NULL);
+void giveAll(const SemaphoreHandle_t *mutexes, size_t count);
+
+// "calls 12, taken 11, timeouts 1, contended 4, backoffs 9 (max 3), max wait 812 ms"
+void takeAllPrintStats(Print &out, const TakeAllStats &stats);
+
+#endif
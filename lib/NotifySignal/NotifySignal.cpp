@@ -0,0 +1,78 @@
+/*
+  Semaphore-style signals on direct-to-task notifications
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "NotifySignal.h"
+
+//*****************************************************************************
+// NotifySignal
+
+void NotifySignal::give() {
+  if (target != NULL) {
+    xTaskNotify(target, 1, eSetValueWithOverwrite);
+  }
+}
+
+void NotifySignal::giveFromISR(BaseType_t *higher_priority_task_woken) {
+  if (target != NULL) {
+    xTaskNotifyFromISR(target, 1, eSetValueWithOverwrite, higher_priority_task_woken);
+  }
+}
+
+bool NotifySignal::take(TickType_t timeout) {
+  configASSERT(target == NULL || target == xTaskGetCurrentTaskHandle());
+  return ulTaskNotifyTake(pdTRUE, timeout) > 0;
+}
+
+//*****************************************************************************
+// NotifyCounter
+
+void NotifyCounter::give() {
+  if (target != NULL) {
+    xTaskNotifyGive(target);
+  }
+}
+
+void NotifyCounter::giveFromISR(BaseType_t *higher_priority_task_woken) {
+  if (target != NULL) {
+    vTaskNotifyGiveFromISR(target, higher_priority_task_woken);
+  }
+}
+
+bool NotifyCounter::take(TickType_t timeout) {
+  configASSERT(target == NULL || target == xTaskGetCurrentTaskHandle());
+  return ulTaskNotifyTake(pdFALSE, timeout) > 0;
+}
+
+uint32_t NotifyCounter::takeAll(TickType_t timeout) {
+  configASSERT(target == NULL || target == xTaskGetCurrentTaskHandle());
+  return ulTaskNotifyTake(pdTRUE, timeout);
+}
+
+//*****************************************************************************
+// NotifyBits
+
+void NotifyBits::set(uint32_t bits) {
+  if (target != NULL) {
+    xTaskNotify(target, bits, eSetBits);
+  }
+}
+
+void NotifyBits::setFromISR(uint32_t bits, BaseType_t *higher_priority_task_woken) {
+  if (target != NULL) {
+    xTaskNotifyFromISR(target, bits, eSetBits, higher_priority_task_woken);
+  }
+}
+
+uint32_t NotifyBits::wait(TickType_t timeout) {
+  configASSERT(target == NULL || target == xTaskGetCurrentTaskHandle());
+
+  uint32_t bits = 0;
+  if (xTaskNotifyWait(0, 0xFFFFFFFF, &bits, timeout) != pdTRUE) {
+    return 0;
+  }
+  return bits;
+}
@@ -0,0 +1,94 @@
+/*
+  Semaphore-style signals on direct-to-task notifications
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A binary semaphore used to wake one particular task (an ISR handing data to a task, a
+  child task telling its creator it has started) is a full queue object: a control block
+  of about 80 bytes, and every give and take goes through the generic queue code. Every
+  FreeRTOS task already has a notification value built into its TCB, and
+  xTaskNotifyGive()/ulTaskNotifyTake() on it are documented as up to 45 % faster. The
+  classes below keep the semaphore calls but signal the task directly:
+
+    NotifySignal  : binary, like xSemaphoreCreateBinary() (extra gives are absorbed)
+    NotifyCounter : counting, every give is one take (up to 2^32 - 1 pending)
+    NotifyBits    : event bits, set() ORs bits in and wait() returns and clears them
+
+  The only state is the handle of the receiving task, so there is nothing to create.
+
+  Example:
+    static NotifySignal value_ready;
+
+    void IRAM_ATTR onTimer() {
+      BaseType_t task_woken = pdFALSE;
+      value_ready.giveFromISR(&task_woken);
+      if (task_woken) {
+        portYIELD_FROM_ISR();
+      }
+    }
+
+    value_ready.bind(print_task.createPinnedToCore(printValues, ...));   // In setup()
+    value_ready.take(portMAX_DELAY);                                     // In printValues()
+
+  Limits compared with a semaphore: exactly one task can take (the bound one, set with
+  bind() before the first give), and that task's notification value is used, so it must
+  not use another notification-based object (e.g. WorkerPool::waitDone()) at the same
+  time. Gives before bind() are dropped.
+*/
+
+#ifndef NOTIFY_SIGNAL_H
+#define NOTIFY_SIGNAL_H
+
+#include <Arduino.h>
+
+// Receiving task of a notification-based object
+class NotifyTarget {
+public:
+
+  // Task that will take, NULL for the calling task
+  void bind(TaskHandle_t task = NULL) {
+    target = (task != NULL) ? task : xTaskGetCurrentTaskHandle();
+  }
+
+  TaskHandle_t task() const { return target; }
+
+protected:
+  TaskHandle_t target = NULL;
+};
+
+// Binary signal
+class NotifySignal : public NotifyTarget {
+public:
+  void give();
+  void giveFromISR(BaseType_t *higher_priority_task_woken);
+
+  // Wait for a give, returns false on timeout (only from the bound task)
+  bool take(TickType_t timeout);
+};
+
+// Counting signal
+class NotifyCounter : public NotifyTarget {
+public:
+  void give();
+  void giveFromISR(BaseType_t *higher_priority_task_woken);
+
+  // Take one give, returns false on timeout (only from the bound task)
+  bool take(TickType_t timeout);
+
+  // Take every pending give at once, returns how many (0 on timeout)
+  uint32_t takeAll(TickType_t timeout);
+};
+
+// Event bits
+class NotifyBits : public NotifyTarget {
+public:
+  void set(uint32_t bits);
+  void setFromISR(uint32_t bits, BaseType_t *higher_priority_task_woken);
+
+  // Wait until at least one bit is set, returns all set bits and clears them (0 on
+  // timeout, only from the bound task)
+  uint32_t wait(TickType_t timeout);
+};
+
+#endif
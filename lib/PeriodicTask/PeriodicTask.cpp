@@ -0,0 +1,93 @@
+/*
+  Drift-free periodic loops on vTaskDelayUntil() with overrun and jitter statistics
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "PeriodicTask.h"
+
+void PeriodicTask::begin(TickType_t period) {
+  last_release = xTaskGetTickCount();
+  have_wake = false;
+  setPeriod(period);
+  resetStats();
+}
+
+void PeriodicTask::setPeriod(TickType_t period) {
+
+  // A zero period would never block
+  period_ticks = (period > 0) ? period : 1;
+
+  portENTER_CRITICAL(&spinlock);
+  stats.period = period_ticks;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+bool PeriodicTask::wait() {
+  uint32_t response_us = have_wake ? micros() - last_wake_us : 0;
+  TickType_t now = xTaskGetTickCount();
+
+  // Releases that have already passed while this pass was running (they get no pass)
+  TickType_t late = now - last_release;
+  uint32_t missed = (late >= period_ticks) ? late / period_ticks : 0;
+  bool overrun = (missed > 0);
+
+  // Skip them (stay on the grid) and sleep until the first release still ahead
+  last_release += missed * period_ticks;
+  vTaskDelayUntil(&last_release, period_ticks);
+
+  uint32_t wake_us = micros();
+  uint32_t jitter_us = 0;
+  if (have_wake && !overrun) {
+    int32_t period_us = period_ticks * portTICK_PERIOD_MS * 1000;
+    int32_t error = (int32_t)(wake_us - last_wake_us) - period_us;
+    jitter_us = (error < 0) ? -error : error;
+  }
+  last_wake_us = wake_us;
+  have_wake = true;
+
+  portENTER_CRITICAL(&spinlock);
+  stats.releases++;
+  if (overrun) {
+    stats.overruns++;
+    stats.skipped_releases += missed;
+  }
+  if (jitter_us > stats.max_jitter_us) {
+    stats.max_jitter_us = jitter_us;
+  }
+  if (response_us > stats.max_response_us) {
+    stats.max_response_us = response_us;
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  return !overrun;
+}
+
+void PeriodicTask::getStats(PeriodicStats *out) {
+  portENTER_CRITICAL(&spinlock);
+  *out = stats;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void PeriodicTask::resetStats() {
+  portENTER_CRITICAL(&spinlock);
+  stats = {};
+  stats.period = period_ticks;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void PeriodicTask::printStats(Print &out, const char *name) {
+  PeriodicStats snapshot;
+  getStats(&snapshot);
+
+  out.printf("%s: period %u ms, %u releases, %u overruns (%u skipped), "
+             "max jitter %u us, max response %u us\n",
+             name,
+             (unsigned)(snapshot.period * portTICK_PERIOD_MS),
+             (unsigned)snapshot.releases,
+             (unsigned)snapshot.overruns,
+             (unsigned)snapshot.skipped_releases,
+             (unsigned)snapshot.max_jitter_us,
+             (unsigned)snapshot.max_response_us);
+}
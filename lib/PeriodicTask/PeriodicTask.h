@@ -0,0 +1,78 @@
+/*
+  Drift-free periodic loops on vTaskDelayUntil() with overrun and jitter statistics
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A loop that ends with vTaskDelay(period) sleeps for `period` after the work is done, so
+  every pass is longer than the period by the execution time plus any preemption, and the
+  phase drifts further with every pass. PeriodicTask keeps absolute release times instead:
+  release n is at start + n * period, and wait() sleeps until the next one with
+  vTaskDelayUntil(). Work and preemption only use up slack, they no longer move the grid.
+
+  Example:
+    static PeriodicTask blink_period;
+
+    void blinkLED(void *parameters) {
+      blink_period.begin(pdMS_TO_TICKS(500));
+      while (1) {
+        digitalWrite(led_pin, !digitalRead(led_pin));
+        blink_period.wait();
+      }
+    }
+
+  If a pass runs past the next release (an overrun), wait() does not try to catch up with
+  a burst of back-to-back passes. It skips to the next release that is still in the
+  future, so the loop stays on its original phase, and counts the overrun and the skipped
+  releases. It also records:
+
+  - the period jitter: how far the time between two wake-ups differs from the period
+  - the response time: from a wake-up until the loop calls wait() again
+
+  getStats() may be called from any task; everything else belongs to the periodic task.
+*/
+
+#ifndef PERIODIC_TASK_H
+#define PERIODIC_TASK_H
+
+#include <Arduino.h>
+
+// Counters since begin() or resetStats()
+typedef struct PeriodicStats {
+  TickType_t period;          // Current period in ticks
+  uint32_t releases;          // Passes started
+  uint32_t overruns;          // Passes that were still running at their next release
+  uint32_t skipped_releases;  // Releases that got no pass because of overruns
+  uint32_t max_jitter_us;     // Largest |time between wake-ups - period|
+  uint32_t max_response_us;   // Longest time from wake-up to the next wait()
+} PeriodicStats;
+
+class PeriodicTask {
+public:
+
+  // Start the grid at the current tick with the given period (at least one tick)
+  void begin(TickType_t period);
+
+  // New period, used from the next release on (the current phase is kept)
+  void setPeriod(TickType_t period);
+  TickType_t period() const { return period_ticks; }
+
+  // Sleep until the next release. Returns false if this pass overran.
+  bool wait();
+
+  void getStats(PeriodicStats *stats);
+  void resetStats();
+
+  // One-line summary, e.g. "Blink LED: 1200 releases, 3 overruns (5 skipped), ..."
+  void printStats(Print &out, const char *name);
+
+private:
+  TickType_t last_release = 0;
+  TickType_t period_ticks = 1;
+  uint32_t last_wake_us = 0;
+  bool have_wake = false;
+  PeriodicStats stats = {};
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+  Microsecond delays below the tick, and ms/us to tick conversion that rounds up
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "PreciseDelay.h"
+
+// Settings
+static const int calibration_runs = 16;
+static const uint32_t calibration_sleep_us = 500;
+static const uint32_t extra_margin_us = 10;    // On top of the worst latency measured
+
+// Runs in the esp_timer task
+void PreciseDelay::timerCallback(void *arg) {
+  PreciseDelay *delay = (PreciseDelay *)arg;
+  xSemaphoreGive(delay->wake);
+}
+
+void PreciseDelay::sleepUntilUs(int64_t wake_us) {
+  int64_t now = esp_timer_get_time();
+  if (wake_us <= now) {
+    return;
+  }
+  esp_timer_start_once(timer, wake_us - now);
+  xSemaphoreTake(wake, portMAX_DELAY);
+}
+
+bool PreciseDelay::begin() {
+  if (timer != NULL) {
+    return true;
+  }
+
+  wake = wake_storage.create();
+  if (wake == NULL) {
+    return false;
+  }
+
+  esp_timer_create_args_t args = {};
+  args.callback = timerCallback;
+  args.arg = this;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "precise_delay";
+  if (esp_timer_create(&args, &timer) != ESP_OK) {
+    timer = NULL;
+    return false;
+  }
+
+  // Worst time between the requested wake-up and this task running again
+  uint32_t worst_us = 0;
+  for (int i = 0; i < calibration_runs; i++) {
+    int64_t wake_us = esp_timer_get_time() + calibration_sleep_us;
+    sleepUntilUs(wake_us);
+    uint32_t late_us = (uint32_t)(esp_timer_get_time() - wake_us);
+    if (late_us > worst_us) {
+      worst_us = late_us;
+    }
+  }
+  spin_margin_us = worst_us + extra_margin_us;
+  return true;
+}
+
+void PreciseDelay::delayUntilUs(int64_t deadline_us) {
+  configASSERT(timer != NULL);  // begin() first
+
+  // Sleep through the bulk of it, if there is enough time left to be worth it
+  int64_t wake_us = deadline_us - spin_margin_us;
+  if (wake_us - esp_timer_get_time() > (int64_t)spin_margin_us) {
+    sleepUntilUs(wake_us);
+  }
+  spinUntilUs(deadline_us);
+}
+
+void PreciseDelay::delayUs(uint32_t us) {
+  delayUntilUs(esp_timer_get_time() + us);
+}
@@ -0,0 +1,79 @@
+/*
+  Microsecond delays below the tick, and ms/us to tick conversion that rounds up
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  vTaskDelay() counts whole ticks. With a 100 Hz tick, vTaskDelay(1 / portTICK_PERIOD_MS)
+  is vTaskDelay(0) (just a yield), and led_delay / portTICK_PERIOD_MS cuts 15 ms down to
+  10 ms. The conversion helpers below round up instead, so a delay or timeout is never
+  shorter than asked for:
+
+    vTaskDelay(msToTicksCeil(1));                          // At least 1 ms
+    xSemaphoreTake(sem, usToTicksCeil(2500));              // Timeout of at least 2.5 ms
+
+  For waits shorter than a tick, or that must end at a precise microsecond, a PreciseDelay
+  sleeps on a one-shot esp_timer (the hardware timer behind esp_timer_get_time()) until
+  shortly before the deadline and spins for the rest. The spin margin is measured once in
+  begin(): the worst wake-up latency of the timer callback plus the task switch. Waits
+  shorter than the margin only spin. The global tick rate does not change.
+
+  Example:
+    static PreciseDelay precise;
+
+    precise.begin();        // Once, from the task that will use it
+    precise.delayUs(350);   // Blocks for ~300 us, spins the last ~50 us
+
+  Each PreciseDelay wakes one task at a time; give every task that needs one its own.
+  Only delays are microsecond accurate; timeouts on queues and semaphores stay
+  tick-based (round them with usToTicksCeil()).
+*/
+
+#ifndef PRECISE_DELAY_H
+#define PRECISE_DELAY_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <StaticAlloc.h>
+
+// Ticks for at least `ms` milliseconds / `us` microseconds
+static inline TickType_t msToTicksCeil(uint32_t ms) {
+  return (TickType_t)(((uint64_t)ms * configTICK_RATE_HZ + 999) / 1000);
+}
+
+static inline TickType_t usToTicksCeil(uint64_t us) {
+  return (TickType_t)((us * configTICK_RATE_HZ + 999999) / 1000000);
+}
+
+// Busy-wait until esp_timer_get_time() reaches `deadline_us`
+static inline void spinUntilUs(int64_t deadline_us) {
+  while (esp_timer_get_time() < deadline_us) {
+  }
+}
+
+class PreciseDelay {
+public:
+
+  // Create the timer and measure the wake-up latency, returns false if that failed
+  bool begin();
+
+  void delayUs(uint32_t us);
+
+  // Wait until esp_timer_get_time() == deadline_us (returns at once if that has passed)
+  void delayUntilUs(int64_t deadline_us);
+
+  // Microseconds spun at the end of every sleeping delay
+  uint32_t spinMarginUs() const { return spin_margin_us; }
+
+private:
+
+  static void timerCallback(void *arg);
+  void sleepUntilUs(int64_t wake_us);
+
+  esp_timer_handle_t timer = NULL;
+  SemaphoreHandle_t wake = NULL;
+  BinarySemaphoreStorage wake_storage;
+  uint32_t spin_margin_us = 0;
+};
+
+#endif
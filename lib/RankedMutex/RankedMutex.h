@@ -0,0 +1,111 @@
+/*
+  Mutexes with a rank checked at compile time
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  The hierarchy solution to deadlock (10-deadlocks-and-starvation) only works if every
+  task takes the mutexes in the same order. lib/Lockdep finds a violation once the code
+  runs; here the order is part of the types, so a violation does not build.
+
+  A RankedMutex<Rank> is an ordinary FreeRTOS mutex with a rank. It is taken by creating
+  a LockGuard, which holds it until the end of the scope (so mutexes are given back in
+  reverse order by construction). The first guard of a scope starts from NO_LOCKS, every
+  further one from the guard of the mutex taken last, and a guard can only be made for a
+  mutex of a higher rank than the one it starts from:
+
+    static RankedMutex<1> mutex_1;
+    static RankedMutex<2> mutex_2;
+
+    {
+      LockGuard<1> guard_1(NO_LOCKS, mutex_1);
+      LockGuard<2> guard_2(guard_1, mutex_2);     // Fine, 2 after 1
+      ...
+    }                                             // mutex_2, then mutex_1 given back
+
+    LockGuard<1> guard_1(guard_2, mutex_1);       // error: static assertion failed:
+                                                  // mutexes must be taken in increasing rank
+
+  A function that takes a mutex while its caller holds others gets the caller's guard
+  as a parameter (const LockGuard<N> &), which carries the check across the call. Nothing
+  is stored at run time besides the mutex handle in each guard, so a release build costs
+  exactly the xSemaphoreTake()/xSemaphoreGive() calls it replaces.
+
+  The types can't see a guard that is in scope but not passed on: starting from NO_LOCKS
+  while holding a guard defeats the check (lib/Lockdep still catches it, the mutexes are
+  taken through the macros of lib/DeadlockDetector). A guard made with a timeout may come
+  back without the mutex, test it before use. The mutex comes from lib/StaticAlloc
+  (static in USE_STATIC_ALLOCATION builds).
+*/
+
+#ifndef RANKED_MUTEX_H
+#define RANKED_MUTEX_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <DeadlockDetector.h>
+
+template <unsigned Rank>
+class RankedMutex {
+public:
+
+  static_assert(Rank > 0, "rank 0 is NO_LOCKS, mutexes start at 1");
+
+  // Create the mutex (named for lib/DeadlockDetector and lib/Lockdep), returns false if
+  // it could not be created
+  bool begin(const char *name = NULL) {
+    handle = storage.create();
+    if (handle != NULL && name != NULL) {
+      TRACKED_NAME(handle, name);
+    }
+    return handle != NULL;
+  }
+
+  SemaphoreHandle_t getHandle() const { return handle; }
+
+private:
+  MutexStorage storage;
+  SemaphoreHandle_t handle = NULL;
+};
+
+// Held mutexes of a scope, as far as the types can tell: the highest rank
+template <unsigned Rank>
+class LockGuard {
+public:
+
+  // Take `mutex` after the mutexes of `held` (NO_LOCKS for the first one)
+  template <unsigned HeldRank>
+  LockGuard(const LockGuard<HeldRank> &held, RankedMutex<Rank> &mutex,
+            TickType_t timeout = portMAX_DELAY) {
+    static_assert(Rank > HeldRank, "mutexes must be taken in increasing rank");
+    (void)held;
+    handle = TRACKED_TAKE(mutex.getHandle(), timeout) ? mutex.getHandle() : NULL;
+  }
+
+  ~LockGuard() {
+    if (handle != NULL) {
+      TRACKED_GIVE(handle);
+    }
+  }
+
+  LockGuard(const LockGuard &) = delete;
+  LockGuard &operator=(const LockGuard &) = delete;
+
+  // False if the take timed out
+  bool owns() const { return handle != NULL; }
+  explicit operator bool() const { return owns(); }
+
+private:
+  SemaphoreHandle_t handle = NULL;
+};
+
+// Nothing held, the start of every chain of guards
+template <>
+class LockGuard<0> {
+public:
+  LockGuard() {}
+};
+
+static const LockGuard<0> NO_LOCKS;
+
+#endif
@@ -0,0 +1,300 @@
+/*
+  Single-task event loop: timers, input readiness and posted callbacks
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "Reactor.h"
+
+// Tick comparison that survives the tick counter wrapping around
+static inline bool tickReached(TickType_t now, TickType_t when) {
+  return (int32_t)(now - when) >= 0;
+}
+
+static bool streamHasData(void *arg) {
+  return ((Stream *)arg)->available() > 0;
+}
+
+static bool queueHasItems(void *arg) {
+  return uxQueueMessagesWaiting((QueueHandle_t)arg) > 0;
+}
+
+//*****************************************************************************
+// Timer heap
+
+bool Reactor::timerBefore(int a, int b) const {
+  return (int32_t)(timers[a].due - timers[b].due) < 0;
+}
+
+void Reactor::heapSwap(int i, int j) {
+  int id = heap[i];
+  heap[i] = heap[j];
+  heap[j] = id;
+  timers[heap[i]].heap_pos = i;
+  timers[heap[j]].heap_pos = j;
+}
+
+void Reactor::heapUp(int pos) {
+  while (pos > 0) {
+    int parent = (pos - 1) / 2;
+    if (!timerBefore(heap[pos], heap[parent])) {
+      break;
+    }
+    heapSwap(pos, parent);
+    pos = parent;
+  }
+}
+
+void Reactor::heapDown(int pos) {
+  while (1) {
+    int smallest = pos;
+    int left = 2 * pos + 1;
+    int right = left + 1;
+    if (left < heap_len && timerBefore(heap[left], heap[smallest])) {
+      smallest = left;
+    }
+    if (right < heap_len && timerBefore(heap[right], heap[smallest])) {
+      smallest = right;
+    }
+    if (smallest == pos) {
+      break;
+    }
+    heapSwap(pos, smallest);
+    pos = smallest;
+  }
+}
+
+void Reactor::heapPush(int id) {
+  heap[heap_len] = id;
+  timers[id].heap_pos = heap_len;
+  heap_len++;
+  heapUp(heap_len - 1);
+}
+
+void Reactor::heapRemove(int pos) {
+  int id = heap[pos];
+  heap_len--;
+  if (pos != heap_len) {
+    heapSwap(pos, heap_len);
+    heapDown(pos);
+    heapUp(pos);
+  }
+  timers[id].heap_pos = -1;
+}
+
+//*****************************************************************************
+// Setup
+
+void Reactor::attach(QueueHandle_t queue, Timer *timer_table, int *heap_table, int num_timers,
+                     Watch *watch_table, int num_watch_slots) {
+  post_queue = queue;
+  timers = timer_table;
+  heap = heap_table;
+  max_timers = num_timers;
+  watches = watch_table;
+  max_watches = num_watch_slots;
+
+  for (int i = 0; i < max_timers; i++) {
+    timers[i].used = false;
+    timers[i].heap_pos = -1;
+  }
+}
+
+Reactor::TimerId Reactor::addTimer(TickType_t delay, TickType_t period, Callback callback,
+                                   void *arg) {
+  configASSERT(timers != NULL);
+
+  for (int id = 0; id < max_timers; id++) {
+    if (!timers[id].used) {
+      timers[id].used = true;
+      timers[id].callback = callback;
+      timers[id].arg = arg;
+      setTimer(id, delay, period);
+      return id;
+    }
+  }
+  return -1;
+}
+
+bool Reactor::setTimer(TimerId id, TickType_t delay, TickType_t period) {
+  if (id < 0 || id >= max_timers || !timers[id].used) {
+    return false;
+  }
+
+  Timer *timer = &timers[id];
+  if (timer->heap_pos >= 0) {
+    heapRemove(timer->heap_pos);
+  }
+  timer->due = xTaskGetTickCount() + delay;
+  timer->period = period;
+  heapPush(id);
+
+  if (heap_len > stats.max_active_timers) {
+    stats.max_active_timers = heap_len;
+  }
+  return true;
+}
+
+void Reactor::cancelTimer(TimerId id) {
+  if (id < 0 || id >= max_timers || !timers[id].used) {
+    return;
+  }
+  if (timers[id].heap_pos >= 0) {
+    heapRemove(timers[id].heap_pos);
+  }
+  timers[id].used = false;
+}
+
+bool Reactor::watch(ReadyFunction ready, void *ready_arg, Callback callback, void *arg) {
+  configASSERT(watches != NULL);
+
+  if (num_watches == max_watches) {
+    return false;
+  }
+  watches[num_watches].ready = ready;
+  watches[num_watches].ready_arg = ready_arg;
+  watches[num_watches].callback = callback;
+  watches[num_watches].arg = arg;
+  num_watches++;
+  return true;
+}
+
+bool Reactor::watchStream(Stream &stream, Callback callback, void *arg) {
+  return watch(streamHasData, &stream, callback, arg);
+}
+
+bool Reactor::watchQueue(QueueHandle_t queue, Callback callback, void *arg) {
+  return watch(queueHasItems, queue, callback, arg);
+}
+
+//*****************************************************************************
+// Posting
+
+bool Reactor::post(Callback callback, void *arg, TickType_t timeout) {
+  Event event = {callback, arg};
+  bool ok = (xQueueSend(post_queue, &event, timeout) == pdTRUE);
+
+  portENTER_CRITICAL(&spinlock);
+  if (ok) {
+    stats.posts++;
+  } else {
+    stats.post_failures++;
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  if (ok && task != NULL) {
+    xTaskNotifyGive(task);
+  }
+  return ok;
+}
+
+bool Reactor::postFromISR(Callback callback, void *arg, BaseType_t *higher_priority_task_woken) {
+  Event event = {callback, arg};
+  bool ok = (xQueueSendFromISR(post_queue, &event, higher_priority_task_woken) == pdTRUE);
+
+  portENTER_CRITICAL_ISR(&spinlock);
+  if (ok) {
+    stats.posts++;
+  } else {
+    stats.post_failures++;
+  }
+  portEXIT_CRITICAL_ISR(&spinlock);
+
+  if (ok && task != NULL) {
+    vTaskNotifyGiveFromISR(task, higher_priority_task_woken);
+  }
+  return ok;
+}
+
+//*****************************************************************************
+// Loop
+
+void Reactor::invoke(Callback callback, void *arg) {
+  uint32_t start = micros();
+  callback(arg);
+  uint32_t elapsed = micros() - start;
+
+  if (elapsed > stats.max_callback_us) {
+    portENTER_CRITICAL(&spinlock);
+    stats.max_callback_us = elapsed;
+    portEXIT_CRITICAL(&spinlock);
+  }
+}
+
+void Reactor::runTimers() {
+  TickType_t now = xTaskGetTickCount();
+
+  while (heap_len > 0 && tickReached(now, timers[heap[0]].due)) {
+    int id = heap[0];
+    Timer *timer = &timers[id];
+    TickType_t late = now - timer->due;
+    Callback callback = timer->callback;
+    void *arg = timer->arg;
+
+    // Re-arm before the call, so the callback may still change or cancel the timer
+    heapRemove(0);
+    if (timer->period > 0) {
+      uint32_t missed = late / timer->period;
+      timer->due += (missed + 1) * timer->period;
+      heapPush(id);
+      stats.skipped_expiries += missed;
+    }
+
+    portENTER_CRITICAL(&spinlock);
+    stats.timer_fires++;
+    if (late > stats.max_timer_late_ticks) {
+      stats.max_timer_late_ticks = late;
+    }
+    portEXIT_CRITICAL(&spinlock);
+
+    invoke(callback, arg);
+  }
+}
+
+void Reactor::run() {
+  configASSERT(post_queue != NULL);
+  task = xTaskGetCurrentTaskHandle();
+
+  while (1) {
+    stats.passes++;
+
+    // Callbacks posted by other tasks and ISRs
+    Event event;
+    while (xQueueReceive(post_queue, &event, 0) == pdTRUE) {
+      invoke(event.callback, event.arg);
+    }
+
+    // Sources that are ready
+    for (int i = 0; i < num_watches; i++) {
+      if (watches[i].ready(watches[i].ready_arg)) {
+        stats.watch_fires++;
+        invoke(watches[i].callback, watches[i].arg);
+      }
+    }
+
+    runTimers();
+
+    // Sleep until the next timer, at most a poll interval while watches exist, or a post
+    TickType_t timeout = portMAX_DELAY;
+    if (heap_len > 0) {
+      TickType_t now = xTaskGetTickCount();
+      TickType_t due = timers[heap[0]].due;
+      timeout = tickReached(now, due) ? 0 : due - now;
+    }
+    if (num_watches > 0 && timeout > poll_ticks) {
+      timeout = poll_ticks;
+    }
+    if (timeout > 0) {
+      ulTaskNotifyTake(pdTRUE, timeout);
+      stats.wakeups++;
+    }
+  }
+}
+
+void Reactor::getStats(ReactorStats *out) {
+  portENTER_CRITICAL(&spinlock);
+  *out = stats;
+  out->active_timers = heap_len;
+  portEXIT_CRITICAL(&spinlock);
+}
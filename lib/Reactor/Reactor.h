@@ -0,0 +1,170 @@
+/*
+  Single-task event loop: timers, input readiness and posted callbacks
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  A CLI task and a blink task mostly wait, one for characters and one for time, and to
+  talk to each other they need a shared global or a queue that copies every message. A
+  reactor runs both in one task: it sleeps until the earliest timer is due or something
+  needs attention, then calls the callbacks that are ready. Callbacks run one after the
+  other on the same task, so they can share state without locks or copies.
+
+  Example:
+    static StaticReactor<4, 2, 8> reactor;       // 4 timers, 2 watches, 8 posted events
+    static Reactor::TimerId blink_timer;
+
+    static void toggle(void *arg) { digitalWrite(led_pin, !digitalRead(led_pin)); }
+    static void onSerial(void *arg) { ... Serial.read() ... reactor.setTimer(blink_timer, ...); }
+
+    void reactorTask(void *parameters) {
+      reactor.begin();
+      blink_timer = reactor.addTimer(0, pdMS_TO_TICKS(500), toggle, NULL);
+      reactor.watchStream(Serial, onSerial, NULL);
+      reactor.run();                             // Never returns
+    }
+
+  Event sources:
+
+  - timers     : one-shot or periodic, kept in a min-heap on their due tick. A periodic
+                 timer stays on its grid; if the loop fell behind, missed expiries are
+                 skipped instead of fired back to back.
+  - watches    : a readiness check called on every pass, e.g. "Serial has data" or "this
+                 FreeRTOS queue has items"; the callback runs when it returns true and
+                 should drain the source. While any watch exists the loop passes at least
+                 every poll tick (1 by default).
+  - post()     : run a callback on the reactor task, from any task or ISR (through a
+                 FreeRTOS queue, which also wakes the loop right away)
+
+  Timers and watches are added and changed from the reactor task (its callbacks, or
+  before run()); other tasks use post(). The loop sleeps on its direct-to-task
+  notification, so callbacks must not use it. A callback should never block: while it
+  runs, nothing else does.
+*/
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+// Loop statistics (see Reactor::getStats())
+typedef struct ReactorStats {
+  uint32_t passes;                // Loop iterations
+  uint32_t wakeups;               // Times the loop slept and woke up again
+  uint32_t timer_fires;
+  uint32_t watch_fires;
+  uint32_t posts;                 // Callbacks accepted by post()
+  uint32_t post_failures;         // post() with the queue full
+  uint32_t skipped_expiries;      // Periodic expiries dropped because the loop was late
+  uint32_t max_timer_late_ticks;  // Longest time a timer ran after its due tick
+  uint32_t max_callback_us;       // Longest single callback
+  uint8_t active_timers;
+  uint8_t max_active_timers;
+} ReactorStats;
+
+class Reactor {
+public:
+
+  typedef void (*Callback)(void *arg);
+  typedef bool (*ReadyFunction)(void *arg);
+  typedef int TimerId;            // -1 if no timer slot was free
+
+  // Call `callback(arg)` after `delay` ticks, then every `period` ticks (0 = once)
+  TimerId addTimer(TickType_t delay, TickType_t period, Callback callback, void *arg);
+
+  // Re-arm a timer with a new delay and period (also works after a one-shot fired)
+  bool setTimer(TimerId id, TickType_t delay, TickType_t period);
+  void cancelTimer(TimerId id);
+
+  // Call `callback(arg)` on every pass where ready(ready_arg) returns true
+  bool watch(ReadyFunction ready, void *ready_arg, Callback callback, void *arg);
+  bool watchStream(Stream &stream, Callback callback, void *arg);
+  bool watchQueue(QueueHandle_t queue, Callback callback, void *arg);
+
+  // Run `callback(arg)` on the reactor task, false if the post queue stayed full
+  bool post(Callback callback, void *arg, TickType_t timeout = 0);
+  bool postFromISR(Callback callback, void *arg, BaseType_t *higher_priority_task_woken);
+
+  // Longest time the loop sleeps while watches are active
+  void setPollTicks(TickType_t ticks) { poll_ticks = (ticks > 0) ? ticks : 1; }
+
+  // Run the loop in the calling task, never returns
+  void run();
+
+  void getStats(ReactorStats *stats);
+
+protected:
+
+  // One posted callback
+  typedef struct Event {
+    Callback callback;
+    void *arg;
+  } Event;
+
+  typedef struct Timer {
+    TickType_t due;
+    TickType_t period;
+    Callback callback;
+    void *arg;
+    int heap_pos;                 // -1 while the timer is not armed
+    bool used;
+  } Timer;
+
+  typedef struct Watch {
+    ReadyFunction ready;
+    void *ready_arg;
+    Callback callback;
+    void *arg;
+  } Watch;
+
+  Reactor() = default;
+
+  // Called by StaticReactor::begin() with its tables and the post queue
+  void attach(QueueHandle_t queue, Timer *timer_table, int *heap_table, int num_timers,
+              Watch *watch_table, int num_watches);
+
+private:
+
+  void invoke(Callback callback, void *arg);
+  void runTimers();
+  bool timerBefore(int a, int b) const;
+  void heapSwap(int i, int j);
+  void heapUp(int pos);
+  void heapDown(int pos);
+  void heapPush(int id);
+  void heapRemove(int pos);
+
+  QueueHandle_t post_queue = NULL;
+  TaskHandle_t task = NULL;
+  Timer *timers = NULL;
+  int *heap = NULL;               // Timer ids, earliest due first
+  int heap_len = 0;
+  int max_timers = 0;
+  Watch *watches = NULL;
+  int num_watches = 0;
+  int max_watches = 0;
+  TickType_t poll_ticks = 1;
+  ReactorStats stats = {};
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Reactor with its timer and watch tables and post queue
+template <int MaxTimers, int MaxWatches, UBaseType_t PostQueueLength>
+class StaticReactor : public Reactor {
+public:
+
+  // Create the post queue, call before anything else
+  void begin() {
+    attach(queue_storage.create(), timer_table, heap_table, MaxTimers,
+           watch_table, MaxWatches);
+  }
+
+private:
+  Timer timer_table[MaxTimers];
+  int heap_table[MaxTimers];
+  Watch watch_table[MaxWatches];
+  QueueStorage<Event, PostQueueLength> queue_storage;
+};
+
+#endif
@@ -0,0 +1,193 @@
+/*
+  Reader-writer lock for FreeRTOS with writer preference
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "RwLock.h"
+
+#include <esp_timer.h>
+
+//*****************************************************************************
+// Public API
+
+bool RwLock::begin() {
+
+  // Create the mutexes on first use
+  if (gate == NULL) {
+    for (int i = 0; i < RW_LOCK_MAX_READERS; i++) {
+      slots[i].mutex = slots[i].storage.create();
+      if (slots[i].mutex == NULL) {
+        return false;
+      }
+    }
+    gate = gate_storage.create();
+    if (gate == NULL) {
+      return false;
+    }
+  }
+
+  portENTER_CRITICAL(&spinlock);
+  stats = {};
+  portEXIT_CRITICAL(&spinlock);
+  return true;
+}
+
+bool RwLock::readLock(TickType_t timeout) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  TimeOut_t time_out;
+  TickType_t left = timeout;
+  bool waited = false;
+  bool slot_waited = false;
+
+  configASSERT(gate != NULL);
+  vTaskSetTimeOutState(&time_out);
+
+  while (1) {
+
+    // Claim a free slot
+    ReaderSlot *slot = NULL;
+    portENTER_CRITICAL(&spinlock);
+    for (int i = 0; i < RW_LOCK_MAX_READERS; i++) {
+      if (slots[i].task == NULL) {
+        slot = &slots[i];
+        slot->task = self;
+        break;
+      }
+    }
+    portEXIT_CRITICAL(&spinlock);
+
+    if (slot != NULL) {
+
+      // Free unless a writer is draining the readers, then it is only held briefly
+      xSemaphoreTake(slot->mutex, portMAX_DELAY);
+
+      // Inside if no writer, a writer that comes later will wait for this slot
+      portENTER_CRITICAL(&spinlock);
+      bool blocked = writer;
+      if (!blocked) {
+        slot->active = true;
+        stats.reads++;
+        stats.read_waits += waited;
+        stats.slot_waits += slot_waited;
+      } else {
+        slot->task = NULL;
+      }
+      portEXIT_CRITICAL(&spinlock);
+
+      if (!blocked) {
+        return true;
+      }
+      xSemaphoreGive(slot->mutex);
+    }
+
+    // Wait for the writer (raising it) on the gate, or a tick for a slot
+    if (xTaskCheckForTimeOut(&time_out, &left) == pdTRUE) {
+      portENTER_CRITICAL(&spinlock);
+      stats.timeouts++;
+      portEXIT_CRITICAL(&spinlock);
+      return false;
+    }
+    if (slot != NULL) {
+      waited = true;
+      if (xSemaphoreTake(gate, left) == pdTRUE) {
+        xSemaphoreGive(gate);
+      }
+    } else {
+      slot_waited = true;
+      vTaskDelay(1);
+    }
+  }
+}
+
+void RwLock::readUnlock() {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  ReaderSlot *slot = NULL;
+
+  portENTER_CRITICAL(&spinlock);
+  for (int i = 0; i < RW_LOCK_MAX_READERS; i++) {
+    if (slots[i].task == self && slots[i].active) {
+      slot = &slots[i];
+      slot->active = false;
+      slot->task = NULL;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  configASSERT(slot != NULL);
+  xSemaphoreGive(slot->mutex);
+}
+
+bool RwLock::writeLock(TickType_t timeout) {
+  TimeOut_t time_out;
+  TickType_t left = timeout;
+  int64_t start_us = esp_timer_get_time();
+  bool waited = false;
+
+  configASSERT(gate != NULL);
+  vTaskSetTimeOutState(&time_out);
+
+  // One writer at a time
+  if (xSemaphoreTake(gate, 0) != pdTRUE) {
+    waited = true;
+    if (xSemaphoreTake(gate, timeout) != pdTRUE) {
+      portENTER_CRITICAL(&spinlock);
+      stats.timeouts++;
+      portEXIT_CRITICAL(&spinlock);
+      return false;
+    }
+  }
+
+  // Keep new readers out, and note who is inside
+  SemaphoreHandle_t inside[RW_LOCK_MAX_READERS];
+  int count = 0;
+  portENTER_CRITICAL(&spinlock);
+  writer = true;
+  for (int i = 0; i < RW_LOCK_MAX_READERS; i++) {
+    if (slots[i].active) {
+      inside[count++] = slots[i].mutex;
+    }
+  }
+  portEXIT_CRITICAL(&spinlock);
+
+  // Wait for each reader to leave, raising it meanwhile
+  for (int i = 0; i < count; i++) {
+    waited = true;
+    xTaskCheckForTimeOut(&time_out, &left);
+    if (xSemaphoreTake(inside[i], left) != pdTRUE) {
+      portENTER_CRITICAL(&spinlock);
+      writer = false;
+      stats.timeouts++;
+      portEXIT_CRITICAL(&spinlock);
+      xSemaphoreGive(gate);
+      return false;
+    }
+    xSemaphoreGive(inside[i]);
+  }
+
+  uint32_t wait_us = (uint32_t)(esp_timer_get_time() - start_us);
+  portENTER_CRITICAL(&spinlock);
+  stats.writes++;
+  stats.write_waits += waited;
+  if (waited && wait_us > stats.max_write_wait_us) {
+    stats.max_write_wait_us = wait_us;
+  }
+  portEXIT_CRITICAL(&spinlock);
+  return true;
+}
+
+void RwLock::writeUnlock() {
+  portENTER_CRITICAL(&spinlock);
+  writer = false;
+  portEXIT_CRITICAL(&spinlock);
+
+  xSemaphoreGive(gate);
+}
+
+void RwLock::getStats(RwLockStats *out) {
+  portENTER_CRITICAL(&spinlock);
+  *out = stats;
+  portEXIT_CRITICAL(&spinlock);
+}
@@ -0,0 +1,99 @@
+/*
+  Reader-writer lock for FreeRTOS with writer preference
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Settings such as led_delay are read by a control task on every cycle and written once
+  in a while from the serial command line. Behind a plain mutex every reader waits for
+  every other reader, although readers never conflict. An RwLock lets any number of
+  readers in at once and a writer alone:
+
+    static RwLock config_lock;
+
+    config_lock.begin();
+
+    config_lock.readLock(portMAX_DELAY);      // Many tasks, on both cores
+    Config copy = config;
+    config_lock.readUnlock();
+
+    config_lock.writeLock(portMAX_DELAY);     // One at a time, no readers inside
+    config = new_config;
+    config_lock.writeUnlock();
+
+  Writers go first: once a writer is waiting no new reader gets in, so a steady stream of
+  readers can't keep it out. Blocking keeps FreeRTOS priority inheritance in both
+  directions, because everything a task waits for is a mutex held by the task it waits
+  on:
+
+  - every reader holds a mutex of its own (one of RW_LOCK_MAX_READERS slots) while it
+    reads; a writer waits for the readers inside by taking their slot mutexes in turn,
+    which raises a low priority reader to the writer's priority until it is done
+  - a writer holds the gate mutex from writeLock() to writeUnlock(); readers that arrive
+    meanwhile and other writers wait on the gate and raise the writer
+
+  A reader that finds no writer only takes and gives its own, uncontended slot mutex, so
+  reading costs about what an uncontended plain mutex costs and readers on both cores
+  never wait for each other. RW_LOCK_MAX_READERS is the most readers inside at the same
+  time (default 8); one more waits a tick for a slot and is counted in
+  RwLockStats::slot_waits. Not recursive: a task must not call readLock() or writeLock()
+  while it holds the lock, and only the task that locked may unlock. The mutexes come
+  from lib/StaticAlloc (static in USE_STATIC_ALLOCATION builds).
+*/
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+#ifndef RW_LOCK_MAX_READERS
+  #define RW_LOCK_MAX_READERS 8
+#endif
+
+// Counters since begin()
+typedef struct RwLockStats {
+  uint32_t reads;             // Successful readLock() calls
+  uint32_t read_waits;        // Reads that had to wait for a writer
+  uint32_t slot_waits;        // Reads that found every slot taken
+  uint32_t writes;            // Successful writeLock() calls
+  uint32_t write_waits;       // Writes that had to wait for readers or another writer
+  uint32_t timeouts;          // readLock() and writeLock() calls that gave up
+  uint32_t max_write_wait_us; // Longest time a writeLock() waited
+} RwLockStats;
+
+class RwLock {
+public:
+
+  // Create the mutexes, returns false if they could not be created
+  bool begin();
+
+  // Shared access, returns false on timeout
+  bool readLock(TickType_t timeout);
+  void readUnlock();
+
+  // Exclusive access, returns false on timeout
+  bool writeLock(TickType_t timeout);
+  void writeUnlock();
+
+  void getStats(RwLockStats *stats);
+
+private:
+
+  // A reader inside (task != NULL and active), or a slot being claimed
+  typedef struct ReaderSlot {
+    MutexStorage storage;
+    SemaphoreHandle_t mutex;
+    TaskHandle_t task;          // NULL if free
+    bool active;                // Counted as a reader inside
+  } ReaderSlot;
+
+  ReaderSlot slots[RW_LOCK_MAX_READERS] = {};
+  MutexStorage gate_storage;
+  SemaphoreHandle_t gate = NULL;
+  bool writer = false;          // A writer holds the gate
+  RwLockStats stats = {};
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+  Sequence lock and lock-free snapshots of multi-field state
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  State made of several fields (a Message with body and count, a position with x and y)
+  can't be read with one load, so a reader may see half of an update. A mutex fixes that
+  but can't be taken from an ISR, and a critical section keeps interrupts off for the
+  whole copy. A sequence lock keeps a counter next to the data instead:
+
+  - the writer makes the counter odd, changes the data and makes it even again; it never
+    waits for anybody (wait-free), so it can be a task or an ISR
+  - a reader notes the counter, copies the data and checks the counter again; if the
+    counter was odd or has changed, a write overlapped and the copy is simply repeated
+
+  Readers never block the writer and never write to shared memory. Snapshot<T> wraps a
+  trivially copyable T with its SeqLock:
+
+    static Snapshot<BlinkStatus> blink_status;
+
+    blink_status.publish(status);             // Writer, task or ISR
+    BlinkStatus now = blink_status.read();    // Any number of reader tasks, both cores
+
+    uint32_t retries = 0;
+    now = blink_status.read(&retries);        // Adds the repeated attempts to `retries`
+
+    BlinkStatus latest;
+    if (blink_status.tryRead(&latest)) {...}  // One attempt, for ISRs
+
+  There must be one writer at a time; several writers need a lock of their own around
+  publish(). read() retries until it gets a clean copy; after SEQ_LOCK_SPINS_PER_SLEEP
+  failed attempts in a row it sleeps a tick, so a reader task that preempted the writer
+  on its own core lets it finish. An ISR must not wait for a writer that it interrupted,
+  so from an ISR use tryRead(), which gives up instead. The counter and fences are
+  std::atomic, and the same header builds for host programs (host-tools/, where
+  stress-seqlock checks it for torn copies).
+*/
+
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#else
+  #include <thread>
+#endif
+
+#ifndef SEQ_LOCK_SPINS_PER_SLEEP
+  #define SEQ_LOCK_SPINS_PER_SLEEP 64
+#endif
+
+class SeqLock {
+public:
+
+  // Writer: around every change of the data
+  void writeBegin() {
+    uint32_t sequence = counter.load(std::memory_order_relaxed);
+    counter.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void writeEnd() {
+    uint32_t sequence = counter.load(std::memory_order_relaxed);
+    counter.store(sequence + 1, std::memory_order_release);
+  }
+
+  // Reader: note the counter before the copy, returns false if a write is going on
+  bool readBegin(uint32_t *sequence) const {
+    *sequence = counter.load(std::memory_order_acquire);
+    return (*sequence & 1) == 0;
+  }
+
+  // Reader: true if the copy made since readBegin() is clean
+  bool readValid(uint32_t sequence) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return counter.load(std::memory_order_relaxed) == sequence;
+  }
+
+  // Completed writes
+  uint32_t writes() const { return counter.load(std::memory_order_relaxed) / 2; }
+
+  // Between failed read attempts
+  static void backOff(uint32_t attempt) {
+    if (attempt % SEQ_LOCK_SPINS_PER_SLEEP != 0) {
+      return;
+    }
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+    vTaskDelay(1);
+#else
+    std::this_thread::yield();
+#endif
+  }
+
+private:
+  std::atomic<uint32_t> counter{0};
+};
+
+template <typename T>
+class Snapshot {
+public:
+
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Snapshot copies T byte by byte, it must be trivially copyable");
+
+  // Replace the value (one writer at a time, task or ISR), never waits
+  void publish(const T &new_value) {
+    lock.writeBegin();
+    copy(&value, &new_value);
+    lock.writeEnd();
+  }
+
+  // Clean copy of the latest value, retries while writes overlap (tasks only). The
+  // number of repeated attempts is added to *retries if given (the reader's own variable).
+  T read(uint32_t *retries = NULL) const {
+    T result;
+    uint32_t attempt = 0;
+
+    while (!tryRead(&result)) {
+      attempt++;
+      SeqLock::backOff(attempt);
+    }
+    if (retries != NULL) {
+      *retries += attempt;
+    }
+    return result;
+  }
+
+  // One attempt, returns false (leaving *result undefined) if a write overlapped
+  bool tryRead(T *result) const {
+    uint32_t sequence;
+    if (!lock.readBegin(&sequence)) {
+      return false;
+    }
+    copy(result, &value);
+    return lock.readValid(sequence);
+  }
+
+  // Values published so far
+  uint32_t version() const { return lock.writes(); }
+
+private:
+
+  // The copy races with the writer by design, the sequence check throws torn copies away
+  static void copy(T *to, const T *from) {
+    memcpy(to, from, sizeof(T));
+  }
+
+  SeqLock lock;
+  T value = {};
+};
+
+#endif
@@ -0,0 +1,51 @@
+/*
+  Start barrier and batched task creation on an event group
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "StartBarrier.h"
+
+bool StartBarrier::begin(uint8_t participants) {
+  configASSERT(participants > 0 && participants <= START_BARRIER_MAX_PARTICIPANTS);
+
+  // Create the event group on first use
+  if (group == NULL) {
+    group = group_storage.create();
+    if (group == NULL) {
+      return false;
+    }
+  }
+
+  num_participants = participants;
+  all_bits = ((EventBits_t)1 << participants) - 1;
+  xEventGroupClearBits(group, all_bits);
+  return true;
+}
+
+bool StartBarrier::arriveAndWait(uint8_t index, TickType_t timeout) {
+  configASSERT(group != NULL && index < num_participants);
+
+  // Sets our bit and waits for all of them, the bits are cleared when the barrier opens
+  EventBits_t bits = xEventGroupSync(group, (EventBits_t)1 << index, all_bits, timeout);
+  return (bits & all_bits) == all_bits;
+}
+
+void StartBarrier::arrive(uint8_t index) {
+  configASSERT(group != NULL && index < num_participants);
+
+  xEventGroupSetBits(group, (EventBits_t)1 << index);
+}
+
+EventBits_t StartBarrier::arrived() {
+  configASSERT(group != NULL);
+
+  return xEventGroupGetBits(group) & all_bits;
+}
+
+void StartBarrier::reset() {
+  configASSERT(group != NULL);
+
+  xEventGroupClearBits(group, all_bits);
+}
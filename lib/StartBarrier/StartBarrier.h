@@ -0,0 +1,150 @@
+/*
+  Start barrier and batched task creation on an event group
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Starting a group of tasks one by one and taking a semaphore once per task to learn that
+  each has started serializes the start-up: every handshake is a switch to the new task
+  and back before the next one is even created. A StartBarrier lets every participant
+  set its own bit of an event group and wait until all bits are set (xEventGroupSync()).
+  The last one to arrive releases everybody at once, and the bits are cleared again, so
+  the barrier can be used for the next round.
+
+    static StartBarrier ready;
+
+    ready.begin(3);                              // Participants 0, 1 and 2
+    ready.arriveAndWait(index, portMAX_DELAY);   // In each participant
+
+  TaskBatch builds on it: it creates NumTasks tasks running the same code, holds each of
+  them at a barrier before its code starts and lets the creator join as the last
+  participant. createPinnedToCore() returns once every task has been created and they
+  have all been released together:
+
+    static TaskBatch<Message, 5, 1024> workers;   // 5 tasks with 1024 byte stacks
+
+    void printMessage(const Message &msg, uint8_t index) { ... }   // May simply return
+
+    workers.createPinnedToCore(printMessage, "Task", msg, 1, app_cpu, portMAX_DELAY);
+
+  The argument is copied once into the batch object, so the caller's copy may go out of
+  scope right away and the tasks share a read-only copy. A task that could not be created
+  is counted as arrived, the others still start.
+
+  An event group has 24 usable bits on ESP32 (configUSE_16_BIT_TICKS 0), so a barrier
+  takes at most 24 participants and a batch at most 23 tasks. If a participant times
+  out, its bit stays set until reset(). The event group and tasks come from lib/StaticAlloc
+  (static in USE_STATIC_ALLOCATION builds); each batch is created once.
+*/
+
+#ifndef START_BARRIER_H
+#define START_BARRIER_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+
+// Most participants of one barrier
+#define START_BARRIER_MAX_PARTICIPANTS 24
+
+class StartBarrier {
+public:
+
+  // Create the event group (first call only) for `participants` participants, returns
+  // false if it could not be created
+  bool begin(uint8_t participants);
+
+  // Participant `index` has arrived: wait until all have, returns false on timeout
+  bool arriveAndWait(uint8_t index, TickType_t timeout);
+
+  // Count participant `index` as arrived without waiting (e.g. one that never started)
+  void arrive(uint8_t index);
+
+  // Participants that have arrived in the current round, one bit each
+  EventBits_t arrived();
+
+  // Forget the arrivals of an abandoned round (after a timeout)
+  void reset();
+
+  uint8_t participants() const { return num_participants; }
+
+private:
+  EventGroupStorage group_storage;
+  EventGroupHandle_t group = NULL;
+  EventBits_t all_bits = 0;
+  uint8_t num_participants = 0;
+};
+
+// NumTasks tasks (stack depth in bytes on ESP32) started together, each with read-only
+// access to one copy of the argument
+template <typename T, uint8_t NumTasks, uint32_t StackDepth>
+class TaskBatch {
+public:
+
+  typedef void (*TaskCode)(const T &arg, uint8_t index);
+
+  // Create the tasks, named "<name> 0", "<name> 1", ..., and release them together.
+  // Returns the number of tasks created, 0 if the barrier did not open within `timeout`
+  // (the tasks are then released once the rest of them arrives).
+  uint8_t createPinnedToCore(TaskCode task_code,
+                             const char *name,
+                             const T &arg,
+                             UBaseType_t priority,
+                             BaseType_t core_id,
+                             TickType_t timeout) {
+    char task_name[configMAX_TASK_NAME_LEN];
+    uint8_t created = 0;
+
+    if (!barrier.begin(NumTasks + 1)) {
+      return 0;
+    }
+    code = task_code;
+    value = arg;
+
+    for (uint8_t i = 0; i < NumTasks; i++) {
+      snprintf(task_name, sizeof(task_name), "%s %u", name, (unsigned)i);
+      slots[i].batch = this;
+      slots[i].index = i;
+      if (tasks[i].createPinnedToCore(taskEntry, task_name, &slots[i], priority,
+                                      core_id) != NULL) {
+        created++;
+      } else {
+        barrier.arrive(i);
+      }
+    }
+
+    // The creator is the last participant
+    if (!barrier.arriveAndWait(NumTasks, timeout)) {
+      return 0;
+    }
+    return created;
+  }
+
+  static uint32_t stackDepth() { return StackDepth; }
+
+private:
+
+  static_assert(NumTasks < START_BARRIER_MAX_PARTICIPANTS, "too many tasks for one batch");
+
+  // Task parameter: which batch and which task of it
+  struct Slot {
+    TaskBatch *batch;
+    uint8_t index;
+  };
+
+  static void taskEntry(void *parameters) {
+    Slot *slot = (Slot *)parameters;
+    TaskBatch *batch = slot->batch;
+
+    batch->barrier.arriveAndWait(slot->index, portMAX_DELAY);
+    batch->code(batch->value, slot->index);
+    vTaskDelete(NULL);
+  }
+
+  StartBarrier barrier;
+  TaskCode code = NULL;
+  T value;
+  Slot slots[NumTasks];
+  TaskStorage<StackDepth> tasks[NumTasks];
+};
+
+#endif
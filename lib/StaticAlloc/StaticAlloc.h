@@ -0,0 +1,222 @@
+/*
+  Compile-time storage for FreeRTOS kernel objects
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : Added TimerStorage for software timers
+
+  Efraim Manurung, 17th October 2026
+  Version 1.2 : Added EventGroupStorage for event groups
+
+  Every task, queue, semaphore, software timer and event group created with
+  xTaskCreatePinnedToCore(), xQueueCreate(), xSemaphoreCreate*(), xTimerCreate() or
+  xEventGroupCreate() takes its control block (and stack or queue buffer) from the heap.
+  The *Storage classes below wrap those calls. In a normal build they create the object
+  dynamically, exactly like before. When the sketch is built with
+
+    build_flags = -DUSE_STATIC_ALLOCATION=1
+
+  the storage becomes a member of the object and the *Static() creation functions are used
+  instead. Declared as globals, the objects then end up in .bss: the RAM they need shows up
+  in the linker's memory report, creation can't fail for lack of heap, and the heap is not
+  touched after boot.
+
+  Example:
+    static TaskStorage<1024> blink_task;                 // 1024 byte stack
+    static QueueStorage<int, 5> delay_queue_storage;     // 5 ints
+    static MutexStorage mutex_storage;
+
+    QueueHandle_t delay_queue = delay_queue_storage.create();
+    SemaphoreHandle_t mutex = mutex_storage.create();
+    blink_task.createPinnedToCore(blinkLED, "Blink LED", NULL, 1, app_cpu);
+
+  Each object is created once. A task that deletes itself may only be created again from
+  the same storage after the idle task has cleaned it up; in static builds
+  TaskStorage::createPinnedToCore() returns NULL while the last task is still alive and
+  waits for the clean-up once it has deleted itself.
+*/
+
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+#include <Arduino.h>
+#include <freertos/timers.h>
+#include <freertos/event_groups.h>
+
+#ifndef USE_STATIC_ALLOCATION
+  #define USE_STATIC_ALLOCATION 0
+#endif
+
+#if USE_STATIC_ALLOCATION && !configSUPPORT_STATIC_ALLOCATION
+  #error "USE_STATIC_ALLOCATION needs configSUPPORT_STATIC_ALLOCATION in FreeRTOSConfig.h"
+#endif
+
+// Time the idle tasks get to clean up a task that deleted itself before its storage is
+// used again
+static const TickType_t task_cleanup_ticks = pdMS_TO_TICKS(10) > 0 ? pdMS_TO_TICKS(10) : 1;
+
+// Task control block and stack. StackDepth has the same unit as in xTaskCreatePinnedToCore()
+// (bytes on ESP32, since StackType_t is a byte there).
+template <uint32_t StackDepth>
+class TaskStorage {
+public:
+  // Returns NULL if the task could not be created, or (static builds) while the last task
+  // created from this storage has not deleted itself yet
+  TaskHandle_t createPinnedToCore(TaskFunction_t task_code,
+                                  const char *name,
+                                  void *parameters,
+                                  UBaseType_t priority,
+                                  BaseType_t core_id) {
+#if USE_STATIC_ALLOCATION
+    if (!waitReleased()) {
+      return NULL;
+    }
+    handle = xTaskCreateStaticPinnedToCore(task_code, name, StackDepth, parameters,
+                                           priority, stack, &tcb, core_id);
+    return handle;
+#else
+    TaskHandle_t handle = NULL;
+    xTaskCreatePinnedToCore(task_code, name, StackDepth, parameters, priority, &handle,
+                            core_id);
+    return handle;
+#endif
+  }
+
+  // False right away while the last task created from this storage has not deleted
+  // itself, otherwise true once the idle task has had time to clean it up. Dynamic builds
+  // give every task new storage, so there is nothing to wait for.
+  bool waitReleased() {
+#if USE_STATIC_ALLOCATION
+    if (handle != NULL) {
+      // eDeleted already while the TCB still waits in the idle task's list
+      if (eTaskGetState(handle) != eDeleted) {
+        return false;
+      }
+      vTaskDelay(task_cleanup_ticks);
+      handle = NULL;
+    }
+#endif
+    return true;
+  }
+
+  static uint32_t stackDepth() { return StackDepth; }
+
+private:
+#if USE_STATIC_ALLOCATION
+  TaskHandle_t handle = NULL;
+  StaticTask_t tcb;
+  StackType_t stack[StackDepth];
+#endif
+};
+
+// Queue control block and item buffer for Length items of type T
+template <typename T, UBaseType_t Length>
+class QueueStorage {
+public:
+  QueueHandle_t create() {
+#if USE_STATIC_ALLOCATION
+    return xQueueCreateStatic(Length, sizeof(T), buffer, &queue);
+#else
+    return xQueueCreate(Length, sizeof(T));
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticQueue_t queue;
+  uint8_t buffer[Length * sizeof(T)];
+#endif
+};
+
+// Mutex (with priority inheritance, like xSemaphoreCreateMutex())
+class MutexStorage {
+public:
+  SemaphoreHandle_t create() {
+#if USE_STATIC_ALLOCATION
+    return xSemaphoreCreateMutexStatic(&semaphore);
+#else
+    return xSemaphoreCreateMutex();
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticSemaphore_t semaphore;
+#endif
+};
+
+// Binary semaphore (starts empty, like xSemaphoreCreateBinary())
+class BinarySemaphoreStorage {
+public:
+  SemaphoreHandle_t create() {
+#if USE_STATIC_ALLOCATION
+    return xSemaphoreCreateBinaryStatic(&semaphore);
+#else
+    return xSemaphoreCreateBinary();
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticSemaphore_t semaphore;
+#endif
+};
+
+// Counting semaphore
+class CountingSemaphoreStorage {
+public:
+  SemaphoreHandle_t create(UBaseType_t max_count, UBaseType_t initial_count) {
+#if USE_STATIC_ALLOCATION
+    return xSemaphoreCreateCountingStatic(max_count, initial_count, &semaphore);
+#else
+    return xSemaphoreCreateCounting(max_count, initial_count);
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticSemaphore_t semaphore;
+#endif
+};
+
+// Software timer. The callback runs in the timer service task, so a timer needs no stack.
+class TimerStorage {
+public:
+  TimerHandle_t create(const char *name,
+                       TickType_t period,
+                       UBaseType_t auto_reload,
+                       void *timer_id,
+                       TimerCallbackFunction_t callback) {
+#if USE_STATIC_ALLOCATION
+    return xTimerCreateStatic(name, period, auto_reload, timer_id, callback, &timer);
+#else
+    return xTimerCreate(name, period, auto_reload, timer_id, callback);
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticTimer_t timer;
+#endif
+};
+
+// Event group (all bits cleared, like xEventGroupCreate())
+class EventGroupStorage {
+public:
+  EventGroupHandle_t create() {
+#if USE_STATIC_ALLOCATION
+    return xEventGroupCreateStatic(&event_group);
+#else
+    return xEventGroupCreate();
+#endif
+  }
+
+private:
+#if USE_STATIC_ALLOCATION
+  StaticEventGroup_t event_group;
+#endif
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*
+  Task creation with the argument passed by value
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  xTaskCreatePinnedToCore() passes one void pointer. Pointing it at a local variable of
+  the creator only works if the creator waits (on a mutex or semaphore) until the new
+  task has copied the value; return early and the task reads a dead stack frame. That
+  wait costs a switch to the new task and back on every creation.
+
+  TaskSpawn takes the argument itself. The creator never waits, and the task code gets a
+  reference to a copy that it owns for as long as it runs:
+
+    static TaskSpawn<long, 1024> blink_task;
+
+    void blinkLED(long &delay_ms) { ... }      // May simply return when done
+
+    long delay_arg = Serial.parseInt();
+    blink_task.createPinnedToCore(blinkLED, "Blink LED", delay_arg, 1, app_cpu);
+    // delay_arg may go out of scope right away
+
+  Where the copy lives follows lib/StaticAlloc:
+
+  - USE_STATIC_ALLOCATION=1 : in this object, next to the task's TCB and stack, so it is
+                              part of the task's compile-time storage and nothing is
+                              allocated at run time
+  - otherwise               : in a small pvPortMalloc() block that the new task moves
+                              onto its own stack and frees before the task code runs
+
+  When the task code returns, the argument is destroyed and the task deletes itself. In
+  static builds one object runs one task at a time (like TaskStorage). Its TCB and stack
+  stay in the kernel's lists until the idle task has cleaned the deleted task up, so the
+  object is only free again after that: createPinnedToCore() returns NULL while the last
+  task is still alive (eTaskGetState() is not eDeleted yet) and waits for the clean-up
+  once it has deleted itself. waitReleased() does the same check on its own.
+*/
+
+#ifndef TASK_SPAWN_H
+#define TASK_SPAWN_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <new>
+#include <utility>
+
+template <typename T, uint32_t StackDepth>
+class TaskSpawn {
+public:
+
+  typedef void (*TaskCode)(T &arg);
+
+  // Start task_code(copy of arg), returns NULL if the task (or the hand-off block) could
+  // not be allocated, or (static builds) while the last task of this object is alive
+  TaskHandle_t createPinnedToCore(TaskCode task_code,
+                                  const char *name,
+                                  T arg,
+                                  UBaseType_t priority,
+                                  BaseType_t core_id) {
+#if USE_STATIC_ALLOCATION
+    if (!waitReleased()) {
+      return NULL;
+    }
+    code = task_code;
+    new (value) T(std::move(arg));
+    handle = xTaskCreateStaticPinnedToCore(staticEntry, name, StackDepth, this, priority,
+                                           stack, &tcb, core_id);
+    return handle;
+#else
+    void *block = pvPortMalloc(sizeof(Handoff));
+    if (block == NULL) {
+      return NULL;
+    }
+    Handoff *handoff = new (block) Handoff{task_code, std::move(arg)};
+
+    TaskHandle_t handle = NULL;
+    if (xTaskCreatePinnedToCore(heapEntry, name, StackDepth, handoff, priority, &handle,
+                                core_id) != pdPASS) {
+      handoff->~Handoff();
+      vPortFree(block);
+      return NULL;
+    }
+    return handle;
+#endif
+  }
+
+  // False right away while the last task of this object has not returned and deleted
+  // itself, otherwise true once the idle task has had time to clean it up (see
+  // TaskStorage::waitReleased(), always true in dynamic builds)
+  bool waitReleased() {
+#if USE_STATIC_ALLOCATION
+    if (handle != NULL) {
+      if (eTaskGetState(handle) != eDeleted) {
+        return false;
+      }
+      vTaskDelay(task_cleanup_ticks);
+      handle = NULL;
+    }
+#endif
+    return true;
+  }
+
+  static uint32_t stackDepth() { return StackDepth; }
+
+private:
+
+#if USE_STATIC_ALLOCATION
+
+  static void staticEntry(void *parameters) {
+    TaskSpawn *spawn = (TaskSpawn *)parameters;
+    T *arg = reinterpret_cast<T *>(spawn->value);
+
+    spawn->code(*arg);
+    arg->~T();
+    vTaskDelete(NULL);
+  }
+
+  TaskHandle_t handle = NULL;
+  TaskCode code = NULL;
+  alignas(T) uint8_t value[sizeof(T)];
+  StaticTask_t tcb;
+  StackType_t stack[StackDepth];
+
+#else
+
+  // Task code and argument on their way to the new task
+  struct Handoff {
+    TaskCode code;
+    T value;
+  };
+
+  static void heapEntry(void *parameters) {
+    {
+      Handoff *handoff = (Handoff *)parameters;
+      TaskCode code = handoff->code;
+      T arg(std::move(handoff->value));
+      handoff->~Handoff();
+      vPortFree(handoff);
+
+      code(arg);
+    }
+    vTaskDelete(NULL);
+  }
+
+#endif
+};
+
+#endif
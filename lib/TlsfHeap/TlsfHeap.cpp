@@ -0,0 +1,410 @@
+/*
+  Two-Level Segregated Fit (TLSF) heap for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Based on the algorithm described by M. Masmano, I. Ripoll, A. Crespo and J. Real,
+  "TLSF: a New Dynamic Memory Allocator for Real-Time Systems" (ECRTS 2004).
+*/
+
+#include "TlsfHeap.h"
+
+// Index of the most/least significant set bit (NSAU on Xtensa, so constant time)
+static inline unsigned flsBit(uint32_t value) {
+  return 31 - __builtin_clz(value);
+}
+
+static inline unsigned ffsBit(uint32_t value) {
+  return __builtin_ctz(value);
+}
+
+static inline size_t alignUp(size_t value, size_t align) {
+  return (value + align - 1) & ~(align - 1);
+}
+
+//*****************************************************************************
+// Size class mapping
+
+// Class that holds blocks of exactly `size` bytes (used when inserting a free block)
+void TlsfHeap::mappingInsert(size_t size, unsigned *fl, unsigned *sl) {
+  if (size < small_block_size) {
+    *fl = 0;
+    *sl = size / (small_block_size / sl_index_count);
+  } else {
+    unsigned f = flsBit((uint32_t)size);
+    *sl = (unsigned)(size >> (f - sl_index_log2)) ^ (1U << sl_index_log2);
+    *fl = f - (fl_index_shift - 1);
+  }
+}
+
+// First class whose every block is at least `size` bytes (used when allocating)
+void TlsfHeap::mappingSearch(size_t size, unsigned *fl, unsigned *sl) {
+  if (size >= small_block_size) {
+    size += ((size_t)1 << (flsBit((uint32_t)size) - sl_index_log2)) - 1;
+  }
+  mappingInsert(size, fl, sl);
+}
+
+TlsfHeap::Block *TlsfHeap::searchSuitable(unsigned *fl, unsigned *sl) {
+  if (*fl >= fl_index_count) {
+    return NULL;
+  }
+
+  // Look for a non-empty class at this first level first, then at any bigger one
+  uint32_t sl_map = sl_bitmap[*fl] & (~0U << *sl);
+  if (sl_map == 0) {
+    uint32_t fl_map = fl_bitmap & (~0U << (*fl + 1));
+    if (fl_map == 0) {
+      return NULL;
+    }
+    *fl = ffsBit(fl_map);
+    sl_map = sl_bitmap[*fl];
+  }
+  *sl = ffsBit(sl_map);
+
+  return free_heads[*fl][*sl];
+}
+
+//*****************************************************************************
+// Free lists and physical neighbours (all called with the spinlock held)
+
+void TlsfHeap::insertFree(Block *block) {
+  unsigned fl, sl;
+  mappingInsert(blockSize(block), &fl, &sl);
+
+  Block *head = free_heads[fl][sl];
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head != NULL) {
+    head->prev_free = block;
+  }
+  free_heads[fl][sl] = block;
+
+  fl_bitmap |= 1U << fl;
+  sl_bitmap[fl] |= 1U << sl;
+
+  free_blocks++;
+  free_bytes += blockSize(block);
+}
+
+void TlsfHeap::removeFree(Block *block) {
+  unsigned fl, sl;
+  mappingInsert(blockSize(block), &fl, &sl);
+
+  Block *prev = block->prev_free;
+  Block *next = block->next_free;
+  if (next != NULL) {
+    next->prev_free = prev;
+  }
+  if (prev != NULL) {
+    prev->next_free = next;
+  }
+
+  // Clear the bitmaps when the class runs empty
+  if (free_heads[fl][sl] == block) {
+    free_heads[fl][sl] = next;
+    if (next == NULL) {
+      sl_bitmap[fl] &= ~(1U << sl);
+      if (sl_bitmap[fl] == 0) {
+        fl_bitmap &= ~(1U << fl);
+      }
+    }
+  }
+
+  free_blocks--;
+  free_bytes -= blockSize(block);
+}
+
+void TlsfHeap::setUsed(Block *block) {
+  block->size &= ~(size_t)1;
+  nextPhys(block)->size &= ~(size_t)2;
+}
+
+void TlsfHeap::setFree(Block *block) {
+  block->size |= 1;
+
+  Block *next = nextPhys(block);
+  next->size |= 2;
+  next->prev_phys = block;
+}
+
+// Cut `block` down to `size` bytes and return the (free) remainder
+TlsfHeap::Block *TlsfHeap::split(Block *block, size_t size) {
+  Block *remain = (Block *)((uint8_t *)blockToPtr(block) + size);
+  size_t remain_size = blockSize(block) - size - block_header_size;
+
+  block->size = size | (block->size & 3);
+  remain->size = remain_size | 1;
+  remain->prev_phys = block;
+
+  Block *next = nextPhys(remain);
+  next->size |= 2;
+  next->prev_phys = remain;
+
+  return remain;
+}
+
+TlsfHeap::Block *TlsfHeap::mergePrev(Block *block) {
+  if (isPrevFree(block)) {
+    Block *prev = block->prev_phys;
+    removeFree(prev);
+    prev->size += block_header_size + blockSize(block);
+    block = prev;
+  }
+  return block;
+}
+
+TlsfHeap::Block *TlsfHeap::mergeNext(Block *block) {
+  Block *next = nextPhys(block);
+  if (isFree(next)) {
+    removeFree(next);
+    block->size += block_header_size + blockSize(next);
+  }
+  return block;
+}
+
+// The biggest free block sits in the highest non-empty class (stats only, walks one list)
+size_t TlsfHeap::largestFree() {
+  if (fl_bitmap == 0) {
+    return 0;
+  }
+
+  unsigned fl = flsBit(fl_bitmap);
+  unsigned sl = flsBit(sl_bitmap[fl]);
+  size_t largest = 0;
+  for (Block *block = free_heads[fl][sl]; block != NULL; block = block->next_free) {
+    if (blockSize(block) > largest) {
+      largest = blockSize(block);
+    }
+  }
+  return largest;
+}
+
+//*****************************************************************************
+// Public API
+
+bool TlsfHeap::init(void *region, size_t size) {
+  uint8_t *start = (uint8_t *)alignUp((size_t)region, align_size);
+  uint8_t *end = (uint8_t *)(((size_t)region + size) & ~(align_size - 1));
+
+  // Room for one minimum block plus the sentinel header at the end
+  if (end <= start || (size_t)(end - start) < 2 * block_header_size + block_size_min) {
+    return false;
+  }
+
+  size_t payload = (size_t)(end - start) - 2 * block_header_size;
+  if (payload >= block_size_max) {
+    payload = block_size_max - align_size;
+    end = start + payload + 2 * block_header_size;
+  }
+
+  portENTER_CRITICAL_SAFE(&spinlock);
+
+  fl_bitmap = 0;
+  memset(sl_bitmap, 0, sizeof(sl_bitmap));
+  memset(free_heads, 0, sizeof(free_heads));
+  free_bytes = 0;
+  free_blocks = 0;
+  used_blocks = 0;
+  alloc_count = 0;
+  free_count = 0;
+  fail_count = 0;
+  fallback_count = 0;
+
+  // One big free block followed by a zero-sized, used sentinel
+  Block *block = (Block *)start;
+  block->prev_phys = NULL;
+  block->size = payload | 1;
+
+  Block *sentinel = nextPhys(block);
+  sentinel->prev_phys = block;
+  sentinel->size = 0 | 2;
+
+  insertFree(block);
+  total_bytes = payload;
+  min_free_bytes = free_bytes;
+  region_end = end;
+  region_start = start;
+
+  portEXIT_CRITICAL_SAFE(&spinlock);
+
+  return true;
+}
+
+void *TlsfHeap::malloc(size_t size) {
+  if (size == 0 || size >= block_size_max / 2) {
+    return NULL;
+  }
+
+  size_t adjust = alignUp(size, align_size);
+  if (adjust < block_size_min) {
+    adjust = block_size_min;
+  }
+
+  unsigned fl, sl;
+  mappingSearch(adjust, &fl, &sl);
+
+  portENTER_CRITICAL_SAFE(&spinlock);
+
+  Block *block = searchSuitable(&fl, &sl);
+  if (block == NULL) {
+    fail_count++;
+    portEXIT_CRITICAL_SAFE(&spinlock);
+    return NULL;
+  }
+  removeFree(block);
+
+  // Give the tail back if it is big enough to be a block of its own
+  if (blockSize(block) >= adjust + block_header_size + block_size_min) {
+    insertFree(split(block, adjust));
+  }
+  setUsed(block);
+
+  used_blocks++;
+  alloc_count++;
+  if (free_bytes < min_free_bytes) {
+    min_free_bytes = free_bytes;
+  }
+
+  portEXIT_CRITICAL_SAFE(&spinlock);
+
+  return blockToPtr(block);
+}
+
+void TlsfHeap::free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  Block *block = ptrToBlock(ptr);
+
+  // Catch foreign pointers and double frees before they corrupt the lists
+  configASSERT(owns(ptr));
+  configASSERT(!isFree(block));
+
+  portENTER_CRITICAL_SAFE(&spinlock);
+
+  used_blocks--;
+  free_count++;
+
+  block->size |= 1;
+  block = mergePrev(block);
+  block = mergeNext(block);
+  setFree(block);
+  insertFree(block);
+
+  portEXIT_CRITICAL_SAFE(&spinlock);
+}
+
+bool TlsfHeap::owns(const void *ptr) const {
+  return (const uint8_t *)ptr >= region_start && (const uint8_t *)ptr < region_end;
+}
+
+void TlsfHeap::getStats(TlsfHeapStats *stats) {
+  portENTER_CRITICAL_SAFE(&spinlock);
+
+  stats->total_bytes = total_bytes;
+  stats->free_bytes = free_bytes;
+  stats->min_free_bytes = min_free_bytes;
+  stats->largest_free_block = largestFree();
+  stats->used_blocks = used_blocks;
+  stats->free_blocks = free_blocks;
+  stats->alloc_count = alloc_count;
+  stats->free_count = free_count;
+  stats->fail_count = fail_count;
+  stats->fallback_count = fallback_count;
+
+  portEXIT_CRITICAL_SAFE(&spinlock);
+
+  if (stats->free_bytes == 0) {
+    stats->fragmentation = 0;
+  } else {
+    stats->fragmentation = 100 - (uint8_t)((uint64_t)stats->largest_free_block * 100 / stats->free_bytes);
+  }
+}
+
+void TlsfHeap::walk(WalkCallback callback, void *user) {
+  if (!isInitialized()) {
+    return;
+  }
+
+  portENTER_CRITICAL_SAFE(&spinlock);
+
+  // The sentinel is the only block with a size of 0
+  for (Block *block = (Block *)region_start; blockSize(block) != 0; block = nextPhys(block)) {
+    callback(blockToPtr(block), blockSize(block), !isFree(block), user);
+  }
+
+  portEXIT_CRITICAL_SAFE(&spinlock);
+}
+
+void TlsfHeap::countFallback() {
+  portENTER_CRITICAL_SAFE(&spinlock);
+  fallback_count++;
+  portEXIT_CRITICAL_SAFE(&spinlock);
+}
+
+//*****************************************************************************
+// pvPortMalloc()/vPortFree() backing (linked in with -Wl,--wrap, see TlsfHeap.h)
+
+#if USE_TLSF_HEAP
+
+static uint8_t tlsf_region[TLSF_HEAP_SIZE] __attribute__((aligned(8)));
+static TlsfHeap tlsf_system_heap;
+static portMUX_TYPE tlsf_init_spinlock = portMUX_INITIALIZER_UNLOCKED;
+
+// Set up on first use, pvPortMalloc() may be called before static constructors run
+TlsfHeap &tlsfSystemHeap() {
+  if (!tlsf_system_heap.isInitialized()) {
+    portENTER_CRITICAL_SAFE(&tlsf_init_spinlock);
+    if (!tlsf_system_heap.isInitialized()) {
+      tlsf_system_heap.init(tlsf_region, sizeof(tlsf_region));
+    }
+    portEXIT_CRITICAL_SAFE(&tlsf_init_spinlock);
+  }
+  return tlsf_system_heap;
+}
+
+extern "C" {
+
+void *__real_pvPortMalloc(size_t size);
+void __real_vPortFree(void *ptr);
+
+void *__wrap_pvPortMalloc(size_t size) {
+  void *ptr = tlsfSystemHeap().malloc(size);
+
+#if TLSF_HEAP_FALLBACK
+  if (ptr == NULL && size > 0) {
+    tlsf_system_heap.countFallback();
+    ptr = __real_pvPortMalloc(size);
+  }
+#endif
+
+  return ptr;
+}
+
+void __wrap_vPortFree(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+
+  // Blocks from before the switch (or from the fallback) go back to the ESP-IDF heap
+  if (tlsfSystemHeap().owns(ptr)) {
+    tlsf_system_heap.free(ptr);
+  } else {
+    __real_vPortFree(ptr);
+  }
+}
+
+size_t __wrap_xPortGetFreeHeapSize(void) {
+  return tlsfSystemHeap().freeBytes();
+}
+
+size_t __wrap_xPortGetMinimumEverFreeHeapSize(void) {
+  return tlsfSystemHeap().minFreeBytes();
+}
+
+}
+
+#endif
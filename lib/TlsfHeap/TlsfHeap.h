@@ -0,0 +1,165 @@
+/*
+  Two-Level Segregated Fit (TLSF) heap for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  TLSF keeps free blocks in size classes indexed by two levels: the first level is the
+  power of two of the size (fls), the second level splits every power of two into 16
+  linear ranges. A bitmap per level records which classes are non-empty, so finding a
+  fitting block is two find-first-set instructions and allocation/free are O(1) no matter
+  how many blocks the heap holds. Freed blocks are merged with free neighbours right away,
+  which keeps fragmentation low.
+
+  The heap can be used directly (TlsfHeap::malloc() / free() on a region of your own), or
+  selected at build time as the backing store of pvPortMalloc()/vPortFree(). For the
+  latter add to the environment in platformio.ini:
+
+    build_flags =
+      -DUSE_TLSF_HEAP=1
+      -Wl,--wrap=pvPortMalloc
+      -Wl,--wrap=vPortFree
+      -Wl,--wrap=xPortGetFreeHeapSize
+      -Wl,--wrap=xPortGetMinimumEverFreeHeapSize
+    lib_archive = no
+
+  The region size is set with TLSF_HEAP_SIZE (bytes). When TLSF_HEAP_FALLBACK is 1 a request
+  the TLSF region can't satisfy is passed on to the ESP-IDF heap (counted in
+  TlsfHeapStats::fallback_count), so drivers that call pvPortMalloc() keep working. Set it to
+  0 to make every pvPortMalloc() bounded in time.
+*/
+
+#ifndef TLSF_HEAP_H
+#define TLSF_HEAP_H
+
+#include <Arduino.h>
+
+#ifndef USE_TLSF_HEAP
+  #define USE_TLSF_HEAP 0
+#endif
+
+#ifndef TLSF_HEAP_SIZE
+  #define TLSF_HEAP_SIZE (48 * 1024)
+#endif
+
+#ifndef TLSF_HEAP_FALLBACK
+  #define TLSF_HEAP_FALLBACK 1
+#endif
+
+// Heap statistics (see TlsfHeap::getStats())
+typedef struct TlsfHeapStats {
+  size_t total_bytes;         // Bytes managed (payload of all blocks, used and free)
+  size_t free_bytes;          // Bytes in free blocks
+  size_t min_free_bytes;      // Lowest free_bytes ever seen
+  size_t largest_free_block;  // Biggest single allocation that would succeed right now
+  size_t used_blocks;
+  size_t free_blocks;
+  uint32_t alloc_count;
+  uint32_t free_count;
+  uint32_t fail_count;        // Requests the region could not satisfy
+  uint32_t fallback_count;    // Of those, passed on to the ESP-IDF heap (pvPortMalloc wrapper)
+  uint8_t fragmentation;      // 0..100 %, 100 * (1 - largest_free_block / free_bytes)
+} TlsfHeapStats;
+
+class TlsfHeap {
+public:
+
+  // Second level splits every power of two into 2^sl_index_log2 classes
+  static const unsigned sl_index_log2 = 4;
+  static const unsigned sl_index_count = 1 << sl_index_log2;
+  static const size_t align_size = 8;
+  static const unsigned align_log2 = 3;
+  static const unsigned fl_index_shift = sl_index_log2 + align_log2;
+  static const size_t small_block_size = (size_t)1 << fl_index_shift;
+  static const unsigned fl_index_max = 24;  // Blocks up to 16 MB
+  static const unsigned fl_index_count = fl_index_max - fl_index_shift + 1;
+
+  // Called for every physical block by walk() (used == false for free blocks)
+  typedef void (*WalkCallback)(void *ptr, size_t size, bool used, void *user);
+
+  // An empty heap, call init() before use (kept constant-initialized so it can be a global)
+  TlsfHeap() = default;
+  TlsfHeap(void *region, size_t size) { init(region, size); }
+
+  // Take over `region` as the heap, returns false if it is too small
+  bool init(void *region, size_t size);
+  bool isInitialized() const { return region_start != NULL; }
+
+  void *malloc(size_t size);
+  void free(void *ptr);
+
+  // True if `ptr` lies inside this heap's region
+  bool owns(const void *ptr) const;
+
+  size_t freeBytes() const { return free_bytes; }
+  size_t minFreeBytes() const { return min_free_bytes; }
+  void getStats(TlsfHeapStats *stats);
+
+  // Visit every physical block in address order (runs with the heap locked)
+  void walk(WalkCallback callback, void *user);
+
+  // Used by the pvPortMalloc() wrapper
+  void countFallback();
+
+private:
+
+  // Block header. prev_phys is only meaningful while the previous block is free, next_free
+  // and prev_free only while this block is free (they live in the payload).
+  typedef struct Block {
+    struct Block *prev_phys;
+    size_t size;              // Payload bytes, bit 0: this block free, bit 1: previous free
+    struct Block *next_free;
+    struct Block *prev_free;
+  } Block;
+
+  static const size_t block_header_size = offsetof(Block, next_free);
+  static const size_t block_size_min = sizeof(Block) - block_header_size;
+  static const size_t block_size_max = (size_t)1 << fl_index_max;
+
+  static size_t blockSize(const Block *block) { return block->size & ~(size_t)3; }
+  static bool isFree(const Block *block) { return (block->size & 1) != 0; }
+  static bool isPrevFree(const Block *block) { return (block->size & 2) != 0; }
+  static void *blockToPtr(Block *block) { return (uint8_t *)block + block_header_size; }
+  static Block *ptrToBlock(void *ptr) { return (Block *)((uint8_t *)ptr - block_header_size); }
+  static Block *nextPhys(Block *block) {
+    return (Block *)((uint8_t *)blockToPtr(block) + blockSize(block));
+  }
+
+  static void mappingInsert(size_t size, unsigned *fl, unsigned *sl);
+  static void mappingSearch(size_t size, unsigned *fl, unsigned *sl);
+
+  Block *searchSuitable(unsigned *fl, unsigned *sl);
+  void insertFree(Block *block);
+  void removeFree(Block *block);
+  void setUsed(Block *block);
+  void setFree(Block *block);
+  Block *split(Block *block, size_t size);
+  Block *mergePrev(Block *block);
+  Block *mergeNext(Block *block);
+  size_t largestFree();
+
+  uint8_t *region_start = NULL;
+  uint8_t *region_end = NULL;
+  size_t total_bytes = 0;
+  size_t free_bytes = 0;
+  size_t min_free_bytes = 0;
+  size_t used_blocks = 0;
+  size_t free_blocks = 0;
+  uint32_t alloc_count = 0;
+  uint32_t free_count = 0;
+  uint32_t fail_count = 0;
+  uint32_t fallback_count = 0;
+
+  uint32_t fl_bitmap = 0;
+  uint32_t sl_bitmap[fl_index_count] = {};
+  Block *free_heads[fl_index_count][sl_index_count] = {};
+
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#if USE_TLSF_HEAP
+// The heap behind pvPortMalloc()/vPortFree() when the wrapper is enabled
+TlsfHeap &tlsfSystemHeap();
+#endif
+
+#endif
@@ -0,0 +1,222 @@
+/*
+  Work-stealing job runtime: one worker per core, each with its own deque
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+*/
+
+#include "WorkStealing.h"
+
+#include <stdio.h>
+
+// Worker the calling thread belongs to (NULL outside the runtime)
+static thread_local void *current_worker = NULL;
+
+//*****************************************************************************
+// Deque operations (the caller holds no lock)
+
+bool WorkStealingRuntime::push(Worker *worker, const WsJob &job) {
+  worker->lock.lock();
+  uint32_t depth = worker->bottom - worker->top;
+  if (depth == WS_DEQUE_CAPACITY) {
+    worker->lock.unlock();
+    return false;
+  }
+  worker->jobs[worker->bottom & deque_mask] = job;
+  worker->bottom++;
+  if (depth + 1 > worker->max_depth) {
+    worker->max_depth = depth + 1;
+  }
+  worker->lock.unlock();
+  return true;
+}
+
+bool WorkStealingRuntime::popBottom(Worker *worker, WsJob *job) {
+  bool found = false;
+
+  worker->lock.lock();
+  if (worker->bottom != worker->top) {
+    worker->bottom--;
+    *job = worker->jobs[worker->bottom & deque_mask];
+    found = true;
+  }
+  worker->lock.unlock();
+  return found;
+}
+
+// Take the older half of the first non-empty deque after the thief's own. The first job
+// is returned to run, the rest go onto the thief's deque.
+bool WorkStealingRuntime::stealHalf(Worker *thief, WsJob *job) {
+  WsJob batch[WS_DEQUE_CAPACITY / 2 + 1];
+  uint32_t count = 0;
+
+  for (int i = 1; i < num_workers && count == 0; i++) {
+    Worker *victim = &workers[(thief->index + i) % num_workers];
+
+    victim->lock.lock();
+    uint32_t depth = victim->bottom - victim->top;
+    count = (depth + 1) / 2;
+    for (uint32_t j = 0; j < count; j++) {
+      batch[j] = victim->jobs[victim->top & deque_mask];
+      victim->top++;
+    }
+    victim->lock.unlock();
+  }
+
+  if (count == 0) {
+    return false;
+  }
+
+  thief->steals.fetch_add(1, std::memory_order_relaxed);
+  thief->stolen_jobs.fetch_add(count, std::memory_order_relaxed);
+
+  // Oldest first, so the oldest stolen job ends up at the top of the thief's deque again
+  *job = batch[0];
+  for (uint32_t j = 1; j < count; j++) {
+    if (!push(thief, batch[j])) {
+      // Own deque filled up meanwhile, run it here rather than drop it
+      batch[j].function(batch[j].arg);
+      thief->executed.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  return true;
+}
+
+// Wake the owner of the deque and, if there is more than it can start on, one idle thief
+void WorkStealingRuntime::wakeFor(int worker) {
+  workers[worker].wake.give();
+  for (int i = 1; i < num_workers; i++) {
+    Worker *other = &workers[(worker + i) % num_workers];
+    if (other->sleeping.load()) {
+      other->wake.give();
+      break;
+    }
+  }
+}
+
+//*****************************************************************************
+// Worker
+
+void WorkStealingRuntime::workerTask(void *parameter) {
+  Worker *self = (Worker *)parameter;
+  WorkStealingRuntime *runtime = self->runtime;
+  WsJob job;
+
+  current_worker = self;
+  self->wake.bind();
+
+  while (1) {
+    if (runtime->popBottom(self, &job) || runtime->stealHalf(self, &job)) {
+      job.function(job.arg);
+      self->executed.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // Nothing left anywhere
+    if (runtime->stopping.load()) {
+      break;
+    }
+
+    // Announce the sleep before looking once more, so a submit() in between either sees
+    // `sleeping` and wakes us, or its job is found here
+    self->sleeping.store(true);
+    if (runtime->stealHalf(self, &job)) {
+      self->sleeping.store(false);
+      job.function(job.arg);
+      self->executed.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    self->sleeps.fetch_add(1, std::memory_order_relaxed);
+    self->wake.take();
+    self->sleeping.store(false);
+  }
+
+  self->exited.store(true);
+  WsThread::exit();
+}
+
+//*****************************************************************************
+// Public API
+
+bool WorkStealingRuntime::begin(int count, unsigned priority) {
+  char name[16];
+
+  if (count < 1 || count > WS_MAX_WORKERS || num_workers != 0) {
+    return false;
+  }
+
+  stopping.store(false);
+  num_workers = count;
+  for (int i = 0; i < count; i++) {
+    Worker *worker = &workers[i];
+    worker->runtime = this;
+    worker->index = i;
+    worker->top = 0;
+    worker->bottom = 0;
+    worker->max_depth = 0;
+    worker->sleeping.store(false);
+    worker->exited.store(false);
+    worker->executed.store(0);
+    worker->steals.store(0);
+    worker->stolen_jobs.store(0);
+    worker->sleeps.store(0);
+  }
+
+  for (int i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "WS Worker %d", i);
+    if (!workers[i].thread.start(workerTask, &workers[i], name, i, priority)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WorkStealingRuntime::end() {
+  stopping.store(true);
+  for (int i = 0; i < num_workers; i++) {
+    workers[i].wake.give();
+  }
+  for (int i = 0; i < num_workers; i++) {
+    while (!workers[i].exited.load()) {
+      workers[i].wake.give();
+      wsSleepMs(1);
+    }
+    workers[i].thread.join();
+  }
+  num_workers = 0;
+}
+
+int WorkStealingRuntime::currentWorker() const {
+  Worker *worker = (Worker *)current_worker;
+  if (worker != NULL && worker->runtime == this) {
+    return worker->index;
+  }
+  return wsCurrentCore() % num_workers;
+}
+
+bool WorkStealingRuntime::submit(WsJobFunction function, void *arg) {
+  return submitTo(currentWorker(), function, arg);
+}
+
+bool WorkStealingRuntime::submitTo(int worker, WsJobFunction function, void *arg) {
+  WsJob job = {function, arg};
+
+  if (worker < 0 || worker >= num_workers || !push(&workers[worker], job)) {
+    reject_count.fetch_add(1);
+    return false;
+  }
+  wakeFor(worker);
+  return true;
+}
+
+void WorkStealingRuntime::getStats(int worker, WsWorkerStats *stats) {
+  Worker *w = &workers[worker];
+  stats->executed = w->executed.load();
+  stats->steals = w->steals.load();
+  stats->stolen_jobs = w->stolen_jobs.load();
+  stats->sleeps = w->sleeps.load();
+
+  w->lock.lock();
+  stats->max_depth = w->max_depth;
+  w->lock.unlock();
+}
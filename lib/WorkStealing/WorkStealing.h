@@ -0,0 +1,148 @@
+/*
+  Work-stealing job runtime: one worker per core, each with its own deque
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  With every task pinned to app_cpu, a burst of work queues up on one core while the other
+  one idles. Here every worker owns a bounded deque of jobs. A worker runs the newest job
+  of its own deque first (good for caches, and a job that submits more work runs it
+  next). When its deque is empty it steals half of the oldest jobs of another worker, so a
+  burst that lands on one core is split between both in one step instead of job by job.
+  A worker with nothing to run or steal blocks on its wake-up signal until a submit() gives
+  it, so idle workers cost no CPU time.
+
+  submit() from inside a job pushes onto the running worker's own deque. From any other
+  task it goes to the worker of the calling core (on the host: worker 0), which is exactly
+  the bursty case that stealing is meant to balance.
+
+  Example:
+    static WorkStealingRuntime runtime;
+    static JobGroup group;
+
+    runtime.begin(2);                     // Worker 0 on core 0, worker 1 on core 1
+    group.add(num_msgs);
+    for (int i = 0; i < num_msgs; i++) {
+      runtime.submit(processMessage, &msgs[i]);   // processMessage() calls group.done()
+    }
+    group.wait();
+
+  The deques are guarded by a short spinlock (a mutex on the host) rather than being
+  lock-free; the lock is held for a few instructions and a steal moves many jobs at once,
+  so it is rarely contended. The platform layer is in WorkStealingPort.h.
+*/
+
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "WorkStealingPort.h"
+
+#ifndef WS_MAX_WORKERS
+  #define WS_MAX_WORKERS WS_NUM_CORES
+#endif
+
+// Jobs per deque (a power of two)
+#ifndef WS_DEQUE_CAPACITY
+  #define WS_DEQUE_CAPACITY 64
+#endif
+
+typedef void (*WsJobFunction)(void *arg);
+
+typedef struct WsJob {
+  WsJobFunction function;
+  void *arg;
+} WsJob;
+
+// Per-worker counters (see WorkStealingRuntime::getStats())
+typedef struct WsWorkerStats {
+  uint32_t executed;      // Jobs run by this worker
+  uint32_t steals;        // Successful steals (each moves up to half a deque)
+  uint32_t stolen_jobs;   // Jobs taken from other workers
+  uint32_t sleeps;        // Times the worker found nothing to do
+  uint32_t max_depth;     // Deepest its own deque has been
+} WsWorkerStats;
+
+// Counts outstanding jobs, lets one task wait for all of them
+class JobGroup {
+public:
+  // add() and wait() must be called by the same task
+  void add(uint32_t count) {
+    done_signal.bind();
+    pending.fetch_add(count);
+  }
+  // Called by each job when it has finished
+  void done() {
+    if (pending.fetch_sub(1) == 1) {
+      done_signal.give();
+    }
+  }
+  void wait() {
+    while (pending.load() != 0) {
+      done_signal.take();
+    }
+  }
+
+private:
+  std::atomic<uint32_t> pending{0};
+  WsSignal done_signal;
+};
+
+class WorkStealingRuntime {
+public:
+
+  // Start `num_workers` workers, worker i on core i (modulo the number of cores), each
+  // with a WS_STACK_SIZE stack
+  bool begin(int num_workers, unsigned priority = 1);
+
+  // Stop the workers once their deques are empty (used by the host benchmarks)
+  void end();
+
+  // Queue a job, returns false if the target deque is full
+  bool submit(WsJobFunction function, void *arg);
+  bool submitTo(int worker, WsJobFunction function, void *arg);
+
+  int numWorkers() const { return num_workers; }
+  uint32_t rejected() const { return reject_count.load(); }
+  void getStats(int worker, WsWorkerStats *stats);
+
+private:
+
+  static const uint32_t deque_mask = WS_DEQUE_CAPACITY - 1;
+
+  typedef struct Worker {
+    WorkStealingRuntime *runtime;
+    int index;
+    WsLock lock;
+    WsJob jobs[WS_DEQUE_CAPACITY];
+    uint32_t top;       // Oldest job (thieves take from here)
+    uint32_t bottom;    // One past the newest job (the owner pushes and pops here)
+    WsSignal wake;
+    WsThread thread;
+    std::atomic<bool> sleeping;
+    std::atomic<bool> exited;
+    std::atomic<uint32_t> executed;
+    std::atomic<uint32_t> steals;
+    std::atomic<uint32_t> stolen_jobs;
+    std::atomic<uint32_t> sleeps;
+    uint32_t max_depth;
+  } Worker;
+
+  static void workerTask(void *parameter);
+
+  int currentWorker() const;
+  bool push(Worker *worker, const WsJob &job);
+  bool popBottom(Worker *worker, WsJob *job);
+  bool stealHalf(Worker *thief, WsJob *job);
+  void wakeFor(int worker);
+
+  Worker workers[WS_MAX_WORKERS];
+  int num_workers = 0;
+  std::atomic<bool> stopping{false};
+  std::atomic<uint32_t> reject_count{0};
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+  Platform layer of the work-stealing runtime
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  The runtime only needs a short lock, a wake-up signal and a way to start one thread per
+  worker. On the ESP32 those are a portMUX spinlock, a task notification and a task pinned
+  to a core, created from a TaskStorage (lib/StaticAlloc) so that USE_STATIC_ALLOCATION
+  builds keep the workers' stacks out of the heap; everywhere else (the host benchmarks in
+  host-tools/) they come from the C++ standard library, so the same scheduling code runs
+  on both.
+*/
+
+#ifndef WORK_STEALING_PORT_H
+#define WORK_STEALING_PORT_H
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO_ARCH_ESP32)
+  #define WS_PORT_FREERTOS 1
+#else
+  #define WS_PORT_FREERTOS 0
+#endif
+
+#if WS_PORT_FREERTOS
+
+#include <StaticAlloc.h>
+
+#define WS_NUM_CORES portNUM_PROCESSORS
+
+// Stack of each worker task in bytes
+#ifndef WS_STACK_SIZE
+  #define WS_STACK_SIZE 4096
+#endif
+
+// Spinlock, held only while a deque is changed
+class WsLock {
+public:
+  void lock() { portENTER_CRITICAL(&spinlock); }
+  void unlock() { portEXIT_CRITICAL(&spinlock); }
+
+private:
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Wake-up for one task (the one that called bind()), latched like a binary semaphore
+class WsSignal {
+public:
+  void bind() { owner = xTaskGetCurrentTaskHandle(); }
+  void give() {
+    TaskHandle_t task = owner;
+    if (task != NULL) {
+      xTaskNotifyGive(task);
+    }
+  }
+  // Block until give() (returns at once if it was given meanwhile)
+  void take() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+
+private:
+  TaskHandle_t volatile owner = NULL;
+};
+
+class WsThread {
+public:
+  bool start(void (*function)(void *), void *arg, const char *name, int core,
+             unsigned priority) {
+    return storage.createPinnedToCore(function, name, arg, priority,
+                                      core % portNUM_PROCESSORS) != NULL;
+  }
+  // Called by the thread itself as its last action
+  static void exit() { vTaskDelete(NULL); }
+  // Wait until the task is gone, so that start() may use its storage again
+  void join() {
+    while (!storage.waitReleased()) {
+      vTaskDelay(1);
+    }
+  }
+
+private:
+  TaskStorage<WS_STACK_SIZE> storage;
+};
+
+static inline int wsCurrentCore() { return xPortGetCoreID(); }
+static inline void wsSleepMs(uint32_t ms) { vTaskDelay(pdMS_TO_TICKS(ms) > 0 ? pdMS_TO_TICKS(ms) : 1); }
+
+#else
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#define WS_NUM_CORES 8
+
+class WsLock {
+public:
+  void lock() { mutex.lock(); }
+  void unlock() { mutex.unlock(); }
+
+private:
+  std::mutex mutex;
+};
+
+class WsSignal {
+public:
+  void bind() {}
+  void give() {
+    std::lock_guard<std::mutex> guard(mutex);
+    signalled = true;
+    cond.notify_one();
+  }
+  void take() {
+    std::unique_lock<std::mutex> guard(mutex);
+    cond.wait(guard, [this] { return signalled; });
+    signalled = false;
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool signalled = false;
+};
+
+class WsThread {
+public:
+  bool start(void (*function)(void *), void *arg, const char *name, int core,
+             unsigned priority) {
+    thread = std::thread(function, arg);
+    return true;
+  }
+  static void exit() {}
+  void join() {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+private:
+  std::thread thread;
+};
+
+// Threads outside the runtime count as core 0, like the sketches pinned to one core
+static inline int wsCurrentCore() { return 0; }
+static inline void wsSleepMs(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,122 @@
+/*
+  Fixed worker pool with a job queue for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1
+*/
+
+#include "WorkerPool.h"
+
+void WorkerPool::attach(QueueHandle_t queue, uint8_t workers) {
+  configASSERT(queue != NULL);
+  configASSERT(job_queue == NULL);  // begin() may only be called once
+
+  job_queue = queue;
+  num_workers = workers;
+}
+
+void WorkerPool::noteQueued(UBaseType_t queued) {
+  portENTER_CRITICAL_SAFE(&spinlock);
+  submit_count++;
+  if (queued > max_queued_jobs) {
+    max_queued_jobs = queued;
+  }
+  portEXIT_CRITICAL_SAFE(&spinlock);
+}
+
+bool WorkerPool::submit(JobFunction function, void *arg, TaskHandle_t notify_task,
+                        TickType_t timeout) {
+  Job job = {function, arg, notify_task, false, {}};
+  return submitJob(job, timeout);
+}
+
+bool WorkerPool::submitJob(const Job &job, TickType_t timeout) {
+  configASSERT(job_queue != NULL);
+
+  if (xQueueSend(job_queue, &job, timeout) != pdTRUE) {
+    portENTER_CRITICAL(&spinlock);
+    reject_count++;
+    portEXIT_CRITICAL(&spinlock);
+    return false;
+  }
+
+  noteQueued(uxQueueMessagesWaiting(job_queue));
+  return true;
+}
+
+bool WorkerPool::submitFromISR(JobFunction function, void *arg, TaskHandle_t notify_task,
+                               BaseType_t *higher_priority_task_woken) {
+  Job job = {function, arg, notify_task, false, {}};
+  if (xQueueSendFromISR(job_queue, &job, higher_priority_task_woken) != pdTRUE) {
+    portENTER_CRITICAL_ISR(&spinlock);
+    reject_count++;
+    portEXIT_CRITICAL_ISR(&spinlock);
+    return false;
+  }
+
+  noteQueued(uxQueueMessagesWaitingFromISR(job_queue));
+  return true;
+}
+
+bool WorkerPool::waitDone(uint32_t count, TickType_t timeout) {
+  TimeOut_t time_out;
+  vTaskSetTimeOutState(&time_out);
+
+  // Take the notifications one at a time, so completions beyond `count` are kept
+  while (count > 0) {
+    if (ulTaskNotifyTake(pdFALSE, timeout) == 0) {
+      return false;
+    }
+    count--;
+    if (count > 0 && xTaskCheckForTimeOut(&time_out, &timeout) == pdTRUE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WorkerPool::getStats(WorkerPoolStats *stats) {
+  UBaseType_t queued = uxQueueMessagesWaiting(job_queue);
+
+  portENTER_CRITICAL(&spinlock);
+  stats->num_workers = num_workers;
+  stats->busy_workers = busy_workers;
+  stats->max_busy_workers = max_busy_workers;
+  stats->queued_jobs = queued;
+  stats->max_queued_jobs = max_queued_jobs;
+  stats->submit_count = submit_count;
+  stats->done_count = done_count;
+  stats->reject_count = reject_count;
+  portEXIT_CRITICAL(&spinlock);
+}
+
+void WorkerPool::workerTask(void *parameter) {
+  WorkerPool *pool = (WorkerPool *)parameter;
+  Job job;
+
+  // Loop forever
+  while (1) {
+    if (xQueueReceive(pool->job_queue, &job, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+
+    portENTER_CRITICAL(&pool->spinlock);
+    pool->busy_workers++;
+    if (pool->busy_workers > pool->max_busy_workers) {
+      pool->max_busy_workers = pool->busy_workers;
+    }
+    portEXIT_CRITICAL(&pool->spinlock);
+
+    // An inline argument was copied onto this stack by xQueueReceive()
+    job.function(job.has_inline_arg ? (void *)job.inline_arg : job.arg);
+
+    portENTER_CRITICAL(&pool->spinlock);
+    pool->busy_workers--;
+    pool->done_count++;
+    portEXIT_CRITICAL(&pool->spinlock);
+
+    if (job.notify_task != NULL) {
+      xTaskNotifyGive(job.notify_task);
+    }
+  }
+}
@@ -0,0 +1,155 @@
+/*
+  Fixed worker pool with a job queue for FreeRTOS
+
+  Efraim Manurung, 17th October 2026
+  Version 1.0
+
+  Efraim Manurung, 17th October 2026
+  Version 1.1 : submitCopy() copies a small argument into the job itself, so the caller
+                does not have to keep it alive (or wait) until the job has read it
+
+  Creating a task for every piece of work and letting it vTaskDelete(NULL) itself costs a
+  stack and TCB allocation, task setup and, later, clean-up by the idle task each time. A
+  worker pool starts its tasks once; after that a job is a function pointer and an argument
+  passed through a queue, and an idle worker picks it up.
+
+  Completion is signalled per job with a direct-to-task notification: pass the task that
+  wants to know (usually the caller) to submit(), then wait with WorkerPool::waitDone().
+  The notification value is used as a counter, like ulTaskNotifyTake(), so the waiting
+  task should not use its notification for anything else at the same time.
+
+  Example:
+    static StaticWorkerPool<2, 2048, 8> pool;     // 2 workers, 2048 byte stacks, 8 jobs
+
+    pool.begin("Worker", 1, app_cpu);
+    pool.submit(printJob, &msg, xTaskGetCurrentTaskHandle());
+    WorkerPool::waitDone(1, portMAX_DELAY);
+
+  submit() passes the pointer as it is; whatever it points to has to stay valid until the
+  job is done with it. submitCopy() copies up to WORKER_POOL_INLINE_ARG_SIZE bytes into the
+  queue entry instead, and the job gets a pointer to that copy on the worker's stack:
+
+    Message msg = {...};
+    pool.submitCopy(printJob, msg);               // msg may go out of scope right away
+
+  The inline bytes make every queue entry that much larger, whichever submit is used.
+
+  Workers and the queue are created through lib/StaticAlloc, so they are static in a
+  USE_STATIC_ALLOCATION build.
+*/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <Arduino.h>
+#include <StaticAlloc.h>
+#include <string.h>
+#include <type_traits>
+
+// Bytes of argument a job can carry by value (see submitCopy())
+#ifndef WORKER_POOL_INLINE_ARG_SIZE
+#define WORKER_POOL_INLINE_ARG_SIZE 24
+#endif
+
+// Pool statistics (see WorkerPool::getStats())
+typedef struct WorkerPoolStats {
+  uint8_t num_workers;
+  uint8_t busy_workers;       // Workers running a job right now
+  uint8_t max_busy_workers;   // High-water mark of busy_workers
+  UBaseType_t queued_jobs;    // Jobs waiting for a worker
+  UBaseType_t max_queued_jobs;
+  uint32_t submit_count;      // Jobs accepted by submit()
+  uint32_t done_count;        // Jobs finished
+  uint32_t reject_count;      // Jobs refused because the queue stayed full
+} WorkerPoolStats;
+
+class WorkerPool {
+public:
+
+  typedef void (*JobFunction)(void *arg);
+
+  // Queue `function(arg)` for the next free worker. If `notify_task` is not NULL it gets
+  // an xTaskNotifyGive() when the job has finished. Returns false if the queue is still
+  // full after `timeout` ticks.
+  bool submit(JobFunction function, void *arg, TaskHandle_t notify_task = NULL,
+              TickType_t timeout = portMAX_DELAY);
+  bool submitFromISR(JobFunction function, void *arg, TaskHandle_t notify_task,
+                     BaseType_t *higher_priority_task_woken);
+
+  // Like submit(), but `function` gets a pointer to a copy of `arg` that lives as long as
+  // the job runs. T must be trivially copyable and fit in WORKER_POOL_INLINE_ARG_SIZE.
+  template <typename T>
+  bool submitCopy(JobFunction function, const T &arg, TaskHandle_t notify_task = NULL,
+                  TickType_t timeout = portMAX_DELAY) {
+    static_assert(sizeof(T) <= WORKER_POOL_INLINE_ARG_SIZE,
+                  "argument too large, raise WORKER_POOL_INLINE_ARG_SIZE");
+    static_assert(alignof(T) <= 8, "argument alignment not supported");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "argument must be trivially copyable");
+
+    Job job = {function, NULL, notify_task, true, {}};
+    memcpy(job.inline_arg, &arg, sizeof(T));
+    return submitJob(job, timeout);
+  }
+
+  // Wait until `count` jobs submitted with this task as notify_task have finished,
+  // returns false on timeout
+  static bool waitDone(uint32_t count, TickType_t timeout);
+
+  void getStats(WorkerPoolStats *stats);
+
+protected:
+
+  // One queue entry
+  typedef struct Job {
+    JobFunction function;
+    void *arg;
+    TaskHandle_t notify_task;
+    bool has_inline_arg;                  // Pass inline_arg instead of arg
+    alignas(8) uint8_t inline_arg[WORKER_POOL_INLINE_ARG_SIZE];
+  } Job;
+
+  WorkerPool() = default;
+
+  // Called by StaticWorkerPool::begin() once the queue exists and before the workers start
+  void attach(QueueHandle_t queue, uint8_t num_workers);
+  static void workerTask(void *parameter);
+
+private:
+
+  bool submitJob(const Job &job, TickType_t timeout);
+  void noteQueued(UBaseType_t queued);
+
+  QueueHandle_t job_queue = NULL;
+  uint8_t num_workers = 0;
+  uint8_t busy_workers = 0;
+  uint8_t max_busy_workers = 0;
+  UBaseType_t max_queued_jobs = 0;
+  uint32_t submit_count = 0;
+  uint32_t done_count = 0;
+  uint32_t reject_count = 0;
+  portMUX_TYPE spinlock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+// Worker pool with its tasks and queue (stack depth in bytes on ESP32)
+template <uint8_t NumWorkers, uint32_t StackDepth, UBaseType_t QueueLength>
+class StaticWorkerPool : public WorkerPool {
+public:
+
+  // Create the queue and start the workers, named "<name> 0", "<name> 1", ...
+  void begin(const char *name, UBaseType_t priority, BaseType_t core_id) {
+    char task_name[configMAX_TASK_NAME_LEN];
+
+    attach(queue_storage.create(), NumWorkers);
+    for (uint8_t i = 0; i < NumWorkers; i++) {
+      snprintf(task_name, sizeof(task_name), "%s %u", name, (unsigned)i);
+      workers[i].createPinnedToCore(workerTask, task_name, this, priority, core_id);
+    }
+  }
+
+private:
+  TaskStorage<StackDepth> workers[NumWorkers];
+  QueueStorage<Job, QueueLength> queue_storage;
+};
+
+#endif